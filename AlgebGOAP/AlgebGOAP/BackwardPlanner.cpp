@@ -8,6 +8,7 @@
 #include "BackwardPlanner.h"
 #include "BitVector.h"
 #include "Fact.h"
+#include "PlannerStats.h"
 #include "State.h"
 
 
@@ -45,8 +46,8 @@ std::string CBackwardPlanner::SNode::ToString() const
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool CBackwardPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CState& StartingState, CCondition& GoalCondition, std::vector<CAction*>& Actions, int MaxDepth)
 {
-    int Step = 0;
     oSteps.clear();
+    mNodes.swap(mWorkspace->GetScratch<SNodeScratch>().Nodes); // Borrow the search tree of the workspace until PostPlan.
     mNodes.reserve(Actions.size() * MaxDepth);
 
     if (ShouldPrintExcessiveHeuristic())
@@ -65,20 +66,26 @@ bool CBackwardPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CState&
     RootNode.BaseHeuristicCost = GetBaseHeuristicCost(StartingState, GoalCondition, 0);
     RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalCondition);
 
-    std::multimap<float, int> OpenMap; // The open set in A*
-    OpenMap.emplace(RootNode.GetTotalCost(), 0);
+    COpenList& OpenList = mWorkspace->GetOpenList(); // The open set in A*
+    OpenList.Push(RootNode.GetTotalCost(), 0);
 
-    while (!OpenMap.empty())
+    while (!OpenList.IsEmpty())
     {
-        auto itCurr = OpenMap.begin();
-        const int CurrIndex = itCurr->second;
-        OpenMap.erase(itCurr);
+        if (mStats)
+        {
+            mStats->AddExpansion(OpenList.GetSize());
+        }
+
+        const int CurrIndex = OpenList.Pop();
         SNode& CurrNode = mNodes[CurrIndex];
+        mExpansionCount++;
 
+        CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime);
         bool Reached = GoalCondition.IsSatisfiedBy(*CurrNode.ConstState);
+        GoalTestTimer.Stop();
         if (mFlags & ShowSteps)
         {
-            std::cout << "#" << ++Step << " #Nodes=" << mNodes.size();
+            std::cout << "#" << mExpansionCount << " #Nodes=" << mNodes.size();
             std::cout << ' ' << StringizeBackwardPath(mNodes, CurrIndex, Reached) << ' ';
             std::cout << CurrNode.ToString() << std::endl;
         }
@@ -86,7 +93,7 @@ bool CBackwardPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CState&
         {
             if (mFlags & ShowFinalOpenNodes)
             {
-                std::cout << StringizeNodes(OpenMap, GoalCondition);
+                std::cout << StringizeNodes(OpenList, GoalCondition);
             }
             
             BuildBackwardPlan(oSteps, mNodes, CurrIndex);
@@ -100,7 +107,7 @@ bool CBackwardPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CState&
 
         for (const CAction* Action : Actions)
         {
-            Explore(OpenMap, CurrIndex, *Action, StartingState, GoalCondition);
+            Explore(OpenList, CurrIndex, *Action, StartingState, GoalCondition);
         }
     }
 
@@ -110,13 +117,23 @@ bool CBackwardPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CState&
 void CBackwardPlanner::PostPlan()
 {
     mNodes.clear();
+    mNodes.swap(mWorkspace->GetScratch<SNodeScratch>().Nodes); // Return the search tree to the workspace.
 }
 
-void CBackwardPlanner::Explore(std::multimap<float, int>& oOpenMap, int NodeIndex, const CAction& Action, const CState& StartingState, const CCondition& GoalCondition)
+void CBackwardPlanner::Explore(COpenList& oOpenList, int NodeIndex, const CAction& Action, const CState& StartingState, const CCondition& GoalCondition)
 {
     const CCondition& Precondition = Action.GetPrecondition();
     const CEffect& Effect = Action.GetEffect();
-    if (!Effect.HasAnyTransform(mNodes[NodeIndex].DesiredFactBits))
+    CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
+    const bool Relevant = Effect.HasAnyTransform(mNodes[NodeIndex].DesiredFactBits);
+    PreconditionTimer.Stop();
+
+    if (mStats)
+    {
+        mStats->AddCheck(Action, Relevant);
+    }
+
+    if (!Relevant)
     {
         return;
     }
@@ -125,21 +142,30 @@ void CBackwardPlanner::Explore(std::multimap<float, int>& oOpenMap, int NodeInde
     SNode& ChildNode = mNodes.emplace_back();
     SNode& CurrNode = mNodes[NodeIndex];
     ChildNode.Action = &Action;
-    ChildNode.MutableState = StartingState.Clone();
-    ChildNode.ConstState = ChildNode.MutableState.get();
+    CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+    ChildNode.MutableState = StartingState.CloneInto(mWorkspace->GetStateArena());
+    ChildNode.ConstState = ChildNode.MutableState;
     ChildNode.Parent = NodeIndex;
     ChildNode.Depth = CurrNode.Depth + 1;
     ApplyEffectsOnPath(*ChildNode.MutableState, ChildIndex); // TODO: Avoid exploring infeasible paths.
     Action.Affect(*ChildNode.MutableState);    
+    CloneTimer.Stop();
     ChildNode.DesiredFactBits = CurrNode.DesiredFactBits 
         | Effect.GetAffectingFactBits(CurrNode.DesiredFactBits) 
         | Precondition.GetUsedFactBits();
     ChildNode.PreviousCost = CurrNode.GetActualCost();
     ChildNode.CurrentCost = Action.GetCost(*CurrNode.ConstState, *ChildNode.ConstState);
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
     ChildNode.BaseHeuristicCost = GetBaseHeuristicCost(*ChildNode.ConstState, GoalCondition, ChildIndex);
     ChildNode.ExtraHeuristicCost = ChildNode.ConstState->GetExtraHeuristicCost(GoalCondition);
+    HeuristicTimer.Stop();
     float TotalCost = ChildNode.GetTotalCost();
-    oOpenMap.emplace(TotalCost, ChildIndex);
+    oOpenList.Push(TotalCost, ChildIndex);
 }
 
 bool CBackwardPlanner::ApplyEffectsOnPath(CState& oState, int NodeIndex)
@@ -160,11 +186,11 @@ bool CBackwardPlanner::ApplyEffectsOnPath(CState& oState, int NodeIndex)
     return true;
 }
 
-std::string CBackwardPlanner::StringizeNodes(const std::multimap<float, int>& OpenMap, const CCondition& GoalCondition) const
+std::string CBackwardPlanner::StringizeNodes(const COpenList& OpenList, const CCondition& GoalCondition) const
 {
     std::string Return;
 
-    for (auto [Cost, NodeIndex] : OpenMap)
+    for (auto [Cost, NodeIndex] : OpenList.GetSortedEntries())
     {
         const SNode& CurrNode = mNodes[NodeIndex];
         Return += "Nodes[";
@@ -2,11 +2,11 @@
 
 #pragma once
 
-#include <map>
 #include <memory>
 
 #include "BasePlanner.h"
 #include "BitVector.h"
+#include "OpenList.h"
 
 
 namespace AlgebGOAP
@@ -23,13 +23,20 @@ namespace AlgebGOAP
         {
             // ConstState and MutableState point to the same state except that the mutable counterpart of the starting state is null.
             const CState* ConstState = nullptr;
-            std::unique_ptr<CState> MutableState;
+            CState* MutableState = nullptr;
             CBitVector DesiredFactBits;
 
         public:
             std::string ToString() const; // For debugging
         };
 
+        struct SNodeScratch : CPlannerWorkspace::SScratch // Search tree kept by a workspace between searches
+        {
+            std::vector<SNode> Nodes;
+
+            void Clear() override { Nodes.clear(); }
+        };
+
     public:
         using Super::Super;
 
@@ -38,14 +45,14 @@ namespace AlgebGOAP
         void PostPlan() override;
 
         // Create a search node for a given action from a given node if feasible.
-        void Explore(std::multimap<float, int>& oOpenMap, int NodeIndex, const CAction& Action, const CState& StartingState, const CCondition& GoalCondition);
+        void Explore(COpenList& oOpenList, int NodeIndex, const CAction& Action, const CState& StartingState, const CCondition& GoalCondition);
         // Apply the effects on the path from a given state.
         bool ApplyEffectsOnPath(CState& oState, int NodeIndex);
         // Return a description of listed nodes.
-        std::string StringizeNodes(const std::multimap<float, int>& OpenMap, const CCondition& GoalCondition) const;
+        std::string StringizeNodes(const COpenList& OpenList, const CCondition& GoalCondition) const;
 
     protected:
-        std::vector<SNode> mNodes;
+        std::vector<SNode> mNodes; // The search tree, which is borrowed from the workspace during a search
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
 }
@@ -8,15 +8,28 @@
 #include "BasePlanner.h"
 #include "Action.h"
 #include "Fact.h"
+#include "PlannerStats.h"
 #include "State.h"
 
 
 using namespace AlgebGOAP;
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool CBasePlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CCondition& GoalCondition, const std::vector<const CAction*>& Actions, int MaxDepth)
+{
+    return Plan(oSteps, StartingState, GoalCondition, Actions, MaxDepth, mDefaultWorkspace);
+}
+
+bool CBasePlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CCondition& GoalCondition, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace)
 {
     MaxDepth = std::max(MaxDepth, 0);
+    mWorkspace = &Workspace;
+    mWorkspace->Clear();
+    mExpansionCount = 0;
     mDebugInfo.Clear();
+    if (mStats)
+    {
+        mStats->Reset();
+    }
 
     if (mFlags & ShowMethodName)
     {
@@ -52,6 +65,11 @@ bool CBasePlanner::Plan(std::vector<const CAction*>& oSteps, const CState& Start
     PrePlan(StartingState, *ModifiedGoal, ModifiableActions);
     bool Return = DoPlan(oSteps, StartingState, *ModifiedGoal, ModifiableActions, MaxDepth);
 
+    if (mStats)
+    {
+        mStats->MapActions(ModifiedActions, Actions); // The clones are destroyed on return.
+    }
+
     if (ShouldPrintExcessiveHeuristic())
     {
         PrintExcessiveHeuristic(StartingState.GetDefinition());
@@ -72,6 +90,7 @@ bool CBasePlanner::Plan(std::vector<const CAction*>& oSteps, const CState& Start
     PostPlan();
     mDebugInfo.Clear();
     mPathGetter = nullptr;
+    mWorkspace = nullptr;
 
     return Return;
 }
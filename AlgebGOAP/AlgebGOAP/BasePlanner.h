@@ -6,6 +6,7 @@
 
 #include "Common.h"
 #include "Debug.h"
+#include "Workspace.h"
 
 
 namespace AlgebGOAP
@@ -14,6 +15,7 @@ namespace AlgebGOAP
     class CCondition;
     class CFactDefinition;
     class CState;
+    struct SPlannerStats;
     ///////////////////////////////////////////////////////////////////////////////////////////////
     class CBasePlanner // Base class for GOAP planners
     {
@@ -39,6 +41,12 @@ namespace AlgebGOAP
         virtual ~CBasePlanner() {}
 
         bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CCondition& GoalCondition, const std::vector<const CAction*>& Actions, int MaxDepth);
+        // Same as above but with the buffers of a given workspace, which keeps their capacity for later calls.
+        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CCondition& GoalCondition, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace);
+        // Return the number of the nodes expanded by the last Plan call.
+        int GetExpansionCount() const { return mExpansionCount; }
+        // Collect the statistics of each search into a given instance, or stop collecting them with null.
+        void SetStats(SPlannerStats* Value) { mStats = Value; }
 
     protected:
         virtual void PrePlan(const CState& StartingState, CCondition& GoalCondition, std::vector<CAction*>& Actions);
@@ -60,8 +68,12 @@ namespace AlgebGOAP
 
     protected:
         unsigned mFlags = 0;
+        int mExpansionCount = 0; // Number of the expanded nodes
         SDebugInfo mDebugInfo;
         std::function<std::string (int NodeIndex)> mPathGetter;
+        CPlannerWorkspace* mWorkspace = nullptr;    // Workspace of the current search
+        CPlannerWorkspace mDefaultWorkspace;        // Workspace of the searches without a given one
+        SPlannerStats* mStats = nullptr;            // Optional statistics of the last search
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <typename TNode>
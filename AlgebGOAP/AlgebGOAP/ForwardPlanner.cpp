@@ -1,12 +1,12 @@
 // Copyright 2025 Isaac Hsu
 
 #include <iostream>
-#include <map>
 #include <sstream>
 
 #include "Action.h"
 #include "Condition.h"
 #include "Fact.h"
+#include "PlannerStats.h"
 #include "ForwardPlanner.h"
 #include "State.h"
 
@@ -33,8 +33,8 @@ std::string CForwardPlanner::SNode::ToString() const
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool CForwardPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CState& StartingState, CCondition& GoalCondition, std::vector<CAction*>& Actions, int MaxDepth)
 {
-    int Step = 0;
     oSteps.clear();
+    mNodes.swap(mWorkspace->GetScratch<SNodeScratch>().Nodes); // Borrow the search tree of the workspace until PostPlan.
     mNodes.reserve(Actions.size() * MaxDepth);
 
     if (ShouldPrintExcessiveHeuristic())
@@ -50,27 +50,34 @@ bool CForwardPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CState&
     RootNode.BaseHeuristicCost = GetBaseHeuristicCost(StartingState, GoalCondition, 0);
     RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalCondition);
 
-    std::multimap<float, int> OpenMap; // The open set in A*
-    OpenMap.emplace(RootNode.GetTotalCost(), 0);
+    COpenList& OpenList = mWorkspace->GetOpenList(); // The open set in A*
+    OpenList.Push(RootNode.GetTotalCost(), 0);
 
-    while (!OpenMap.empty())
+    while (!OpenList.IsEmpty())
     {
-        auto itCurr = OpenMap.begin();
-        const int CurrIndex = itCurr->second;
-        OpenMap.erase(itCurr);
+        if (mStats)
+        {
+            mStats->AddExpansion(OpenList.GetSize());
+        }
+
+        const int CurrIndex = OpenList.Pop();
         SNode& CurrNode = mNodes[CurrIndex];
+        mExpansionCount++;
 
         if (mFlags & ShowSteps)
         {
-            std::cout << "#" << ++Step << " #Nodes=" << mNodes.size();
+            std::cout << "#" << mExpansionCount << " #Nodes=" << mNodes.size();
             std::cout << ' ' << StringizeForwardPath(CurrIndex) << ' ' << CurrNode.ToString() << std::endl;
         }
 
-        if (GoalCondition.IsSatisfiedBy(*CurrNode.ConstState))
+        CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime);
+        const bool Reached = GoalCondition.IsSatisfiedBy(*CurrNode.ConstState);
+        GoalTestTimer.Stop();
+        if (Reached)
         {
             if (mFlags & ShowFinalOpenNodes)
             {
-                std::cout << StringizeNodes(OpenMap, GoalCondition);
+                std::cout << StringizeNodes(OpenList, GoalCondition);
             }
 
             BuildForwardPlan(oSteps, CurrIndex);
@@ -84,7 +91,7 @@ bool CForwardPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CState&
 
         for (const CAction* Action : Actions)
         {
-            Explore(OpenMap, CurrIndex, *Action, GoalCondition);
+            Explore(OpenList, CurrIndex, *Action, GoalCondition);
         }
     }
 
@@ -94,17 +101,34 @@ bool CForwardPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CState&
 void CForwardPlanner::PostPlan()
 {
     mNodes.clear();
+    mNodes.swap(mWorkspace->GetScratch<SNodeScratch>().Nodes); // Return the search tree to the workspace.
 }
 
-void CForwardPlanner::Explore(std::multimap<float, int>& oOpenMap, int NodeIndex, const CAction& Action, const CCondition& GoalCondition)
+void CForwardPlanner::Explore(COpenList& oOpenList, int NodeIndex, const CAction& Action, const CCondition& GoalCondition)
 {
-    if (!Action.CheckPrecondition(*mNodes[NodeIndex].ConstState))
+    CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
+    bool Applicable = Action.CheckPrecondition(*mNodes[NodeIndex].ConstState);
+    PreconditionTimer.Stop();
+
+    CStateArena& StateArena = mWorkspace->GetStateArena();
+    CState* MutableState = nullptr;
+    if (Applicable)
     {
-        return;
+        CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+        MutableState = mNodes[NodeIndex].ConstState->CloneInto(StateArena);
+        Applicable = Action.GetEffect().ApplyTo(*MutableState);
+        if (!Applicable)
+        {
+            StateArena.DestroyLast();
+        }
     }
 
-    auto MutableState = mNodes[NodeIndex].ConstState->Clone();
-    if (!Action.GetEffect().ApplyTo(*MutableState))
+    if (mStats)
+    {
+        mStats->AddCheck(Action, Applicable); // Count an action rejected by its effect once, like one rejected by its precondition.
+    }
+
+    if (!Applicable)
     {
         return;
     }
@@ -113,24 +137,31 @@ void CForwardPlanner::Explore(std::multimap<float, int>& oOpenMap, int NodeIndex
     SNode& ChildNode = mNodes.emplace_back();
     SNode& CurrNode = mNodes[NodeIndex];
     ChildNode.Action = &Action;
-    ChildNode.MutableState = std::move(MutableState);
+    ChildNode.MutableState = MutableState;
     Action.Affect(*ChildNode.MutableState);
-    ChildNode.ConstState = ChildNode.MutableState.get();
+    ChildNode.ConstState = ChildNode.MutableState;
     ChildNode.Parent = NodeIndex;
     ChildNode.Depth = CurrNode.Depth + 1;
     ChildNode.PreviousCost = CurrNode.GetActualCost();
     ChildNode.CurrentCost = Action.GetCost(*CurrNode.ConstState, *ChildNode.ConstState);
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
     ChildNode.BaseHeuristicCost = GetBaseHeuristicCost(*ChildNode.ConstState, GoalCondition, ChildIndex);
     ChildNode.ExtraHeuristicCost = ChildNode.ConstState->GetExtraHeuristicCost(GoalCondition);
+    HeuristicTimer.Stop();
     float TotalCost = ChildNode.GetTotalCost();
-    oOpenMap.emplace(TotalCost, ChildIndex);
+    oOpenList.Push(TotalCost, ChildIndex);
 }
 
-std::string CForwardPlanner::StringizeNodes(const std::multimap<float, int>& OpenMap, const CCondition& GoalCondition) const
+std::string CForwardPlanner::StringizeNodes(const COpenList& OpenList, const CCondition& GoalCondition) const
 {
     std::string Return;
 
-    for (auto [Cost, NodeIndex] : OpenMap)
+    for (auto [Cost, NodeIndex] : OpenList.GetSortedEntries())
     {
         const SNode& CurrNode = mNodes[NodeIndex];
         Return += "Nodes[";
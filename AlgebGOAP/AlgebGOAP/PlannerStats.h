@@ -0,0 +1,82 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace AlgebGOAP
+{
+    class CAction;
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct SPlannerStats // Statistics of a search, which planners collect only into attached instances
+    {
+        using CDuration = std::chrono::steady_clock::duration;
+
+        long long ExpandedCount = 0;    // Number of the nodes taken from the open set
+        long long GeneratedCount = 0;   // Number of the nodes created for successors
+        long long PrunedCount = 0;      // Number of the candidate actions rejected at expanded nodes
+        int MaxOpenCount = 0;           // Peak size of the open set
+        int MaxDepth = 0;               // Depth of the deepest generated node
+
+        CDuration HeuristicTime{};      // Time spent estimating the heuristic costs of generated nodes
+        CDuration PreconditionTime{};   // Time spent checking whether actions apply to expanded nodes
+        CDuration CloneTime{};          // Time spent copying states and applying effects
+        CDuration GoalTestTime{};       // Time spent checking whether expanded nodes reach the goal
+
+        std::unordered_map<const CAction*, long long> ApplicableCounts; // Number of the expanded nodes each action applied to
+
+    public:
+        // Clear all statistics for a new search.
+        void Reset();
+        // Record a node taken from an open set of a given size.
+        void AddExpansion(int OpenCount) { ExpandedCount++; MaxOpenCount = std::max(MaxOpenCount, OpenCount); }
+        // Record the result of checking whether an action applies to an expanded node.
+        void AddCheck(const CAction& Action, bool Applicable);
+        // Record a node generated at a given depth.
+        void AddGeneration(int Depth) { GeneratedCount++; MaxDepth = std::max(MaxDepth, Depth); }
+
+        // Key the applicable counts by given actions instead of their clones in the same order, which a search uses in their place.
+        void MapActions(const std::vector<std::unique_ptr<CAction>>& Clones, const std::vector<const CAction*>& Actions);
+
+        std::string ToString() const; // For debugging
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    class CStatsTimer // Timer adding the time until it stops to a duration of statistics, which does nothing without statistics
+    {
+    public:
+        CStatsTimer(SPlannerStats* Stats, SPlannerStats::CDuration SPlannerStats::* Duration)
+            : mDuration(Stats ? &(Stats->*Duration) : nullptr)
+        {
+            if (mDuration)
+            {
+                mStartTime = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~CStatsTimer() { Stop(); }
+
+        CStatsTimer(const CStatsTimer&) = delete;
+        CStatsTimer& operator = (const CStatsTimer&) = delete;
+
+        // Add the elapsed time to the duration. Later calls do nothing.
+        void Stop()
+        {
+            if (mDuration)
+            {
+                *mDuration += std::chrono::steady_clock::now() - mStartTime;
+                mDuration = nullptr;
+            }
+        }
+
+    private:
+        SPlannerStats::CDuration* mDuration;
+        std::chrono::steady_clock::time_point mStartTime;
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
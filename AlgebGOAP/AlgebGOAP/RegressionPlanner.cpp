@@ -7,6 +7,7 @@
 #include "Action.h"
 #include "BitVector.h"
 #include "Fact.h"
+#include "PlannerStats.h"
 #include "RegressionPlanner.h"
 #include "State.h"
 
@@ -15,8 +16,8 @@ using namespace AlgebGOAP;
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool CRegressionPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CState& StartingState, CCondition& GoalCondition, std::vector<CAction*>& Actions, int MaxDepth)
 {
-    int Step = 0;
     oSteps.clear();
+    mNodes.swap(mWorkspace->GetScratch<SNodeScratch>().Nodes); // Borrow the search tree of the workspace until PostPlan.
     mNodes.reserve(Actions.size() * MaxDepth);
 
     if (ShouldPrintExcessiveHeuristic())
@@ -34,20 +35,26 @@ bool CRegressionPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CStat
     RootNode.BaseHeuristicCost = GetBaseHeuristicCost(StartingState, GoalCondition, 0);
     RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalCondition);
 
-    std::multimap<float, int> OpenMap; // The open set in A*
-    OpenMap.emplace(RootNode.GetTotalCost(), 0);
+    COpenList& OpenList = mWorkspace->GetOpenList(); // The open set in A*
+    OpenList.Push(RootNode.GetTotalCost(), 0);
 
-    while (!OpenMap.empty())
+    while (!OpenList.IsEmpty())
     {
-        auto itCurr = OpenMap.begin();
-        const int CurrIndex = itCurr->second;
-        OpenMap.erase(itCurr);
+        if (mStats)
+        {
+            mStats->AddExpansion(OpenList.GetSize());
+        }
+
+        const int CurrIndex = OpenList.Pop();
         SNode& CurrNode = mNodes[CurrIndex];
+        mExpansionCount++;
 
+        CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime);
         bool Reached = CurrNode.ConstCondition->IsSatisfiedBy(StartingState);
+        GoalTestTimer.Stop();
         if (mFlags & ShowSteps)
         {
-            std::cout << "#" << ++Step << " #Nodes=" << mNodes.size();
+            std::cout << "#" << mExpansionCount << " #Nodes=" << mNodes.size();
             std::cout << ' ' << StringizeBackwardPath(mNodes, CurrIndex, Reached) << ' ';
             std::cout << StringizeNode(CurrNode) << std::endl;
         }
@@ -55,7 +62,7 @@ bool CRegressionPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CStat
         {
             if (mFlags & ShowFinalOpenNodes)
             {
-                std::cout << StringizeNodes(OpenMap, StartingState);
+                std::cout << StringizeNodes(OpenList, StartingState);
             }
 
             BuildBackwardPlan(oSteps, mNodes, CurrIndex);
@@ -69,7 +76,7 @@ bool CRegressionPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CStat
 
         for (const CAction* Action : Actions)
         {
-            Explore(OpenMap, CurrIndex, *Action, StartingState);
+            Explore(OpenList, CurrIndex, *Action, StartingState);
         }
     }
 
@@ -79,11 +86,21 @@ bool CRegressionPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CStat
 void CRegressionPlanner::PostPlan()
 {
     mNodes.clear();
+    mNodes.swap(mWorkspace->GetScratch<SNodeScratch>().Nodes); // Return the search tree to the workspace.
 }
 
-void CRegressionPlanner::Explore(std::multimap<float, int>& oOpenMap, int NodeIndex, const CAction& Action, const CState& StartingState)
+void CRegressionPlanner::Explore(COpenList& oOpenList, int NodeIndex, const CAction& Action, const CState& StartingState)
 {
+    // Regression both checks the action and applies its inverse effect.
+    CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
     std::unique_ptr<CCondition> DesiredCondition = CheckPostcondition(*mNodes[NodeIndex].ConstCondition, Action);
+    PreconditionTimer.Stop();
+
+    if (mStats)
+    {
+        mStats->AddCheck(Action, DesiredCondition != nullptr);
+    }
+
     if (!DesiredCondition)
     {
         return;
@@ -101,10 +118,17 @@ void CRegressionPlanner::Explore(std::multimap<float, int>& oOpenMap, int NodeIn
     Action.Affect(*ChildNode.MutableCondition);
     ChildNode.PreviousCost = CurrNode.GetActualCost();
     ChildNode.CurrentCost = Action.GetCost(*CurrNode.ConstCondition, *ChildNode.ConstCondition);
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
     ChildNode.BaseHeuristicCost = GetBaseHeuristicCost(StartingState, *ChildNode.ConstCondition, ChildIndex);
     ChildNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(*ChildNode.ConstCondition);
+    HeuristicTimer.Stop();
     float TotalCost = ChildNode.GetTotalCost();
-    oOpenMap.emplace(TotalCost, ChildIndex);
+    oOpenList.Push(TotalCost, ChildIndex);
 }
 
 std::unique_ptr<CCondition> CRegressionPlanner::CheckPostcondition(const CCondition& Postcondition, const CAction& Action) const
@@ -152,11 +176,11 @@ void CRegressionPlanner::ConjoinCondition(CCondition& oLeft, const CCondition& R
     oLeft.GetConstraint().RemoveRedundancy(oLeft.GetDefinition());
 }
 
-std::string CRegressionPlanner::StringizeNodes(const std::multimap<float, int>& OpenMap, const CState& StartingState) const
+std::string CRegressionPlanner::StringizeNodes(const COpenList& OpenList, const CState& StartingState) const
 {
     std::string Return;
 
-    for (auto [Cost, NodeIndex] : OpenMap)
+    for (auto [Cost, NodeIndex] : OpenList.GetSortedEntries())
     {
         const SNode& CurrNode = mNodes[NodeIndex];
         Return += "Nodes[";
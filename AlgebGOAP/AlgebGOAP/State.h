@@ -3,9 +3,11 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 #include "Number.h"
+#include "StateArena.h"
 
 
 namespace AlgebGOAP
@@ -22,6 +24,9 @@ namespace AlgebGOAP
     {
     public:
         explicit CStateBase(const CFactDefinition& Definition);
+        CStateBase(const CStateBase& Another) = default;
+        // Copy another state with its storage allocated from a given memory resource, such as a state arena.
+        CStateBase(const CStateBase& Another, std::pmr::memory_resource* Resource) : mDefinition(Another.mDefinition), mProperties(Another.mProperties, Resource) {}
 
         const CFactDefinition& GetDefinition() const { return mDefinition; }
 
@@ -40,7 +45,7 @@ namespace AlgebGOAP
 
     protected:
         const CFactDefinition& mDefinition;
-        std::vector<CNumber> mProperties;
+        std::pmr::vector<CNumber> mProperties; // Copies take the default memory resource.
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
     class CState : public CStateBase // World state composed of world properties
@@ -49,9 +54,15 @@ namespace AlgebGOAP
         friend class CEffect;
     public:
         explicit CState(const CFactDefinition& Definition);
+        CState(const CState& Another) = default;
+        // Copy another state with its storage allocated from a given memory resource, such as a state arena.
+        CState(const CState& Another, std::pmr::memory_resource* Resource) : CStateBase(Another, Resource) {}
         virtual ~CState() {}
 
         virtual std::unique_ptr<CState> Clone() const { return std::make_unique<CState>(*this); }
+        // Clone this state into an arena. Subclasses override it with Arena.Create<CSubclass>(*this, &Arena) and a constructor passing the arena
+        // on to the copy constructor of CState with a memory resource, or their Clone results are adopted.
+        virtual CState* CloneInto(CStateArena& Arena) const;
         virtual std::string ToString() const; // For debugging
         virtual float GetExtraHeuristicCost(const CCondition& Condition) const { return 0.f; } // Custom heuristic cost
 
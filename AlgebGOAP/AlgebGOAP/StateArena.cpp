@@ -0,0 +1,81 @@
+// Copyright 2026 Isaac Hsu
+
+#include <algorithm>
+
+#include "State.h"
+#include "StateArena.h"
+
+
+using namespace AlgebGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+CState* CStateArena::Adopt(std::unique_ptr<CState> State)
+{
+    SEntry Entry;
+    Entry.State = State.get();
+    Entry.BlockIndex = mBlockIndex;
+    Entry.Offset = mOffset;
+    Entry.Adopted = true;
+    mEntries.push_back(Entry);
+    mAdoptedStates.push_back(std::move(State));
+    return Entry.State;
+}
+
+void CStateArena::DestroyLast()
+{
+    if (mEntries.empty())
+    {
+        return;
+    }
+
+    const SEntry& Entry = mEntries.back();
+    if (Entry.Adopted)
+    {
+        mAdoptedStates.pop_back();
+    }
+    else
+    {
+        Entry.State->~CState();
+    }
+
+    mBlockIndex = Entry.BlockIndex;
+    mOffset = Entry.Offset;
+    mEntries.pop_back();
+}
+
+void CStateArena::Clear()
+{
+    for (auto it = mEntries.rbegin(); it != mEntries.rend(); it++)
+    {
+        if (!it->Adopted)
+        {
+            it->State->~CState();
+        }
+    }
+
+    mEntries.clear();
+    mAdoptedStates.clear();
+    mBlockIndex = 0;
+    mOffset = 0;
+}
+
+void* CStateArena::Allocate(size_t Size, size_t Alignment)
+{
+    for (; mBlockIndex < mBlocks.size(); mBlockIndex++, mOffset = 0)
+    {
+        SBlock& Block = mBlocks[mBlockIndex];
+        size_t Offset = (mOffset + Alignment - 1) & ~(Alignment - 1);
+        if (Offset + Size <= Block.Size)
+        {
+            mOffset = Offset + Size;
+            return Block.Memory.get() + Offset;
+        }
+    }
+
+    SBlock& Block = mBlocks.emplace_back();
+    Block.Size = std::max(mBlockSize, Size);
+    Block.Memory.reset(new std::byte[Block.Size]);
+    mBlockIndex = mBlocks.size() - 1;
+    mOffset = Size;
+    return Block.Memory.get();
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
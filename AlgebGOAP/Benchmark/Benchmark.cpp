@@ -0,0 +1,382 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This program runs every planner on synthetic domains and reports the number of expansions, the 
+// time per expansion, the peak memory allocated during the search, and the plan cost, so that 
+// scaling curves and regressions can be tracked across changes.
+// 
+// A generated domain hides a chain of actions, each of which requires the Boolean fact set by the 
+// previous one, so the optimal plan has exactly as many steps as the chain. The other actions are
+// distractors with random preconditions and effects on the facts off the chain, which widen the 
+// search without offering any shortcut. Numeric distractors compare and add small integers.
+// Expansions are read from the planners, which run without any printing flag.
+// 
+// Usage: Benchmark [Facts=N] [Actions=N] [Preconditions=N] [Effects=N] [Numbers=R] [Depth=N] [Seed=N] [Repeats=N]
+// Numbers is the ratio of numeric facts among the facts off the chain.
+// Without a domain parameter, a sweep over action counts and plan depths is run.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+
+#include "AlgebGOAP/Action.h"
+#include "AlgebGOAP/AdvRegressionPlanner.h"
+#include "AlgebGOAP/BackwardPlanner.h"
+#include "AlgebGOAP/Condition.h"
+#include "AlgebGOAP/Fact.h"
+#include "AlgebGOAP/Formula.h"
+#include "AlgebGOAP/ForwardPlanner.h"
+#include "AlgebGOAP/Notation.h"
+#include "AlgebGOAP/RegressionPlanner.h"
+#include "AlgebGOAP/State.h"
+
+
+using namespace AlgebGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Allocation tracking through the replaceable global allocation functions
+namespace
+{
+    constexpr size_t AllocationHeader = alignof(std::max_align_t); // Room before each block to remember its size
+    size_t LiveBytes = 0;   // Bytes currently allocated
+    size_t PeakBytes = 0;   // Highest LiveBytes since the last reset
+}
+
+void* operator new(size_t Size)
+{
+    char* Block = static_cast<char*>(std::malloc(Size + AllocationHeader));
+    if (!Block)
+    {
+        throw std::bad_alloc();
+    }
+
+    *reinterpret_cast<size_t*>(Block) = Size;
+    LiveBytes += Size;
+    PeakBytes = std::max(PeakBytes, LiveBytes);
+    return Block + AllocationHeader;
+}
+
+void operator delete(void* Pointer) noexcept
+{
+    if (Pointer)
+    {
+        char* Block = static_cast<char*>(Pointer) - AllocationHeader;
+        LiveBytes -= *reinterpret_cast<size_t*>(Block);
+        std::free(Block);
+    }
+}
+
+void* operator new[](size_t Size) { return operator new(Size); }
+void operator delete[](void* Pointer) noexcept { operator delete(Pointer); }
+void operator delete(void* Pointer, size_t) noexcept { operator delete(Pointer); }
+void operator delete[](void* Pointer, size_t) noexcept { operator delete(Pointer); }
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct SDomainSpec // Parameters of a synthetic domain
+{
+    int FactCount = 32;             // Number of facts including the chain
+    int ActionCount = 32;           // Number of actions including the chain
+    int PreconditionCount = 2;      // Number of preconditions of each distractor
+    int EffectCount = 2;            // Number of effects of each distractor
+    float NumberRatio = 0.5f;       // Ratio of numeric facts among the facts off the chain
+    int Depth = 4;                  // Number of steps of the optimal plan
+    unsigned Seed = 1;
+};
+
+struct SDomain // A synthetic planning problem, which refers to its own fact definition and can't be copied
+{
+    CFactDefinition Definition;
+    std::unique_ptr<CState> StartingState;      // Created after all facts are defined
+    std::unique_ptr<CCondition> GoalCondition;
+    std::vector<CAction> Actions;
+    std::vector<const CAction*> ActionPtrs;
+};
+
+struct SRunResult
+{
+    bool Found = false;
+    float Cost = 0.f;
+    long long Expansions = 0;
+    double Nanoseconds = 0.0;   // Time of the fastest repeat
+    size_t PeakBytes = 0;
+};
+
+using CPlanFunction = std::function<bool(std::vector<const CAction*>& oSteps, const SDomain& Domain, int MaxDepth, long long& oExpansions)>;
+
+struct SPlannerEntry
+{
+    const char* Name;
+    CPlanFunction Plan;
+};
+
+constexpr int NumberLimit = 10;         // Numeric facts start below this limit and are compared with values below it.
+constexpr int MaxNumericDelta = 3;      // Numeric effects add at most this amount in either direction.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GenerateDomain(SDomain& oDomain, const SDomainSpec& Spec)
+{
+    std::mt19937 Random(Spec.Seed);
+    auto RandomInt = [&Random](int Count) { return static_cast<int>(Random() % static_cast<unsigned>(Count)); };
+
+    const int ChainFactCount = Spec.Depth + 1;
+    const int FreeFactCount = std::max(Spec.FactCount - ChainFactCount, 0);
+    const int NumberCount = static_cast<int>(FreeFactCount * std::clamp(Spec.NumberRatio, 0.f, 1.f));
+
+    std::vector<const CBooleanFact*> ChainFacts;
+    std::vector<const CBooleanFact*> BooleanFacts;
+    std::vector<const CNumericFact*> NumericFacts;
+    for (int i = 0; i < ChainFactCount; i++)
+    {
+        ChainFacts.push_back(oDomain.Definition.DefineBoolean("Chain" + std::to_string(i)));
+    }
+    for (int i = 0; i < NumberCount; i++)
+    {
+        NumericFacts.push_back(oDomain.Definition.DefineNumber("Number" + std::to_string(i)));
+    }
+    for (int i = NumberCount; i < FreeFactCount; i++)
+    {
+        BooleanFacts.push_back(oDomain.Definition.DefineBoolean("Flag" + std::to_string(i)));
+    }
+
+    oDomain.StartingState = std::make_unique<CState>(oDomain.Definition);
+    for (int i = 0; i < ChainFactCount; i++)
+    {
+        oDomain.StartingState->SetProperty(*ChainFacts[i], i == 0);
+    }
+    for (const CNumericFact* Fact : NumericFacts)
+    {
+        oDomain.StartingState->SetProperty(*Fact, RandomInt(NumberLimit));
+    }
+    for (const CBooleanFact* Fact : BooleanFacts)
+    {
+        oDomain.StartingState->SetProperty(*Fact, RandomInt(2) == 1);
+    }
+
+    oDomain.GoalCondition = std::make_unique<CCondition>(oDomain.Definition);
+    oDomain.GoalCondition->SetConstraint(*ChainFacts.back() == true);
+
+    oDomain.Actions.reserve(std::max(Spec.ActionCount, Spec.Depth));
+    for (int i = 0; i < Spec.Depth; i++)
+    {
+        CAction& Action = oDomain.Actions.emplace_back("Step" + std::to_string(i), oDomain.Definition);
+        Action.SetPrecondition(*ChainFacts[i] == true);
+        Action.AddEffect(*ChainFacts[i + 1] = true);
+    }
+
+    for (int i = Spec.Depth; i < Spec.ActionCount; i++)
+    {
+        CAction& Action = oDomain.Actions.emplace_back("Act" + std::to_string(i), oDomain.Definition);
+        Action.SetBaseCost(static_cast<float>(1 + RandomInt(3)));
+
+        std::vector<CRelation> Relations;
+        for (int j = 0; j < Spec.PreconditionCount; j++)
+        {
+            int Fact = RandomInt(ChainFactCount + FreeFactCount);
+            if (Fact < ChainFactCount)
+            {
+                Relations.push_back(*ChainFacts[Fact] == (RandomInt(2) == 1));
+            }
+            else if ((Fact -= ChainFactCount) < NumberCount)
+            {
+                const CNumber Value = RandomInt(NumberLimit);
+                Relations.push_back(RandomInt(2) ? (*NumericFacts[Fact] >= Value) : (*NumericFacts[Fact] <= Value));
+            }
+            else
+            {
+                Relations.push_back(*BooleanFacts[Fact - NumberCount] == (RandomInt(2) == 1));
+            }
+        }
+
+        if (!Relations.empty()) // The precondition is the conjunction of the relations.
+        {
+            CFormula Precondition(Relations.front());
+            for (size_t j = 1; j < Relations.size(); j++)
+            {
+                Precondition = CFormula(EConnective::logicalAND, std::move(Precondition), std::move(Relations[j]));
+            }
+            Action.SetPrecondition(std::move(Precondition));
+        }
+
+        for (int j = 0; j < Spec.EffectCount && FreeFactCount > 0; j++) // Distractors never touch the chain, which keeps the chain optimal.
+        {
+            const int Fact = RandomInt(FreeFactCount);
+            if (Fact < NumberCount)
+            {
+                const CNumber Delta = 1 + RandomInt(MaxNumericDelta);
+                Action.AddEffect(RandomInt(2) ? (*NumericFacts[Fact] += Delta) : (*NumericFacts[Fact] -= Delta));
+            }
+            else
+            {
+                Action.AddEffect(*BooleanFacts[Fact - NumberCount] = (RandomInt(2) == 1));
+            }
+        }
+    }
+
+    for (const CAction& Action : oDomain.Actions)
+    {
+        oDomain.ActionPtrs.push_back(&Action);
+    }
+}
+
+template <typename TPlanner>
+bool PlanWith(std::vector<const CAction*>& oSteps, const SDomain& Domain, int MaxDepth, long long& oExpansions)
+{
+    TPlanner Planner; // No flags, so nothing is printed.
+    const bool Found = Planner.Plan(oSteps, *Domain.StartingState, *Domain.GoalCondition, Domain.ActionPtrs, MaxDepth);
+    oExpansions = Planner.GetExpansionCount();
+    return Found;
+}
+
+std::vector<SPlannerEntry> GetPlanners()
+{
+    return {
+        {"Forward", PlanWith<CForwardPlanner>},
+        {"Backward", PlanWith<CBackwardPlanner>},
+        {"Regressive", PlanWith<CRegressionPlanner>},
+        {"AdvRegressive", PlanWith<CAdvRegressionPlanner>},
+    };
+}
+
+SRunResult RunPlanner(const SPlannerEntry& Planner, const SDomain& Domain, int MaxDepth, int Repeats)
+{
+    SRunResult Result;
+    std::vector<const CAction*> Steps;
+
+    for (int i = 0; i < Repeats; i++)
+    {
+        Steps.clear();
+        Steps.shrink_to_fit(); // Count the plan itself in the peak memory of every repeat.
+        const size_t BaseBytes = LiveBytes;
+        PeakBytes = LiveBytes;
+
+        auto StartTime = std::chrono::steady_clock::now();
+        Result.Found = Planner.Plan(Steps, Domain, MaxDepth, Result.Expansions);
+        auto EndTime = std::chrono::steady_clock::now();
+
+        const double Nanoseconds = std::chrono::duration<double, std::nano>(EndTime - StartTime).count();
+        Result.Nanoseconds = (i == 0) ? Nanoseconds : std::min(Result.Nanoseconds, Nanoseconds);
+        Result.PeakBytes = std::max(Result.PeakBytes, PeakBytes - BaseBytes);
+    }
+
+    Result.Cost = 0.f;
+    for (const CAction* Step : Steps)
+    {
+        Result.Cost += Step->GetBaseCost();
+    }
+
+    return Result;
+}
+
+void RunBenchmark(const SDomainSpec& Spec, int Repeats)
+{
+    SDomain Domain;
+    GenerateDomain(Domain, Spec);
+
+    std::cout << "Facts=" << Spec.FactCount << " Actions=" << Spec.ActionCount << " Preconditions=" << Spec.PreconditionCount << " Effects=" << Spec.EffectCount;
+    std::cout << " Numbers=" << Spec.NumberRatio << " Depth=" << Spec.Depth << " Seed=" << Spec.Seed << "\n";
+    std::cout << std::left << std::setw(20) << "Planner" << std::right << std::setw(7) << "Found" << std::setw(8) << "Cost";
+    std::cout << std::setw(12) << "Expansions" << std::setw(14) << "ns/Expansion" << std::setw(12) << "Peak KiB" << "\n";
+
+    for (const SPlannerEntry& Planner : GetPlanners())
+    {
+        SRunResult Result = RunPlanner(Planner, Domain, Spec.Depth, Repeats);
+        const double NanosecondsPerExpansion = Result.Nanoseconds / std::max(Result.Expansions, 1LL);
+
+        std::cout << std::left << std::setw(20) << Planner.Name << std::right << std::setw(7) << (Result.Found ? "yes" : "no") << std::setw(8) << Result.Cost;
+        std::cout << std::setw(12) << Result.Expansions << std::setw(14) << std::fixed << std::setprecision(1) << NanosecondsPerExpansion;
+        std::cout << std::setw(12) << Result.PeakBytes / 1024.0 << std::defaultfloat << std::setprecision(6) << "\n";
+    }
+
+    std::cout << std::endl;
+}
+
+void PrintUsage()
+{
+    std::cout << "Usage: Benchmark [Facts=N] [Actions=N] [Preconditions=N] [Effects=N] [Numbers=R] [Depth=N] [Seed=N] [Repeats=N]\n";
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    SDomainSpec Spec;
+    int Repeats = 3;
+    bool Sweep = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string Argument = argv[i];
+        const size_t Separator = Argument.find('=');
+        if (Separator == std::string::npos)
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        const std::string Key = Argument.substr(0, Separator);
+        const char* Value = argv[i] + Separator + 1;
+
+        if (Key == "Repeats")
+        {
+            Repeats = std::max(std::atoi(Value), 1);
+            continue;
+        }
+
+        if (Key == "Facts")
+        {
+            Spec.FactCount = std::atoi(Value);
+        }
+        else if (Key == "Actions")
+        {
+            Spec.ActionCount = std::atoi(Value);
+        }
+        else if (Key == "Preconditions")
+        {
+            Spec.PreconditionCount = std::atoi(Value);
+        }
+        else if (Key == "Effects")
+        {
+            Spec.EffectCount = std::atoi(Value);
+        }
+        else if (Key == "Numbers")
+        {
+            Spec.NumberRatio = static_cast<float>(std::atof(Value));
+        }
+        else if (Key == "Depth")
+        {
+            Spec.Depth = std::max(std::atoi(Value), 1);
+        }
+        else if (Key == "Seed")
+        {
+            Spec.Seed = static_cast<unsigned>(std::atoi(Value));
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        Sweep = false; // Any domain parameter selects a single run.
+    }
+
+    if (!Sweep)
+    {
+        RunBenchmark(Spec, Repeats);
+        return 0;
+    }
+
+    for (int Depth : {3, 4})
+    {
+        for (int ActionCount : {16, 32, 64, 128})
+        {
+            Spec.Depth = Depth;
+            Spec.ActionCount = ActionCount;
+            RunBenchmark(Spec, Repeats);
+        }
+    }
+
+    return 0;
+}
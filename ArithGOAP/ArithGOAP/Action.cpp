@@ -1,5 +1,6 @@
 // Copyright 2024 Isaac Hsu
 
+#include <algorithm>
 #include <cassert>
 
 #include "Action.h"
@@ -54,28 +55,40 @@ bool CAction::CheckPrecondition(const CState& State) const
 }
 
 std::unique_ptr<CState> CAction::CheckPostcondition(const CState& Postcondition) const
+{
+    std::unique_ptr<CState> Condition = Postcondition.Clone();
+    if (!Regress(*Condition))
+    {
+        return {};
+    }
+
+    return Condition;
+}
+
+bool CAction::Regress(CState& ioCondition) const
 {
     // This action is considered a candidate in the regressive search if it can satisfy at least one desired property,
     // and its effects and preconditions do not conflict with the given desired state.
-    assert(&Postcondition.GetDefinition() == &GetDefinition());
+    assert(&ioCondition.GetDefinition() == &GetDefinition());
 
-    std::unique_ptr<CState> Condition = Postcondition.Clone();
     bool AnySatisfaction = false;
     CNumber Tolerance = GetDefinition().GetTolerance();
+    ioCondition.Expand(std::max(mEffect.GetTransformCapacity(), mPrecondition.GetPropertyCapacity()));
 
-    for (int FactIndex = 0; FactIndex < mEffect.GetTransformCapacity(); FactIndex++)
+    for (int FactIndex : ioCondition.GetSetProperties()) // Skip unset constraints.
     {
+        if (FactIndex >= mEffect.GetTransformCapacity())
+        {
+            break;
+        }
+
         const CTransform& Transform = mEffect.GetTransform(FactIndex);
         if (Transform.IsNil())
         {
             continue; // Skip unset effects.
         }
 
-        SSegment& Target = Condition->GetProperty(FactIndex);
-        if (Target.IsUnset())
-        {
-            continue; // Skip unset constraints.
-        }
+        SSegment Target = ioCondition.GetProperty(FactIndex);
 
         const CFact* Fact = GetDefinition().GetFact(FactIndex);
         const SSegment Range = Fact ? Fact->GetRange() : SSegment::Boundless;
@@ -83,7 +96,7 @@ std::unique_ptr<CState> CAction::CheckPostcondition(const CState& Postcondition)
         switch (Transform.Reserve(Target, Range, Tolerance))
         {
         case ETriStateCompletion::failed:
-            return {};                  // This action is infeasible due to the conflicting effect.
+            return false;                  // This action is infeasible due to the conflicting effect.
         case ETriStateCompletion::complete:
             AnySatisfaction = true;
             Target = SSegment::Unset;   // Erase the fully satisfied property.
@@ -92,32 +105,31 @@ std::unique_ptr<CState> CAction::CheckPostcondition(const CState& Postcondition)
             AnySatisfaction = true;     // Partial satisfaction is okay.
             break;
         }
+
+        ioCondition.SetProperty(FactIndex, Target);
     }
 
     if (!AnySatisfaction)
     {
-        return {}; // This action cannot satisfy any desired properties.
+        return false; // This action cannot satisfy any desired properties.
     }
 
-    for (int FactIndex = 0; FactIndex < mPrecondition.GetPropertyCapacity(); FactIndex++)
+    for (int FactIndex : mPrecondition.GetSetProperties())
     {
-        const SSegment& Constraint = mPrecondition.GetProperty(FactIndex);
-        if (Constraint.IsUnset())
-        {
-            continue;
-        }
-
-        SSegment& Target = Condition->GetProperty(FactIndex);
+        const SSegment Constraint = mPrecondition.GetProperty(FactIndex);
+        SSegment Target = ioCondition.GetProperty(FactIndex);
         if (Target.IsUnset())
         {
             Target = Constraint; // Add the precondition to the desired state if it does not exist.
         }
         else if (!Target.Intersect(Constraint, Tolerance)) // Find the intersection between the precondition and desired state.
         {
-            return {}; // This action is infeasible due to a conflict between the precondition and desired state.
+            return false; // This action is infeasible due to a conflict between the precondition and desired state.
         }
+
+        ioCondition.SetProperty(FactIndex, Target);
     }
 
-    return Condition;
+    return true;
 }
 ///////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
@@ -23,7 +23,9 @@ namespace ArithGOAP
         // Is this action feasible in the forward search?
         virtual bool CheckPrecondition(const CState& State) const;
         // Reverse this action from a given state and return the previous state, if feasible.
-        virtual std::unique_ptr<CState> CheckPostcondition(const CState& Postcondition) const;
+        std::unique_ptr<CState> CheckPostcondition(const CState& Postcondition) const;
+        // Reverse this action on a desired state in place. Return false if infeasible, leaving the state partially modified.
+        virtual bool Regress(CState& ioCondition) const;
         // Overridable function invoked on the state of each search node for customization. Do NOT modify the properties. 
         virtual void Affect(CState& State) const {}
         // Customizable cost of this action
@@ -1,39 +1,59 @@
 // Copyright 2024 Isaac Hsu
 
 #include <cassert>
-#include <iostream>
 #include <typeinfo>
 
 #include "Action.h"
 #include "AdvRegressionPlanner.h"
 #include "Fact.h"
+#include "Observer.h"
+#include "PlannerStats.h"
+#include "Workspace.h"
 
 
 using namespace ArithGOAP;
 ///////////////////////////////////////////////////////////////////////////////////////////////////
+void CAdvRegressionPlanner::SEffectScratch::Clear()
+{
+    FactActionMap.clear();
+    ConstantEffectMap.clear();
+    EffectDirectionMap.clear();
+    CandidateActions.clear();
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
 bool CAdvRegressionPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
 {
-    std::cout << typeid(*this).name() << std::endl;
-    if (StartingState.GetDefinition().HasAnyRange())
+    CPlannerWorkspace Workspace;
+    return Plan(oSteps, StartingState, GoalState, Actions, MaxDepth, Workspace);
+}
+
+bool CAdvRegressionPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace)
+{
+    if (mObserver)
+    {
+        mObserver->OnStart(typeid(*this).name(), StartingState, GoalState);
+    }
+
+    if (mStats)
     {
-        std::cout << "RANGE: {" << StartingState.GetDefinition().StringizeBoundedRanges() << "}" << std::endl;
+        mStats->Reset();
     }
-    std::cout << "START: {" << StartingState.ToString() << "}" << std::endl;
-    std::cout << "GOAL : {" << GoalState.ToString() << "}" << std::endl;
 
-    CFactActionMap FactActionMap;           // Mapping of facts to actions
-    CConstantEffectMap ConstantEffectMap;   // Mapping of facts to effect values
-    CEffectDirectionMap EffectDirectionMap; // Mapping of facts to effect directions
+    Workspace.Clear();
+    SEffectScratch& Scratch = Workspace.GetScratch<SEffectScratch>();
+    CFactActionMap& FactActionMap = Scratch.FactActionMap;
+    CConstantEffectMap& ConstantEffectMap = Scratch.ConstantEffectMap;
+    CEffectDirectionMap& EffectDirectionMap = Scratch.EffectDirectionMap;
     BuildEffectMaps(FactActionMap, ConstantEffectMap, EffectDirectionMap, Actions);
 
-    std::unordered_set<const CAction*> CandidateActions;
+    std::unordered_set<const CAction*>& CandidateActions = Scratch.CandidateActions;
     CandidateActions.reserve(Actions.size());
 
     int Step = 0;
     oSteps.clear();
     MaxDepth = std::max(MaxDepth, 0);
 
-    std::vector<SNode> Nodes;
+    std::vector<SNode>& Nodes = Workspace.GetNodes();
     Nodes.reserve(Actions.size() * MaxDepth);
 
     SNode& RootNode = Nodes.emplace_back();
@@ -41,41 +61,75 @@ bool CAdvRegressionPlanner::Plan(std::vector<const CAction*>& oSteps, const CSta
     RootNode.BaseHeuristicCost = StartingState.GetBaseHeuristicCost(GoalState);
     RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalState);
 
-    std::multimap<float, int> OpenMap; // The open set in A*
-    OpenMap.emplace(RootNode.GetTotalCost(), 0);
+    COpenList& OpenList = Workspace.GetOpenList(); // The open set in A*
+    OpenList.Push(RootNode.GetTotalCost(), 0);
+
+    SRegressionScratch& RegressionScratch = Workspace.GetScratch<SRegressionScratch>();
+    CSubsumptionIndex& ExpandedStates = RegressionScratch.ExpandedStates;
 
-    while (!OpenMap.empty())
+    while (!OpenList.IsEmpty())
     {
-        auto itCurr = OpenMap.begin();
-        const int CurrIndex = itCurr->second;
+        const int CurrIndex = OpenList.GetTop();
         SNode& CurrNode = Nodes[CurrIndex];
 
+        if (mStats)
+        {
+            mStats->AddExpansion(OpenList.GetSize());
+        }
+
+        CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime);
         bool Reached = !CurrNode.ConstState->IsContradictory(StartingState);
-        std::cout << "#" << ++Step << " #Nodes=" << Nodes.size();
-        std::cout << " |" << ((Reached || CurrIndex == 0) ? "" : "? ") << StringizePath(Nodes, CurrIndex) << "| ";
-        std::cout << CurrNode.ToString() << std::endl;
+        GoalTestTimer.Stop();
+        if (mObserver)
+        {
+            auto GetPath = [&] { return ((Reached || CurrIndex == 0) ? "" : "? ") + StringizePath(Nodes, CurrIndex); };
+            mObserver->OnExpand(++Step, static_cast<int>(Nodes.size()), GetPath, [&] { return CurrNode.ToString(); });
+        }
+
         if (Reached)
         {
             BuildPlan(oSteps, Nodes, CurrIndex);
             return true;
         }
 
-        OpenMap.erase(itCurr);
+        OpenList.Pop();
 
         if (CurrNode.Depth >= MaxDepth)
         {
             continue;
         }
 
+        if (mSubsumptionPruning)
+        {
+            if (CheckDomination(ExpandedStates, CurrNode))
+            {
+                continue; // A node dominating this one has been expanded since this one was generated.
+            }
+
+            ExpandedStates.Add(*CurrNode.ConstState, CurrNode.GetActualCost(), CurrNode.Depth);
+        }
+
         CandidateActions.clear();
-        if (!FindFeasibleActions(CandidateActions, *CurrNode.ConstState, StartingState, FactActionMap, ConstantEffectMap, EffectDirectionMap))
+        CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
+        const bool Feasible = FindFeasibleActions(CandidateActions, *CurrNode.ConstState, StartingState, FactActionMap, ConstantEffectMap, EffectDirectionMap);
+        PreconditionTimer.Stop();
+
+        if (!Feasible)
         {
             continue;
         }
 
         for (const CAction* Action : CandidateActions)
         {
-            Explore(OpenMap, Nodes, CurrIndex, *Action, StartingState);
+            Explore(OpenList, Nodes, Workspace.GetStateArena(), ExpandedStates, CurrIndex, *Action, StartingState);
+        }
+
+        if (mMaxRepetition > 1)
+        {
+            for (const CAction* Action : CandidateActions)
+            {
+                ExploreRepetitions(OpenList, Nodes, Workspace.GetStateArena(), RegressionScratch, CurrIndex, *Action, StartingState);
+            }
         }
     }
 
@@ -156,16 +210,10 @@ bool CAdvRegressionPlanner::FindFeasibleActions(std::unordered_set<const CAction
 {
     const CNumber Tolerance = StartingState.GetDefinition().GetTolerance();
 
-    for (auto& Fact : StartingState.GetDefinition())
+    for (int FactIndex : DesiredState.GetSetProperties()) // Skip unset properties.
     {
-        const int FactIndex = Fact->GetIndex();
-        const SSegment& Target = DesiredState.GetProperty(FactIndex);
-        if (Target.IsUnset()) 
-        {
-            continue; // Skip unset properties.
-        }
-
-        const SSegment& StartingValue = StartingState.GetProperty(FactIndex);
+        const SSegment Target = DesiredState.GetProperty(FactIndex);
+        const SSegment StartingValue = StartingState.GetProperty(FactIndex);
         if (!Target.HasIntersection(StartingValue, Tolerance)) // Check if the desired property does not match its starting value.
         {
             auto itDir = EffectDirectionMap.find(FactIndex);
@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "Number.h"
 #include "RegressionPlanner.h"
 
 
@@ -35,13 +36,26 @@ namespace ArithGOAP
     ///////////////////////////////////////////////////////////////////////////////////////////////
     class CAdvRegressionPlanner : public CRegressionPlanner // Regressive arithmetic GOAP with effect lookup tables
     {
+    public:
         using CFactActionMap        = std::unordered_multimap<int, const CAction*>;
         using CConstantEffectMap    = std::unordered_map<int, std::set<CNumber>>;
         using CEffectDirectionMap   = std::unordered_map<int, EEffectDirection>;
-    public:
+
         bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth);
+        // Same as above but with the buffers of a given workspace, which keeps their capacity for later calls.
+        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace);
 
     protected:
+        struct SEffectScratch : CPlannerWorkspace::SScratch // Effect lookup tables and buffers of regressive searches with them
+        {
+            CFactActionMap FactActionMap;                       // Mapping of facts to actions
+            CConstantEffectMap ConstantEffectMap;               // Mapping of facts to effect values
+            CEffectDirectionMap EffectDirectionMap;             // Mapping of facts to effect directions
+            std::unordered_set<const CAction*> CandidateActions; // Candidate actions of a node
+
+            void Clear() override;
+        };
+
         // Build effect lookup tables.
         void BuildEffectMaps(CFactActionMap& oFactActionMap, CConstantEffectMap& oConstantEffectMap, CEffectDirectionMap& oEffectDirectionMap, const std::vector<const CAction*>& Actions);
         // Look up feasible actions in given lookup tables.
@@ -6,6 +6,7 @@
 #include "AdvRegressionPlanner.h"
 #include "ArithGOAP.h"
 #include "ForwardPlanner.h"
+#include "Observer.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -66,7 +67,7 @@ namespace ArithGOAP
         return true;
     }
 
-    bool ForwardSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
+    bool ForwardSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CSearchObserver* Observer)
     {
         if (!CheckInput(StartingState, GoalState, Actions))
         {
@@ -74,10 +75,11 @@ namespace ArithGOAP
         }
 
         CForwardPlanner Planner;
+        Planner.SetObserver(Observer);
         return Planner.Plan(oSteps, StartingState, GoalState, Actions, MaxDepth);
     }
 
-    bool RegressiveSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
+    bool RegressiveSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CSearchObserver* Observer)
     {
         if (!CheckInput(StartingState, GoalState, Actions))
         {
@@ -85,10 +87,11 @@ namespace ArithGOAP
         }
 
         CRegressionPlanner Planner;
+        Planner.SetObserver(Observer);
         return Planner.Plan(oSteps, StartingState, GoalState, Actions, MaxDepth);
     }
 
-    bool AdvRegressiveSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
+    bool AdvRegressiveSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CSearchObserver* Observer)
     {
         if (!CheckInput(StartingState, GoalState, Actions))
         {
@@ -96,6 +99,7 @@ namespace ArithGOAP
         }
 
         CAdvRegressionPlanner Planner;
+        Planner.SetObserver(Observer);
         return Planner.Plan(oSteps, StartingState, GoalState, Actions, MaxDepth);
     }
 }
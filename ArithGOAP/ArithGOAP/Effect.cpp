@@ -1,6 +1,8 @@
 ﻿// Copyright 2024 Isaac Hsu
 
 #include <cassert>
+#include <cmath>
+#include <limits>
 
 #include "Effect.h"
 #include "Fact.h"
@@ -114,6 +116,62 @@ ETriStateCompletion CTransform::Reserve(SSegment& oTarget, const SSegment& Range
 
     return ETriStateCompletion::failed;
 }
+
+int CTransform::CountRepetitions(const SSegment& Value, const SSegment& Target, CNumber Tolerance) const
+{
+    if (Value.HasIntersection(Target, Tolerance))
+    {
+        return 0;
+    }
+
+    if (Value.IsUnset() || Value.IsEmpty() || Target.IsUnset() || Target.IsEmpty() || !Operand.IsFinite())
+    {
+        return -1;
+    }
+
+    // Repetition has to carry the nearest bound of the value to the nearest bound of the target.
+    const bool Upward = Value.Maximum < Target.Minimum;
+    const CNumber From = Upward ? Value.Maximum : Value.Minimum;
+    const CNumber To = Upward ? Target.Minimum : Target.Maximum;
+
+    CNumber::BValue Count = CNumber::NaN;
+    if (Operator == EOperator::addition)
+    {
+        Count = (To - From) / Operand; // From + k * Operand = To
+    }
+    else if (Operator == EOperator::multiplication && Operand > 0)
+    {
+        Count = std::log(To / From) / std::log(Operand); // From * Operand^k = To. Negative multipliers alternate signs, so they are left out.
+    }
+
+    if (!(Count > 0 && Count < std::numeric_limits<int>::max()))
+    {
+        return -1; // The transformation heads the other way, stays still, or never gets there.
+    }
+
+    auto Reach = [&](int Repetition)
+    {
+        SSegment Result = Value;
+        if (Operator == EOperator::addition)
+        {
+            Result += Operand * Repetition;
+        }
+        else
+        {
+            Result *= std::pow(Operand.Get(), Repetition);
+        }
+
+        return Result.HasIntersection(Target, Tolerance);
+    };
+
+    int Repetition = static_cast<int>(std::ceil(Count));
+    if (Repetition > 1 && Reach(Repetition - 1))
+    {
+        Repetition--; // The division or logarithm was rounded up.
+    }
+
+    return Reach(Repetition) ? Repetition : -1; // A target narrower than a step may be skipped over.
+}
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 CEffect::CEffect(const CFactDefinition& Definition)
     : mDefinition(Definition) 
@@ -244,10 +302,12 @@ void CEffect::ApplyTo(CState& State) const
 {
     assert(&State.GetDefinition() == &mDefinition);
 
+    State.Expand(static_cast<int>(mTransforms.size()));
+
     for (int FactIndex = 0; FactIndex < mTransforms.size(); FactIndex++)
     {
         const CTransform& Transform = mTransforms[FactIndex];
-        SSegment& Property = State.GetProperty(FactIndex);
+        SSegment Property = State.GetProperty(FactIndex);
         if (Property.IsSet())
         {
             Transform.ApplyTo(Property);
@@ -256,6 +316,8 @@ void CEffect::ApplyTo(CState& State) const
             {
                 Fact->GetRange().Clamp(Property);
             }
+
+            State.SetProperty(FactIndex, Property);
         }
         else if (Transform.GetOperator() == EOperator::assignment)
         {
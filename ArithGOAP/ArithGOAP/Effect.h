@@ -47,6 +47,8 @@ namespace ArithGOAP
         void ApplyTo(SSegment& oSegment) const;
         // Solve clamp(x Operator Operand, Range) ∩ Target ≠ Ø for x.
         ETriStateCompletion Reserve(SSegment& oTarget, const SSegment& Range, CNumber Tolerance = CNumber::DefaultTolerance) const;
+        // Solve for the smallest k ≥ 0 such that Value transformed k times intersects Target, ignoring ranges. Return -1 if there is no such k.
+        int CountRepetitions(const SSegment& Value, const SSegment& Target, CNumber Tolerance = CNumber::DefaultTolerance) const;
 
     private:
         EOperator Operator = EOperator::nil;
@@ -1,9 +1,12 @@
 // Copyright 2024 Isaac Hsu
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 
 #include "Fact.h"
 #include "Notation.h"
+#include "SegmentLanes.h"
 #include "State.h"
 
 
@@ -18,12 +21,28 @@ CFact::CFact(CFactDefinition& Owner, int Index, const std::string& Name, EFactTy
     , mHeuristicFunctor(HeuristicFunctor)
 {}
 
+void CFact::SetRange(const SSegment& Value)
+{
+    mRange = Value;
+    mOwner.mRangeMinimums[mIndex] = Value.Minimum;
+    mOwner.mRangeMaximums[mIndex] = Value.Maximum;
+}
+
+EHeuristicKind CFact::GetHeuristicKind() const
+{
+    return mOwner.mHeuristicKinds[mIndex];
+}
+
+void CFact::SetHeuristicFunctor(const CHeuristicFunctor& Value)
+{
+    mHeuristicFunctor = Value;
+    mOwner.SetHeuristic(mIndex, Value ? EHeuristicKind::custom : CFactDefinition::GetDefaultHeuristicKind(mType), 1);
+}
+
 void CFact::SetGapWeight(CNumber GapWeight)
 {
-    if (CHeuristicFunctor HeuristicFunctor = mOwner.GenerateHeuristicFunctor(mType, GapWeight))
-    {
-        SetHeuristicFunctor(HeuristicFunctor);
-    }
+    mHeuristicFunctor = nullptr;
+    mOwner.SetHeuristic(mIndex, CFactDefinition::GetDefaultHeuristicKind(mType), GapWeight);
 }
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 CBooleanFact::CBooleanFact(CFactDefinition& Owner, int Index, const std::string& Name, const SSegment& Range, const CHeuristicFunctor& HeuristicFunctor)
@@ -121,7 +140,7 @@ std::string CFactDefinition::StringizeBoundedRanges() const
     return Return;
 }
 
-bool CFactDefinition::ValidateDefinitionParameters(const std::string& Name, EFactType Type, SSegment& Range, CHeuristicFunctor& HeuristicFunctor)
+bool CFactDefinition::ValidateDefinitionParameters(const std::string& Name, SSegment& Range)
 {
     if (mNameMap.find(Name) != mNameMap.end())
     {
@@ -138,11 +157,6 @@ bool CFactDefinition::ValidateDefinitionParameters(const std::string& Name, EFac
         return false; // Invalid range
     }
 
-    if (!HeuristicFunctor)
-    {
-        HeuristicFunctor = GenerateHeuristicFunctor(Type, 1); // Replace the unset distance functor with a default one.
-    }
-
     return true;
 }
 
@@ -158,8 +172,13 @@ CEnumerationFact* CFactDefinition::DefineEnumeration(const std::string& Name, co
 
 CNumericFact* CFactDefinition::DefineNumber(const std::string& Name, const SSegment& Range, CNumber GapWeight)
 {
-    CHeuristicFunctor HeuristicFunctor = GenerateHeuristicFunctor(EFactType::number, GapWeight);
-    return Define<CNumericFact>(Name, Range, HeuristicFunctor);
+    CNumericFact* Fact = Define<CNumericFact>(Name, Range);
+    if (Fact)
+    {
+        Fact->SetGapWeight(GapWeight);
+    }
+
+    return Fact;
 }
 
 CNumericFact* CFactDefinition::DefineNumber(const std::string& Name, CNumber GapWeight, const SSegment& Range)
@@ -177,37 +196,47 @@ CNumericFact* CFactDefinition::DefineNumber(const SVariableRange& Range, const C
     return Define<CNumericFact>(Range.Subject.Name, SSegment(Range.Minimum, Range.Maximum), HeuristicFunctor);
 }
 
-CHeuristicFunctor CFactDefinition::GenerateHeuristicFunctor(EFactType Type, CNumber GapWeight)
+void CFactDefinition::SetHeuristic(int Index, EHeuristicKind Kind, CNumber GapWeight)
 {
     assert(GapWeight > 0.f);
     assert(GapWeight.IsFinite());
 
-    switch (Type)
+    const BLaneMask LaneBit = BLaneMask(1) << (Index % LaneBlockSize);
+    BLaneMask& CustomLanes = mCustomHeuristicLanes[Index / LaneBlockSize];
+    CustomLanes = (Kind == EHeuristicKind::custom) ? (CustomLanes | LaneBit) : (CustomLanes & ~LaneBit);
+
+    mHeuristicKinds[Index] = Kind;
+    mGapWeights[Index] = (Kind == EHeuristicKind::gap) ? GapWeight.Get() : 0; // A zero weight makes the lane kernel fall back to the base relation cost.
+}
+
+CNumber CFactDefinition::GetHeuristicCost(int Index, const SSegment& Source, const SSegment& Target) const
+{
+    if (Source.IsUnset())
+    {
+        return mBaseRelationCost;
+    }
+
+    switch (mHeuristicKinds[Index])
     {
-    case EFactType::boolean:
-    case EFactType::enumeration:
-        return [&](const SSegment& Source, const SSegment& Target)
+    case EHeuristicKind::gap:
+        if (CNumber Gap = Source.GetGap(Target, mTolerance); Gap.IsFinite())
         {
-            return Source.HasIntersection(Target, mTolerance) ? 0_n : mBaseRelationCost;
-        };
-
-    case EFactType::number:
-        return [&, GapWeight](const SSegment& Source, const SSegment& Target)
-        { 
-            CNumber Gap = Source.GetGap(Target, mTolerance);
-            if (Gap.IsFinite())
-            {
-                return Gap * GapWeight;
-            }
-            else
-            {
-                return mBaseRelationCost;
-            }
-        };
+            return Gap * mGapWeights[Index];
+        }
+        else
+        {
+            return mBaseRelationCost;
+        }
+
+    case EHeuristicKind::mismatch:
+        return Source.HasIntersection(Target, mTolerance) ? 0_n : mBaseRelationCost;
+
+    case EHeuristicKind::custom:
+        return mFacts[Index]->GetHeuristicFunctor()(Source, Target);
     }
 
-    assert(!"Invalid fact type");
-    return CHeuristicFunctor();
+    assert(!"Invalid heuristic kind");
+    return mBaseRelationCost;
 }
 
 const CFact* CFactDefinition::GetFact(int Index) const
@@ -241,24 +270,57 @@ CNumber CFactDefinition::GetHeuristicCost(const CState& SourceState, const CStat
     assert(&DesiredState.GetDefinition() == this);
 
     CNumber Return = 0;
+    const int LaneCount = std::min({GetFactCount(), SourceState.GetPropertyCapacity(), DesiredState.GetPropertyCapacity()});
 
-    for (const auto& Fact : mFacts)
+    for (int Begin = 0; Begin < LaneCount; Begin += LaneBlockSize)
     {
-        const int FactIndex = Fact->GetIndex();
-        const SSegment& Target = DesiredState.GetProperty(FactIndex);
-        if (Target.IsUnset())
+        const int Count = std::min(LaneBlockSize, LaneCount - Begin);
+        const CNumber::BValue* SourceMinimums = SourceState.GetMinimums() + Begin;
+        const CNumber::BValue* SourceMaximums = SourceState.GetMaximums() + Begin;
+        const CNumber::BValue* TargetMinimums = DesiredState.GetMinimums() + Begin;
+        const CNumber::BValue* TargetMaximums = DesiredState.GetMaximums() + Begin;
+
+        const int Block = Begin / LaneBlockSize;
+        BLaneMask Targets = DesiredState.GetSetLanes(Block) & MaskLanes(Count);
+        if (Targets == 0)
         {
             continue;
         }
 
-        const SSegment& Source = SourceState.GetProperty(FactIndex);
-        if (Source.IsSet())
+        const BLaneMask Sources = SourceState.GetSetLanes(Block) & MaskLanes(Count);
+        assert(Targets == FindSetLanes(TargetMinimums, TargetMaximums, Count));
+        assert(Sources == FindSetLanes(SourceMinimums, SourceMaximums, Count));
+        const BLaneMask Customs = mCustomHeuristicLanes[Block];
+        CNumber::BValue Costs[LaneBlockSize];
+        CalcHeuristicLanes(Costs, SourceMinimums, SourceMaximums, TargetMinimums, TargetMaximums, mGapWeights.data() + Begin, Count, mBaseRelationCost, mTolerance);
+
+        // Accumulate the lane costs in fact order, so the sum is identical to the one of the scalar loop below.
+        for (; Targets; Targets &= Targets - 1)
         {
-            Return += Fact->GetHeuristicFunctor()(Source, Target);
+            const int Lane = std::countr_zero(Targets);
+            const BLaneMask LaneBit = BLaneMask(1) << Lane;
+
+            if (!(Sources & LaneBit))
+            {
+                Return += mBaseRelationCost;
+            }
+            else if (Customs & LaneBit)
+            {
+                const int FactIndex = Begin + Lane;
+                Return += mFacts[FactIndex]->GetHeuristicFunctor()(SourceState.GetProperty(FactIndex), DesiredState.GetProperty(FactIndex));
+            }
+            else
+            {
+                Return += Costs[Lane];
+            }
         }
-        else
+    }
+
+    for (int FactIndex : DesiredState.GetSetProperties())
+    {
+        if (FactIndex >= LaneCount && FactIndex < GetFactCount())
         {
-            Return += mBaseRelationCost;
+            Return += GetHeuristicCost(FactIndex, SourceState.GetProperty(FactIndex), DesiredState.GetProperty(FactIndex));
         }
     }
 
@@ -267,13 +329,18 @@ CNumber CFactDefinition::GetHeuristicCost(const CState& SourceState, const CStat
 
 void CFactDefinition::Clamp(CState& State) const
 {
-    for (const auto& Fact : mFacts)
+    const int FactCount = GetFactCount();
+    State.Expand(FactCount);
+
+    for (int Begin = 0; Begin < FactCount; Begin += LaneBlockSize)
     {
-        SSegment& Target = State.GetProperty(Fact->GetIndex());
-        if (Target.IsSet())
+        if (State.GetSetLanes(Begin / LaneBlockSize) == 0)
         {
-            Fact->GetRange().Clamp(Target);
+            continue; // Clamping leaves unset properties unchanged.
         }
+
+        const int Count = std::min(LaneBlockSize, FactCount - Begin);
+        ClampLanes(State.GetMinimums() + Begin, State.GetMaximums() + Begin, mRangeMinimums.data() + Begin, mRangeMaximums.data() + Begin, Count);
     }
 }
 ///////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "Segment.h"
+#include "SegmentLanes.h"
 
 
 namespace ArithGOAP
@@ -24,6 +25,13 @@ namespace ArithGOAP
         number,
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
+    enum class EHeuristicKind : unsigned char // How a fact estimates the cost from a source value to a desired value
+    {
+        gap,        // Gap between the segments times a gap weight, the default for numeric facts
+        mismatch,   // Base relation cost if the segments don't intersect, the default for Boolean and enumeration facts
+        custom,     // Result of a custom heuristic functor, which is called one by one instead of being evaluated in lanes
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
     class CFact // Base class for a world property definition. Fact values are stored in world states.
     {
         friend class CBooleanFact;
@@ -37,10 +45,11 @@ namespace ArithGOAP
         EFactType GetType() const { return mType; }
         int GetIndex() const { return mIndex; } // Index of this fact in the owner's fact list
         const SSegment& GetRange() const { return mRange; }
-        void SetRange(const SSegment& Value) { mRange = Value; }
-        const CHeuristicFunctor& GetHeuristicFunctor() const { return mHeuristicFunctor; }
-        void SetHeuristicFunctor(const CHeuristicFunctor& Value) { mHeuristicFunctor = Value; }
-        void SetGapWeight(CNumber GapWeight);
+        void SetRange(const SSegment& Value);
+        EHeuristicKind GetHeuristicKind() const;
+        const CHeuristicFunctor& GetHeuristicFunctor() const { return mHeuristicFunctor; } // Null unless the heuristic kind is custom
+        void SetHeuristicFunctor(const CHeuristicFunctor& Value); // Null restores the default heuristic kind.
+        void SetGapWeight(CNumber GapWeight); // Restore the default heuristic kind with a given gap weight, which only matters to numeric facts.
         const CFactDefinition& GetOwner() const { return mOwner; }
 
     private:
@@ -134,12 +143,21 @@ namespace ArithGOAP
     private:
         template <typename TFact>
         TFact* Define(const std::string& Name, const SSegment& Range = SSegment::Boundless, const CHeuristicFunctor& HeuristicFunctor = CHeuristicFunctor());
-        bool ValidateDefinitionParameters(const std::string& Name, EFactType Type, SSegment& Range, CHeuristicFunctor& HeuristicFunctor);
-        CHeuristicFunctor GenerateHeuristicFunctor(EFactType Type, CNumber GapWeight);
+        bool ValidateDefinitionParameters(const std::string& Name, SSegment& Range);
+        // Update the heuristic tables of a given fact.
+        void SetHeuristic(int Index, EHeuristicKind Kind, CNumber GapWeight);
+        // Calculate the heuristic cost of a single fact. Same as a lane of GetHeuristicCost.
+        CNumber GetHeuristicCost(int Index, const SSegment& Source, const SSegment& Target) const;
+        static EHeuristicKind GetDefaultHeuristicKind(EFactType Type) { return Type == EFactType::number ? EHeuristicKind::gap : EHeuristicKind::mismatch; }
 
     private:
         std::vector<std::unique_ptr<CFact>> mFacts; // Allocate the facts on the heap to ensure that existing facts are not invalidated by adding new on.
         std::unordered_map<std::string, int> mNameMap; // Mapping of fact names to fact indexes
+        std::vector<CNumber::BValue> mRangeMinimums; // Lower bounds of the fact ranges, mirrored for the segment lane kernels
+        std::vector<CNumber::BValue> mRangeMaximums; // Upper bounds of the fact ranges, mirrored for the segment lane kernels
+        std::vector<EHeuristicKind> mHeuristicKinds; // Heuristic kinds of the facts
+        std::vector<CNumber::BValue> mGapWeights; // Gap weights of the gap heuristics, or 0 for the others, mirrored for the segment lane kernels
+        std::vector<BLaneMask> mCustomHeuristicLanes; // Bitmasks of the facts with custom heuristics, one per block of LaneBlockSize facts
         CNumber mBaseRelationCost = 1; // Base cost for a mismatched comparison
         CNumber mTolerance = CNumber::DefaultTolerance; // Absolute tolerance used for floating-point comparison
     };
@@ -148,15 +166,24 @@ namespace ArithGOAP
     TFact* CFactDefinition::Define(const std::string& Name, const SSegment& Range, const CHeuristicFunctor& HeuristicFunctor)
     {
         SSegment ValidRange = Range;
-        CHeuristicFunctor ValidHeuristicFunctor = HeuristicFunctor;
-        if (!ValidateDefinitionParameters(Name, TFact::StaticFactType, ValidRange, ValidHeuristicFunctor))
+        if (!ValidateDefinitionParameters(Name, ValidRange))
         {
             return nullptr;
         }
 
-        TFact* Fact = new TFact(*this, static_cast<int>(mFacts.size()), Name, ValidRange, ValidHeuristicFunctor);
+        TFact* Fact = new TFact(*this, static_cast<int>(mFacts.size()), Name, ValidRange, HeuristicFunctor);
         mFacts.emplace_back(Fact);
         mNameMap.emplace(Name, Fact->GetIndex());
+        mRangeMinimums.push_back(ValidRange.Minimum);
+        mRangeMaximums.push_back(ValidRange.Maximum);
+        mHeuristicKinds.push_back(EHeuristicKind::custom);
+        mGapWeights.push_back(0);
+        if (Fact->GetIndex() % LaneBlockSize == 0)
+        {
+            mCustomHeuristicLanes.push_back(0);
+        }
+
+        SetHeuristic(Fact->GetIndex(), HeuristicFunctor ? EHeuristicKind::custom : GetDefaultHeuristicKind(TFact::StaticFactType), 1);
         return Fact;
     }
 }
@@ -1,31 +1,43 @@
 // Copyright 2024 Isaac Hsu
 
-#include <iostream>
-#include <map>
+#include <algorithm>
+#include <memory>
 #include <typeinfo>
 
 #include "Action.h"
 #include "Fact.h"
 #include "ForwardPlanner.h"
+#include "Observer.h"
+#include "PlannerStats.h"
+#include "Workspace.h"
 
 
 using namespace ArithGOAP;
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool CForwardPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
 {
-    std::cout << typeid(*this).name() << std::endl;
-    if (StartingState.GetDefinition().HasAnyRange())
+    CPlannerWorkspace Workspace;
+    return Plan(oSteps, StartingState, GoalState, Actions, MaxDepth, Workspace);
+}
+
+bool CForwardPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace)
+{
+    if (mObserver)
+    {
+        mObserver->OnStart(typeid(*this).name(), StartingState, GoalState);
+    }
+
+    if (mStats)
     {
-        std::cout << "RANGE: {" << StartingState.GetDefinition().StringizeBoundedRanges() << "}" << std::endl;
+        mStats->Reset();
     }
-    std::cout << "START: {" << StartingState.ToString() << "}" << std::endl;
-    std::cout << "GOAL : {" << GoalState.ToString() << "}" << std::endl;
 
     int Step = 0;
     oSteps.clear();
     MaxDepth = std::max(MaxDepth, 0);
 
-    std::vector<SNode> Nodes;
+    Workspace.Clear();
+    std::vector<SNode>& Nodes = Workspace.GetNodes();
     Nodes.reserve(Actions.size() * MaxDepth);
 
     SNode& RootNode = Nodes.emplace_back();
@@ -33,24 +45,41 @@ bool CForwardPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& St
     RootNode.BaseHeuristicCost = StartingState.GetBaseHeuristicCost(GoalState);
     RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalState);
 
-    std::multimap<float, int> OpenMap; // The open set in A*
-    OpenMap.emplace(RootNode.GetTotalCost(), 0);
+    COpenList& OpenList = Workspace.GetOpenList(); // The open set in A*
+    OpenList.Push(RootNode.GetTotalCost(), 0);
 
-    while (!OpenMap.empty())
+    SForwardScratch& Scratch = Workspace.GetScratch<SForwardScratch>();
+    if (mMaxRepetition > 1)
     {
-        auto itCurr = OpenMap.begin();
-        const int CurrIndex = itCurr->second;
+        CollectRepetitionTargets(Scratch.RepetitionTargets, GoalState, Actions);
+    }
+
+    while (!OpenList.IsEmpty())
+    {
+        const int CurrIndex = OpenList.GetTop();
         SNode& CurrNode = Nodes[CurrIndex];
 
-        std::cout << "#" << ++Step << " #Nodes=" << Nodes.size() << " |" << StringizePath(Nodes, CurrIndex) << "| " << CurrNode.ToString() << std::endl;
+        if (mStats)
+        {
+            mStats->AddExpansion(OpenList.GetSize());
+        }
 
-        if (!GoalState.IsContradictory(*CurrNode.ConstState))
+        if (mObserver)
+        {
+            mObserver->OnExpand(++Step, static_cast<int>(Nodes.size()), [&] { return StringizePath(Nodes, CurrIndex); }, [&] { return CurrNode.ToString(); });
+        }
+
+        CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime);
+        const bool Reached = !GoalState.IsContradictory(*CurrNode.ConstState);
+        GoalTestTimer.Stop();
+
+        if (Reached)
         {
             BuildPlan(oSteps, Nodes, CurrIndex);
             return true;
         }
 
-        OpenMap.erase(itCurr);
+        OpenList.Pop();
 
         if (CurrNode.Depth >= MaxDepth)
         {
@@ -59,16 +88,24 @@ bool CForwardPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& St
 
         for (const CAction* Action : Actions)
         {
-            Explore(OpenMap, Nodes, CurrIndex, *Action, GoalState);
+            Explore(OpenList, Nodes, Workspace.GetStateArena(), CurrIndex, *Action, GoalState);
+        }
+
+        if (mMaxRepetition > 1)
+        {
+            for (const CAction* Action : Actions)
+            {
+                ExploreRepetitions(OpenList, Nodes, Workspace.GetStateArena(), Scratch, CurrIndex, *Action, GoalState);
+            }
         }
     }
 
     return false;
 }
 
-void CForwardPlanner::Explore(std::multimap<float, int>& oOpenMap, std::vector<SNode>& Nodes, int NodeIndex, const CAction& Action, const CState& GoalState)
+void CForwardPlanner::Explore(COpenList& oOpenList, std::vector<SNode>& Nodes, CStateArena& oStateArena, int NodeIndex, const CAction& Action, const CState& GoalState)
 {
-    if (!Action.CheckPrecondition(*Nodes[NodeIndex].ConstState))
+    if (!CheckPrecondition(Action, *Nodes[NodeIndex].ConstState))
     {
         return;
     }
@@ -77,18 +114,150 @@ void CForwardPlanner::Explore(std::multimap<float, int>& oOpenMap, std::vector<S
     SNode& ChildNode = Nodes.emplace_back();
     SNode& CurrNode = Nodes[NodeIndex];
     ChildNode.Action = &Action;
-    ChildNode.MutableState = CurrNode.ConstState->Clone();
+    CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+    ChildNode.MutableState = CurrNode.ConstState->CloneInto(oStateArena);
     Action.GetEffect().ApplyTo(*ChildNode.MutableState);
     Action.Affect(*ChildNode.MutableState);
-    ChildNode.ConstState = ChildNode.MutableState.get();
+    CloneTimer.Stop();
+    ChildNode.ConstState = ChildNode.MutableState;
     ChildNode.Parent = NodeIndex;
     ChildNode.Depth = CurrNode.Depth + 1;
     ChildNode.PreviousCost = CurrNode.GetActualCost();
     ChildNode.CurrentCost = Action.GetCost(*CurrNode.ConstState, *ChildNode.ConstState);
+
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
     ChildNode.BaseHeuristicCost = ChildNode.ConstState->GetBaseHeuristicCost(GoalState);
     ChildNode.ExtraHeuristicCost = ChildNode.ConstState->GetExtraHeuristicCost(GoalState);
+    HeuristicTimer.Stop();
     float TotalCost = ChildNode.GetTotalCost();
-    oOpenMap.emplace(TotalCost, ChildIndex);
+    oOpenList.Push(TotalCost, ChildIndex);
+}
+
+void CForwardPlanner::ExploreRepetitions(COpenList& oOpenList, std::vector<SNode>& Nodes, CStateArena& oStateArena, SForwardScratch& Scratch, int NodeIndex, const CAction& Action, const CState& GoalState)
+{
+    if (Nodes[NodeIndex].Action == &Action)
+    {
+        return; // Repeating the action from the parent node reaches the same targets with fewer nodes.
+    }
+
+    const CState& State = *Nodes[NodeIndex].ConstState;
+    const CEffect& Effect = Action.GetEffect();
+    const CNumber Tolerance = State.GetDefinition().GetTolerance();
+    std::vector<int>& Repetitions = Scratch.Repetitions;
+    Repetitions.clear();
+
+    for (int FactIndex = 0; FactIndex < Effect.GetTransformCapacity(); FactIndex++)
+    {
+        const CTransform& Transform = Effect.GetTransform(FactIndex);
+        if (Transform.GetOperator() != EOperator::addition && Transform.GetOperator() != EOperator::multiplication)
+        {
+            continue;
+        }
+
+        const SSegment Value = State.GetProperty(FactIndex);
+        auto Range = Scratch.RepetitionTargets.equal_range(FactIndex);
+        for (auto it = Range.first; it != Range.second; ++it)
+        {
+            const int Repetition = Transform.CountRepetitions(Value, it->second, Tolerance);
+            if (Repetition > 1 && Repetition <= mMaxRepetition && std::find(Repetitions.begin(), Repetitions.end(), Repetition) == Repetitions.end())
+            {
+                Repetitions.push_back(Repetition); // A single repetition is explored as a normal node.
+            }
+        }
+    }
+
+    for (int Repetition : Repetitions)
+    {
+        ExploreRepetition(oOpenList, Nodes, oStateArena, Scratch, NodeIndex, Action, Repetition, GoalState);
+    }
+}
+
+void CForwardPlanner::ExploreRepetition(COpenList& oOpenList, std::vector<SNode>& Nodes, CStateArena& oStateArena, SForwardScratch& Scratch, int NodeIndex, const CAction& Action, int Repetition, const CState& GoalState)
+{
+    CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+    CState* State = Nodes[NodeIndex].ConstState->CloneInto(oStateArena);
+    CloneTimer.Stop();
+
+    // Take the steps one by one, since the preconditions, ranges and custom costs may change along the way.
+    float Cost = 0.f;
+    for (int Step = 0; Step < Repetition; Step++)
+    {
+        if (!CheckPrecondition(Action, *State))
+        {
+            oStateArena.DestroyLast();
+            return;
+        }
+
+        State->CopyTo(Scratch.PreviousState);
+        Action.GetEffect().ApplyTo(*State);
+        Action.Affect(*State);
+        Cost += Action.GetCost(*Scratch.PreviousState, *State);
+    }
+
+    int ChildIndex = static_cast<int>(Nodes.size());
+    SNode& ChildNode = Nodes.emplace_back();
+    SNode& CurrNode = Nodes[NodeIndex];
+    ChildNode.Action = &Action;
+    ChildNode.Repetition = Repetition;
+    ChildNode.MutableState = State;
+    ChildNode.ConstState = ChildNode.MutableState;
+    ChildNode.Parent = NodeIndex;
+    ChildNode.Depth = CurrNode.Depth + 1;
+    ChildNode.PreviousCost = CurrNode.GetActualCost();
+    ChildNode.CurrentCost = Cost;
+
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
+    ChildNode.BaseHeuristicCost = ChildNode.ConstState->GetBaseHeuristicCost(GoalState);
+    ChildNode.ExtraHeuristicCost = ChildNode.ConstState->GetExtraHeuristicCost(GoalState);
+    HeuristicTimer.Stop();
+    float TotalCost = ChildNode.GetTotalCost();
+    oOpenList.Push(TotalCost, ChildIndex);
+}
+
+void CForwardPlanner::CollectRepetitionTargets(CRepetitionTargetMap& oTargets, const CState& GoalState, const std::vector<const CAction*>& Actions)
+{
+    auto Collect = [&](const CState& State)
+    {
+        for (int FactIndex = 0; FactIndex < State.GetPropertyCapacity(); FactIndex++)
+        {
+            const SSegment Target = State.GetProperty(FactIndex);
+            if (Target.IsSet())
+            {
+                oTargets.emplace(FactIndex, Target);
+            }
+        }
+    };
+
+    Collect(GoalState);
+
+    for (const CAction* Action : Actions)
+    {
+        Collect(Action->GetPrecondition());
+    }
+}
+
+bool CForwardPlanner::CheckPrecondition(const CAction& Action, const CState& State)
+{
+    CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
+    const bool Applicable = Action.CheckPrecondition(State);
+    PreconditionTimer.Stop();
+
+    if (mStats)
+    {
+        mStats->AddCheck(Action, Applicable);
+    }
+
+    return Applicable;
 }
 
 void CForwardPlanner::BuildPlan(std::vector<const CAction*>& oSteps, const std::vector<SNode>& Nodes, int NodeIndex)
@@ -97,7 +266,7 @@ void CForwardPlanner::BuildPlan(std::vector<const CAction*>& oSteps, const std::
     {
         if (Nodes[NodeIndex].Action)
         {
-            oSteps.push_back(Nodes[NodeIndex].Action);
+            oSteps.insert(oSteps.end(), Nodes[NodeIndex].Repetition, Nodes[NodeIndex].Action);
         }
 
         NodeIndex = Nodes[NodeIndex].Parent;
@@ -113,7 +282,7 @@ std::string CForwardPlanner::StringizePath(const std::vector<SNode>& Nodes, int
     {
         if (Nodes[NodeIndex].Action)
         {
-            ActionNames.push_back(Nodes[NodeIndex].Action->GetName());
+            ActionNames.push_back(Nodes[NodeIndex].StringizeAction());
         }
 
         NodeIndex = Nodes[NodeIndex].Parent;
@@ -2,29 +2,70 @@
 
 #pragma once
 
-#include <map>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "Node.h"
+#include "OpenList.h"
+#include "Segment.h"
+#include "Workspace.h"
 
 
 namespace ArithGOAP
 {
     class CAction;
+    class CSearchObserver;
     class CState;
+    struct SPlannerStats;
     ///////////////////////////////////////////////////////////////////////////////////////////////
     class CForwardPlanner // Forward arithmetic GOAP
     {
+    public:
+        using CRepetitionTargetMap = std::unordered_multimap<int, SSegment>; // Mapping of facts to the segments that repetition macro nodes try to reach
+
     public:
         bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth);
+        // Same as above but with the buffers of a given workspace, which keeps their capacity for later calls.
+        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace);
+        // Attach an observer to trace the search, or detach it with null.
+        void SetObserver(CSearchObserver* Value) { mObserver = Value; }
+        // Collect the statistics of each search into a given instance, or stop collecting them with null.
+        void SetStats(SPlannerStats* Value) { mStats = Value; }
+        // Let a search node repeat an additive or multiplicative action up to a given number of times to reach a goal or precondition value at once.
+        // The number of repetitions is solved in closed form, so gathering resources takes one expansion instead of one per step. 1 disables it.
+        // MaxDepth then limits the nodes on a path rather than the actions, since a repetition node takes one depth for all its steps.
+        void SetMaxRepetition(int Value) { mMaxRepetition = Value; }
 
     protected:
+        struct SForwardScratch : CPlannerWorkspace::SScratch // Buffers of forward searches
+        {
+            CRepetitionTargetMap RepetitionTargets; // Mapping of facts to the segments that repetition macro nodes try to reach
+            std::vector<int> Repetitions;           // Numbers of repetitions to explore for an action from a node
+            std::unique_ptr<CState> PreviousState;  // Copy of the state before each step of a repetition, kept for its storage
+
+            void Clear() override { RepetitionTargets.clear(); Repetitions.clear(); }
+        };
+
+        // Check if an action can be taken in a state, and record the check in the statistics if any.
+        bool CheckPrecondition(const CAction& Action, const CState& State);
         // Create a search node for a given action from a given node if feasible.
-        void Explore(std::multimap<float, int>& oOpenMap, std::vector<SNode>& Nodes, int NodeIndex, const CAction& Action, const CState& GoalState);
+        void Explore(COpenList& oOpenList, std::vector<SNode>& Nodes, CStateArena& oStateArena, int NodeIndex, const CAction& Action, const CState& GoalState);
+        // Create search nodes repeating a given action from a given node as many times as needed to reach each target, if feasible.
+        void ExploreRepetitions(COpenList& oOpenList, std::vector<SNode>& Nodes, CStateArena& oStateArena, SForwardScratch& Scratch, int NodeIndex, const CAction& Action, const CState& GoalState);
+        // Create a search node repeating a given action from a given node a given number of times if feasible.
+        void ExploreRepetition(COpenList& oOpenList, std::vector<SNode>& Nodes, CStateArena& oStateArena, SForwardScratch& Scratch, int NodeIndex, const CAction& Action, int Repetition, const CState& GoalState);
+        // Collect the goal values and the precondition values of the actions as targets of repetition.
+        static void CollectRepetitionTargets(CRepetitionTargetMap& oTargets, const CState& GoalState, const std::vector<const CAction*>& Actions);
         // List the actions on the path to a given node.
         void BuildPlan(std::vector<const CAction*>& oSteps, const std::vector<SNode>& Nodes, int NodeIndex);
         // Return concatenated names of the actions on the path to a given node.
         std::string StringizePath(const std::vector<SNode>& Nodes, int NodeIndex) const;
+
+    protected:
+        CSearchObserver* mObserver = nullptr; // Optional observer tracing the search
+        SPlannerStats* mStats = nullptr; // Optional statistics of the last search
+        int mMaxRepetition = 1; // Maximum number of times a search node repeats an action
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
 }
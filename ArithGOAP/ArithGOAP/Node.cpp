@@ -2,6 +2,7 @@
 
 #include <sstream>
 
+#include "Action.h"
 #include "Node.h"
 #include "State.h"
 
@@ -25,4 +26,19 @@ std::string SNode::ToString() const
     Stream << " Depth=" << Depth << " {" << (ConstState ? ConstState->ToString() : "") << "}}";
     return Stream.str();
 }
+
+std::string SNode::StringizeAction() const
+{
+    if (!Action)
+    {
+        return "";
+    }
+
+    if (Repetition > 1)
+    {
+        return Action->GetName() + "*" + std::to_string(Repetition);
+    }
+
+    return Action->GetName();
+}
 ///////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
@@ -2,7 +2,6 @@
 
 #pragma once
 
-#include <memory>
 #include <string>
 
 
@@ -16,11 +15,13 @@ namespace ArithGOAP
         // Action taken from the parent node to this node
         const CAction* Action = nullptr;
         // ConstState and MutableState point to the same state except that the mutable counterparts of const-only states (the starting and goal states) are null.
+        // Mutable states are owned by the state arena of the search.
         const CState* ConstState = nullptr;
-        std::unique_ptr<CState> MutableState;
+        CState* MutableState = nullptr;
 
         int Parent = -1;                // Index of the parent node
         int Depth = 0;                  // Depth of this node in the search tree
+        int Repetition = 1;             // Number of times the action is repeated from the parent node to this node
         float PreviousCost = 0.f;       // Cost of the previous actions
         float CurrentCost = 0.f;        // Cost of the current action
         float BaseHeuristicCost = 0.f;  // Heuristic cost based on property comparisons
@@ -32,6 +33,7 @@ namespace ArithGOAP
         float GetTotalCost() const { return GetActualCost() + GetHeuristicCost(); }
 
         std::string ToString() const; // For debugging
+        std::string StringizeAction() const; // Name of the action, followed by the number of repetitions if any, e.g. "Work*10"
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
 }
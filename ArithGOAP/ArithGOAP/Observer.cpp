@@ -0,0 +1,31 @@
+// Copyright 2026 Isaac Hsu
+
+#include <iostream>
+
+#include "Fact.h"
+#include "Observer.h"
+#include "State.h"
+
+
+using namespace ArithGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+CConsoleObserver::CConsoleObserver()
+    : mStream(std::cout)
+{}
+
+void CConsoleObserver::OnStart(const char* PlannerName, const CState& StartingState, const CState& GoalState)
+{
+    mStream << PlannerName << std::endl;
+    if (StartingState.GetDefinition().HasAnyRange())
+    {
+        mStream << "RANGE: {" << StartingState.GetDefinition().StringizeBoundedRanges() << "}" << std::endl;
+    }
+    mStream << "START: {" << StartingState.ToString() << "}" << std::endl;
+    mStream << "GOAL : {" << GoalState.ToString() << "}" << std::endl;
+}
+
+void CConsoleObserver::OnExpand(int Step, int NodeCount, const CTextGetter& GetPath, const CTextGetter& GetNode)
+{
+    mStream << "#" << Step << " #Nodes=" << NodeCount << " |" << GetPath() << "| " << GetNode() << std::endl;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
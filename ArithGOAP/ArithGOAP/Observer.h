@@ -0,0 +1,40 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+
+namespace ArithGOAP
+{
+    class CState;
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    class CSearchObserver // Callback interface to trace the search of planners, which skip all tracing work without an observer
+    {
+    public:
+        using CTextGetter = std::function<std::string()>; // Builds debugging text only when called
+
+        virtual ~CSearchObserver() {}
+
+        // Called when a planner starts.
+        virtual void OnStart(const char* PlannerName, const CState& StartingState, const CState& GoalState) {}
+        // Called when a node is taken from the open set. The texts of the path and the node are built by the getters on demand.
+        virtual void OnExpand(int Step, int NodeCount, const CTextGetter& GetPath, const CTextGetter& GetNode) {}
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    class CConsoleObserver : public CSearchObserver // Observer printing the search to a stream
+    {
+    public:
+        CConsoleObserver();
+        explicit CConsoleObserver(std::ostream& Stream) : mStream(Stream) {}
+
+        void OnStart(const char* PlannerName, const CState& StartingState, const CState& GoalState) override;
+        void OnExpand(int Step, int NodeCount, const CTextGetter& GetPath, const CTextGetter& GetNode) override;
+
+    private:
+        std::ostream& mStream;
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,45 @@
+// Copyright 2026 Isaac Hsu
+
+#include <sstream>
+
+#include "Action.h"
+#include "PlannerStats.h"
+
+
+using namespace ArithGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void SPlannerStats::Reset()
+{
+    *this = SPlannerStats();
+}
+
+void SPlannerStats::AddCheck(const CAction& Action, bool Applicable)
+{
+    if (Applicable)
+    {
+        ApplicableCounts[&Action]++;
+    }
+    else
+    {
+        PrunedCount++;
+    }
+}
+
+std::string SPlannerStats::ToString() const
+{
+    auto ToMicroseconds = [](CDuration Duration) { return std::chrono::duration_cast<std::chrono::microseconds>(Duration).count(); };
+
+    std::stringstream Stream;
+    Stream << "Expanded=" << ExpandedCount << " Generated=" << GeneratedCount << " Pruned=" << PrunedCount << " Duplicates=" << DuplicateCount << " Dominated=" << DominatedCount;
+    Stream << " MaxOpen=" << MaxOpenCount << " MaxDepth=" << MaxDepth;
+    Stream << " Heuristic=" << ToMicroseconds(HeuristicTime) << "us Precondition=" << ToMicroseconds(PreconditionTime) << "us";
+    Stream << " Clone=" << ToMicroseconds(CloneTime) << "us GoalTest=" << ToMicroseconds(GoalTestTime) << "us";
+
+    for (const auto& [Action, Count] : ApplicableCounts)
+    {
+        Stream << " " << Action->GetName() << "=" << Count;
+    }
+
+    return Stream.str();
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1,10 +1,14 @@
 // Copyright 2024 Isaac Hsu
 
-#include <iostream>
+#include <algorithm>
+#include <memory>
 #include <typeinfo>
 
 #include "Action.h"
 #include "Fact.h"
+#include "Observer.h"
+#include "PlannerStats.h"
+#include "Workspace.h"
 #include "RegressionPlanner.h"
 
 
@@ -12,19 +16,28 @@ using namespace ArithGOAP;
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool CRegressionPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
 {
-    std::cout << typeid(*this).name() << std::endl;
-    if (StartingState.GetDefinition().HasAnyRange())
+    CPlannerWorkspace Workspace;
+    return Plan(oSteps, StartingState, GoalState, Actions, MaxDepth, Workspace);
+}
+
+bool CRegressionPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace)
+{
+    if (mObserver)
     {
-        std::cout << "RANGE: {" << StartingState.GetDefinition().StringizeBoundedRanges() << "}" << std::endl;
+        mObserver->OnStart(typeid(*this).name(), StartingState, GoalState);
+    }
+
+    if (mStats)
+    {
+        mStats->Reset();
     }
-    std::cout << "START: {" << StartingState.ToString() << "}" << std::endl;
-    std::cout << "GOAL : {" << GoalState.ToString() << "}" << std::endl;
 
     int Step = 0;
     oSteps.clear();
     MaxDepth = std::max(MaxDepth, 0);
 
-    std::vector<SNode> Nodes;
+    Workspace.Clear();
+    std::vector<SNode>& Nodes = Workspace.GetNodes();
     Nodes.reserve(Actions.size() * MaxDepth);
 
     SNode& RootNode = Nodes.emplace_back();
@@ -32,46 +45,89 @@ bool CRegressionPlanner::Plan(std::vector<const CAction*>& oSteps, const CState&
     RootNode.BaseHeuristicCost = StartingState.GetBaseHeuristicCost(GoalState);
     RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalState);
 
-    std::multimap<float, int> OpenMap; // The open set in A*
-    OpenMap.emplace(RootNode.GetTotalCost(), 0);
+    COpenList& OpenList = Workspace.GetOpenList(); // The open set in A*
+    OpenList.Push(RootNode.GetTotalCost(), 0);
+
+    SRegressionScratch& Scratch = Workspace.GetScratch<SRegressionScratch>();
+    CSubsumptionIndex& ExpandedStates = Scratch.ExpandedStates;
 
-    while (!OpenMap.empty())
+    while (!OpenList.IsEmpty())
     {
-        auto itCurr = OpenMap.begin();
-        const int CurrIndex = itCurr->second;
+        const int CurrIndex = OpenList.GetTop();
         SNode& CurrNode = Nodes[CurrIndex];
 
+        if (mStats)
+        {
+            mStats->AddExpansion(OpenList.GetSize());
+        }
+
+        CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime);
         bool Reached = !CurrNode.ConstState->IsContradictory(StartingState);
-        std::cout << "#" << ++Step << " #Nodes=" << Nodes.size();
-        std::cout << " |" << ((Reached || CurrIndex == 0) ? "" : "? ") << StringizePath(Nodes, CurrIndex) << "| ";
-        std::cout << CurrNode.ToString() << std::endl;
+        GoalTestTimer.Stop();
+        if (mObserver)
+        {
+            auto GetPath = [&] { return ((Reached || CurrIndex == 0) ? "" : "? ") + StringizePath(Nodes, CurrIndex); };
+            mObserver->OnExpand(++Step, static_cast<int>(Nodes.size()), GetPath, [&] { return CurrNode.ToString(); });
+        }
+
         if (Reached)
         {
             BuildPlan(oSteps, Nodes, CurrIndex);
             return true;
         }
 
-        OpenMap.erase(itCurr);
+        OpenList.Pop();
 
         if (CurrNode.Depth >= MaxDepth)
         {
             continue;
         }
 
+        if (mSubsumptionPruning)
+        {
+            if (CheckDomination(ExpandedStates, CurrNode))
+            {
+                continue; // A node dominating this one has been expanded since this one was generated.
+            }
+
+            ExpandedStates.Add(*CurrNode.ConstState, CurrNode.GetActualCost(), CurrNode.Depth);
+        }
+
         for (const CAction* Action : Actions)
         {
-            Explore(OpenMap, Nodes, CurrIndex, *Action, StartingState);
+            Explore(OpenList, Nodes, Workspace.GetStateArena(), ExpandedStates, CurrIndex, *Action, StartingState);
+        }
+
+        if (mMaxRepetition > 1)
+        {
+            for (const CAction* Action : Actions)
+            {
+                ExploreRepetitions(OpenList, Nodes, Workspace.GetStateArena(), Scratch, CurrIndex, *Action, StartingState);
+            }
         }
     }
 
     return false;
 }
 
-void CRegressionPlanner::Explore(std::multimap<float, int>& oOpenMap, std::vector<SNode>& Nodes, int NodeIndex, const CAction& Action, const CState& StartingState)
+void CRegressionPlanner::Explore(COpenList& oOpenList, std::vector<SNode>& Nodes, CStateArena& oStateArena, const CSubsumptionIndex& ExpandedStates, int NodeIndex, const CAction& Action, const CState& StartingState)
 {
-    std::unique_ptr<CState> Condition = Action.CheckPostcondition(*Nodes[NodeIndex].ConstState);
-    if (!Condition)
+    CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+    CState* Condition = Nodes[NodeIndex].ConstState->CloneInto(oStateArena);
+    CloneTimer.Stop();
+
+    CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime); // Regression both checks the action and applies its inverse effects.
+    const bool Applicable = Action.Regress(*Condition);
+    PreconditionTimer.Stop();
+
+    if (mStats)
+    {
+        mStats->AddCheck(Action, Applicable);
+    }
+
+    if (!Applicable)
     {
+        oStateArena.DestroyLast();
         return;
     }
 
@@ -79,17 +135,145 @@ void CRegressionPlanner::Explore(std::multimap<float, int>& oOpenMap, std::vecto
     SNode& ChildNode = Nodes.emplace_back();
     SNode& CurrNode = Nodes[NodeIndex];
     ChildNode.Action = &Action;
-    ChildNode.MutableState = std::move(Condition);
+    ChildNode.MutableState = Condition;
     Action.Affect(*ChildNode.MutableState);
-    ChildNode.ConstState = ChildNode.MutableState.get();
+    ChildNode.ConstState = ChildNode.MutableState;
     ChildNode.Parent = NodeIndex;
     ChildNode.Depth = CurrNode.Depth + 1;
     ChildNode.PreviousCost = CurrNode.GetActualCost();
     ChildNode.CurrentCost = Action.GetCost(*CurrNode.ConstState, *ChildNode.ConstState);
+
+    if (CheckDomination(ExpandedStates, ChildNode))
+    {
+        Nodes.pop_back();
+        oStateArena.DestroyLast();
+        return;
+    }
+
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
     ChildNode.BaseHeuristicCost = StartingState.GetBaseHeuristicCost(*ChildNode.ConstState);
     ChildNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(*ChildNode.ConstState);
+    HeuristicTimer.Stop();
     float TotalCost = ChildNode.GetTotalCost();
-    oOpenMap.emplace(TotalCost, ChildIndex);
+    oOpenList.Push(TotalCost, ChildIndex);
+}
+
+void CRegressionPlanner::ExploreRepetitions(COpenList& oOpenList, std::vector<SNode>& Nodes, CStateArena& oStateArena, SRegressionScratch& Scratch, int NodeIndex, const CAction& Action, const CState& StartingState)
+{
+    if (Nodes[NodeIndex].Action == &Action)
+    {
+        return; // Repeating the action from the parent node reaches the same values with fewer nodes.
+    }
+
+    const CState& Condition = *Nodes[NodeIndex].ConstState;
+    const CEffect& Effect = Action.GetEffect();
+    const CNumber Tolerance = Condition.GetDefinition().GetTolerance();
+    std::vector<int>& Repetitions = Scratch.Repetitions;
+    Repetitions.clear();
+
+    for (int FactIndex : Condition.GetSetProperties())
+    {
+        const CTransform& Transform = Effect.GetTransform(FactIndex);
+        if (Transform.GetOperator() != EOperator::addition && Transform.GetOperator() != EOperator::multiplication)
+        {
+            continue;
+        }
+
+        // Regressing the desired value k times reaches the starting value exactly when applying the action k times to the starting value reaches the desired one.
+        const int Repetition = Transform.CountRepetitions(StartingState.GetProperty(FactIndex), Condition.GetProperty(FactIndex), Tolerance);
+        if (Repetition > 1 && Repetition <= mMaxRepetition && std::find(Repetitions.begin(), Repetitions.end(), Repetition) == Repetitions.end())
+        {
+            Repetitions.push_back(Repetition); // A single repetition is explored as a normal node.
+        }
+    }
+
+    for (int Repetition : Repetitions)
+    {
+        ExploreRepetition(oOpenList, Nodes, oStateArena, Scratch, NodeIndex, Action, Repetition, StartingState);
+    }
+}
+
+void CRegressionPlanner::ExploreRepetition(COpenList& oOpenList, std::vector<SNode>& Nodes, CStateArena& oStateArena, SRegressionScratch& Scratch, int NodeIndex, const CAction& Action, int Repetition, const CState& StartingState)
+{
+    CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+    CState* Condition = Nodes[NodeIndex].ConstState->CloneInto(oStateArena);
+    CloneTimer.Stop();
+
+    // Take the steps one by one, since the preconditions, ranges and custom costs may change along the way.
+    float Cost = 0.f;
+    for (int Step = 0; Step < Repetition; Step++)
+    {
+        Condition->CopyTo(Scratch.NextCondition);
+
+        CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
+        const bool Applicable = Action.Regress(*Condition);
+        PreconditionTimer.Stop();
+
+        if (mStats)
+        {
+            mStats->AddCheck(Action, Applicable);
+        }
+
+        if (!Applicable)
+        {
+            oStateArena.DestroyLast();
+            return;
+        }
+
+        Action.Affect(*Condition);
+        Cost += Action.GetCost(*Scratch.NextCondition, *Condition);
+    }
+
+    int ChildIndex = static_cast<int>(Nodes.size());
+    SNode& ChildNode = Nodes.emplace_back();
+    SNode& CurrNode = Nodes[NodeIndex];
+    ChildNode.Action = &Action;
+    ChildNode.Repetition = Repetition;
+    ChildNode.MutableState = Condition;
+    ChildNode.ConstState = ChildNode.MutableState;
+    ChildNode.Parent = NodeIndex;
+    ChildNode.Depth = CurrNode.Depth + 1;
+    ChildNode.PreviousCost = CurrNode.GetActualCost();
+    ChildNode.CurrentCost = Cost;
+
+    if (CheckDomination(Scratch.ExpandedStates, ChildNode))
+    {
+        Nodes.pop_back();
+        oStateArena.DestroyLast();
+        return;
+    }
+
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
+    ChildNode.BaseHeuristicCost = StartingState.GetBaseHeuristicCost(*ChildNode.ConstState);
+    ChildNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(*ChildNode.ConstState);
+    HeuristicTimer.Stop();
+    float TotalCost = ChildNode.GetTotalCost();
+    oOpenList.Push(TotalCost, ChildIndex);
+}
+
+bool CRegressionPlanner::CheckDomination(const CSubsumptionIndex& ExpandedStates, const SNode& Node)
+{
+    if (!ExpandedStates.IsDominated(*Node.ConstState, Node.GetActualCost(), Node.Depth))
+    {
+        return false;
+    }
+
+    if (mStats)
+    {
+        mStats->DominatedCount++;
+    }
+
+    return true;
 }
 
 void CRegressionPlanner::BuildPlan(std::vector<const CAction*>& oSteps, const std::vector<SNode>& Nodes, int NodeIndex)
@@ -98,7 +282,7 @@ void CRegressionPlanner::BuildPlan(std::vector<const CAction*>& oSteps, const st
     {
         if (Nodes[NodeIndex].Action)
         {
-            oSteps.push_back(Nodes[NodeIndex].Action);
+            oSteps.insert(oSteps.end(), Nodes[NodeIndex].Repetition, Nodes[NodeIndex].Action);
         }
 
         NodeIndex = Nodes[NodeIndex].Parent;
@@ -123,7 +307,7 @@ std::string CRegressionPlanner::StringizePath(const std::vector<SNode>& Nodes, i
                 Successive = true;
             }
 
-            Path += Nodes[NodeIndex].Action->GetName();
+            Path += Nodes[NodeIndex].StringizeAction();
         }
 
         NodeIndex = Nodes[NodeIndex].Parent;
@@ -2,29 +2,69 @@
 
 #pragma once
 
-#include <map>
+#include <memory>
 #include <vector>
 
 #include "Node.h"
+#include "OpenList.h"
+#include "SubsumptionIndex.h"
+#include "Workspace.h"
 
 
 namespace ArithGOAP
 {
     class CAction;
+    class CSearchObserver;
     class CState;
+    struct SPlannerStats;
     ///////////////////////////////////////////////////////////////////////////////////////////////
     class CRegressionPlanner // Regressive arithmetic GOAP
     {
     public:
         bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth);
+        // Same as above but with the buffers of a given workspace, which keeps their capacity for later calls.
+        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace);
+        // Attach an observer to trace the search, or detach it with null.
+        void SetObserver(CSearchObserver* Value) { mObserver = Value; }
+        // Collect the statistics of each search into a given instance, or stop collecting them with null.
+        void SetStats(SPlannerStats* Value) { mStats = Value; }
+        // Let a search node repeat an additive or multiplicative action up to a given number of times to regress a desired value back to its starting value at once.
+        // The number of repetitions is solved in closed form, so gathering resources takes one expansion instead of one per step. 1 disables it.
+        // MaxDepth then limits the nodes on a path rather than the actions, since a repetition node takes one depth for all its steps.
+        void SetMaxRepetition(int Value) { mMaxRepetition = Value; }
+        // Skip the nodes dominated by expanded nodes, which ask for no more and were reached no later. See CSubsumptionIndex.
+        // Disabled by default, since it is only sound if no action overrides GetCustomCost or Affect: both see the regressed states, so a
+        // dominated node may still lead to a cheaper plan through them. Nodes with states of CState subclasses are never skipped either.
+        void SetSubsumptionPruning(bool Value) { mSubsumptionPruning = Value; }
 
     protected:
+        struct SRegressionScratch : CPlannerWorkspace::SScratch // Buffers of regressive searches
+        {
+            CSubsumptionIndex ExpandedStates;       // Index of the expanded desired states
+            std::vector<int> Repetitions;           // Numbers of repetitions to explore for an action from a node
+            std::unique_ptr<CState> NextCondition;  // Copy of the desired state before each step of a repetition, kept for its storage
+
+            void Clear() override { ExpandedStates.Clear(); Repetitions.clear(); }
+        };
+
         // Create a search node for a given action from a given node if feasible.
-        void Explore(std::multimap<float, int>& oOpenMap, std::vector<SNode>& Nodes, int NodeIndex, const CAction& Action, const CState& StartingState);
+        void Explore(COpenList& oOpenList, std::vector<SNode>& Nodes, CStateArena& oStateArena, const CSubsumptionIndex& ExpandedStates, int NodeIndex, const CAction& Action, const CState& StartingState);
+        // Create search nodes repeating a given action from a given node as many times as needed to reach each starting value, if feasible.
+        void ExploreRepetitions(COpenList& oOpenList, std::vector<SNode>& Nodes, CStateArena& oStateArena, SRegressionScratch& Scratch, int NodeIndex, const CAction& Action, const CState& StartingState);
+        // Create a search node repeating a given action from a given node a given number of times if feasible.
+        void ExploreRepetition(COpenList& oOpenList, std::vector<SNode>& Nodes, CStateArena& oStateArena, SRegressionScratch& Scratch, int NodeIndex, const CAction& Action, int Repetition, const CState& StartingState);
+        // Check if a node is dominated by an expanded node, and record it in the statistics if so.
+        bool CheckDomination(const CSubsumptionIndex& ExpandedStates, const SNode& Node);
         // List the actions on the path from a given node.
         void BuildPlan(std::vector<const CAction*>& oSteps, const std::vector<SNode>& Nodes, int NodeIndex);
         // Return concatenated names of the actions on the path from a given node.
         std::string StringizePath(const std::vector<SNode>& Nodes, int NodeIndex) const;
+
+    protected:
+        CSearchObserver* mObserver = nullptr; // Optional observer tracing the search
+        SPlannerStats* mStats = nullptr; // Optional statistics of the last search
+        int mMaxRepetition = 1; // Maximum number of times a search node repeats an action
+        bool mSubsumptionPruning = false; // Whether dominated nodes are skipped
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
 }
@@ -0,0 +1,243 @@
+// Copyright 2026 Isaac Hsu
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ARITHGOAP_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ARITHGOAP_SSE2
+#endif
+
+#include "Segment.h"
+#include "SegmentLanes.h"
+
+
+using namespace ArithGOAP;
+using BValue = CNumber::BValue;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Vector primitives. Comparisons return all-one or all-zero lanes, and the helpers mirror the scalar operations
+// used by CNumber and SSegment one by one, so the kernels produce bitwise identical results. AVX2 is only used if the library is
+// compiled for it, e.g. with msbuild /p:EnableAVX2=true, and SSE2 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined(ARITHGOAP_AVX2)
+using BVector = __m256d;
+static constexpr int VectorWidth = 4;
+
+static BVector Load(const BValue* Source) { return _mm256_loadu_pd(Source); }
+static void Store(BValue* Target, BVector Value) { _mm256_storeu_pd(Target, Value); }
+static BVector Broadcast(CNumber Value) { return _mm256_castsi256_pd(_mm256_set1_epi64x(Value.GetBitwiseInteger())); }
+static BVector AllOnes() { return _mm256_castsi256_pd(_mm256_set1_epi64x(-1)); }
+static BVector And(BVector Left, BVector Right) { return _mm256_and_pd(Left, Right); }
+static BVector Or(BVector Left, BVector Right) { return _mm256_or_pd(Left, Right); }
+static BVector AndNot(BVector Left, BVector Right) { return _mm256_andnot_pd(Left, Right); } // ~Left & Right
+static BVector Subtract(BVector Left, BVector Right) { return _mm256_sub_pd(Left, Right); }
+static BVector Multiply(BVector Left, BVector Right) { return _mm256_mul_pd(Left, Right); }
+static BVector Min(BVector Left, BVector Right) { return _mm256_min_pd(Left, Right); } // Left < Right ? Left : Right
+static BVector Max(BVector Left, BVector Right) { return _mm256_max_pd(Left, Right); } // Left > Right ? Left : Right
+static BVector Less(BVector Left, BVector Right) { return _mm256_cmp_pd(Left, Right, _CMP_LT_OQ); }
+static BVector LessOrEqual(BVector Left, BVector Right) { return _mm256_cmp_pd(Left, Right, _CMP_LE_OQ); }
+static BVector Equal(BVector Left, BVector Right) { return _mm256_cmp_pd(Left, Right, _CMP_EQ_OQ); }
+static BVector Select(BVector Mask, BVector IfTrue, BVector IfFalse) { return _mm256_blendv_pd(IfFalse, IfTrue, Mask); }
+static int ToBits(BVector Mask) { return _mm256_movemask_pd(Mask); }
+
+static BVector Identical(BVector Left, BVector Right)
+{
+    return _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_castpd_si256(Left), _mm256_castpd_si256(Right)));
+}
+#elif defined(ARITHGOAP_SSE2)
+using BVector = __m128d;
+static constexpr int VectorWidth = 2;
+
+static BVector Load(const BValue* Source) { return _mm_loadu_pd(Source); }
+static void Store(BValue* Target, BVector Value) { _mm_storeu_pd(Target, Value); }
+static BVector Broadcast(CNumber Value) { return _mm_castsi128_pd(_mm_set1_epi64x(Value.GetBitwiseInteger())); }
+static BVector AllOnes() { return _mm_castsi128_pd(_mm_set1_epi64x(-1)); }
+static BVector And(BVector Left, BVector Right) { return _mm_and_pd(Left, Right); }
+static BVector Or(BVector Left, BVector Right) { return _mm_or_pd(Left, Right); }
+static BVector AndNot(BVector Left, BVector Right) { return _mm_andnot_pd(Left, Right); } // ~Left & Right
+static BVector Subtract(BVector Left, BVector Right) { return _mm_sub_pd(Left, Right); }
+static BVector Multiply(BVector Left, BVector Right) { return _mm_mul_pd(Left, Right); }
+static BVector Min(BVector Left, BVector Right) { return _mm_min_pd(Left, Right); } // Left < Right ? Left : Right
+static BVector Max(BVector Left, BVector Right) { return _mm_max_pd(Left, Right); } // Left > Right ? Left : Right
+static BVector Less(BVector Left, BVector Right) { return _mm_cmplt_pd(Left, Right); }
+static BVector LessOrEqual(BVector Left, BVector Right) { return _mm_cmple_pd(Left, Right); }
+static BVector Equal(BVector Left, BVector Right) { return _mm_cmpeq_pd(Left, Right); }
+static BVector Select(BVector Mask, BVector IfTrue, BVector IfFalse) { return _mm_or_pd(_mm_and_pd(Mask, IfTrue), _mm_andnot_pd(Mask, IfFalse)); }
+static int ToBits(BVector Mask) { return _mm_movemask_pd(Mask); }
+
+static BVector Identical(BVector Left, BVector Right)
+{
+    // SSE2 has no 64-bit integer comparison, so combine the comparisons of both 32-bit halves.
+    __m128i Halves = _mm_cmpeq_epi32(_mm_castpd_si128(Left), _mm_castpd_si128(Right));
+    return _mm_castsi128_pd(_mm_and_si128(Halves, _mm_shuffle_epi32(Halves, _MM_SHUFFLE(2, 3, 0, 1))));
+}
+#endif
+
+#if defined(ARITHGOAP_AVX2) || defined(ARITHGOAP_SSE2)
+static BVector Abs(BVector Value)
+{
+    return AndNot(Broadcast(-0.0), Value);
+}
+
+static BVector IsSet(BVector Minimum, BVector Maximum)
+{
+    BVector Unset = And(Identical(Minimum, Broadcast(SSegment::Unset.Minimum)), Identical(Maximum, Broadcast(SSegment::Unset.Maximum)));
+    return AndNot(Unset, AllOnes());
+}
+
+// See CNumber::IsLessOrEquivalent and CNumber::CalcTolerance.
+static BVector IsLessOrEquivalent(BVector Left, BVector Right, BVector Tolerance)
+{
+    BVector Magnitude = Max(Abs(Left), Abs(Right));
+    BVector FinalTolerance = And(Less(Magnitude, Broadcast(CNumber::Infinity)), Max(Multiply(Magnitude, Tolerance), Tolerance));
+    BVector AlmostEqual = Or(Equal(Left, Right), LessOrEqual(Abs(Subtract(Left, Right)), FinalTolerance));
+    return Or(Less(Left, Right), AlmostEqual);
+}
+
+// See SSegment::HasIntersection.
+static BVector Intersects(BVector AMinimum, BVector AMaximum, BVector BMinimum, BVector BMaximum, BVector Tolerance)
+{
+    BVector Overlapping = And(IsLessOrEquivalent(AMinimum, BMaximum, Tolerance), IsLessOrEquivalent(BMinimum, AMaximum, Tolerance));
+    BVector NonEmpty = And(LessOrEqual(AMinimum, AMaximum), LessOrEqual(BMinimum, BMaximum));
+    return And(Overlapping, NonEmpty);
+}
+
+// See SSegment::Clamp(CNumber&).
+static BVector Clamp(BVector Value, BVector RangeMinimum, BVector RangeMaximum)
+{
+    Value = Select(Less(Value, RangeMinimum), RangeMinimum, Value);
+    return Select(Less(RangeMaximum, Value), RangeMaximum, Value);
+}
+#endif
+///////////////////////////////////////////////////////////////////////////////////////////////////
+BLaneMask ArithGOAP::FindSetLanes(const BValue* Minimums, const BValue* Maximums, int Count)
+{
+    assert(Count <= LaneBlockSize);
+
+    BLaneMask Set = 0;
+    int Lane = 0;
+
+#if defined(ARITHGOAP_AVX2) || defined(ARITHGOAP_SSE2)
+    for (; Lane + VectorWidth <= Count; Lane += VectorWidth)
+    {
+        Set |= BLaneMask(ToBits(IsSet(Load(Minimums + Lane), Load(Maximums + Lane)))) << Lane;
+    }
+#endif
+
+    for (; Lane < Count; Lane++)
+    {
+        Set |= BLaneMask(SSegment(Minimums[Lane], Maximums[Lane]).IsSet()) << Lane;
+    }
+
+    return Set;
+}
+
+BLaneMask ArithGOAP::FindIntersectingLanes(const BValue* AMinimums, const BValue* AMaximums, const BValue* BMinimums, const BValue* BMaximums, int Count, CNumber Tolerance)
+{
+    assert(Count <= LaneBlockSize);
+    assert(Tolerance >= 0);
+
+    BLaneMask Intersections = 0;
+    int Lane = 0;
+
+#if defined(ARITHGOAP_AVX2) || defined(ARITHGOAP_SSE2)
+    const BVector VectorTolerance = Broadcast(Tolerance);
+    for (; Lane + VectorWidth <= Count; Lane += VectorWidth)
+    {
+        BVector Intersecting = Intersects(Load(AMinimums + Lane), Load(AMaximums + Lane), Load(BMinimums + Lane), Load(BMaximums + Lane), VectorTolerance);
+        Intersections |= BLaneMask(ToBits(Intersecting)) << Lane;
+    }
+#endif
+
+    for (; Lane < Count; Lane++)
+    {
+        SSegment A(AMinimums[Lane], AMaximums[Lane]);
+        SSegment B(BMinimums[Lane], BMaximums[Lane]);
+        Intersections |= BLaneMask(A.HasIntersection(B, Tolerance)) << Lane;
+    }
+
+    return Intersections;
+}
+
+void ArithGOAP::CalcHeuristicLanes(BValue* oCosts, const BValue* AMinimums, const BValue* AMaximums, const BValue* BMinimums, const BValue* BMaximums, const BValue* GapWeights, int Count, CNumber BaseCost, CNumber Tolerance)
+{
+    assert(Count <= LaneBlockSize);
+    assert(Tolerance >= 0);
+
+    int Lane = 0;
+
+#if defined(ARITHGOAP_AVX2) || defined(ARITHGOAP_SSE2)
+    const BVector VectorTolerance = Broadcast(Tolerance);
+    const BVector VectorBaseCost = Broadcast(BaseCost);
+    for (; Lane + VectorWidth <= Count; Lane += VectorWidth)
+    {
+        BVector AMinimum = Load(AMinimums + Lane);
+        BVector AMaximum = Load(AMaximums + Lane);
+        BVector BMinimum = Load(BMinimums + Lane);
+        BVector BMaximum = Load(BMaximums + Lane);
+        BVector GapWeight = Load(GapWeights + Lane);
+
+        BVector DistFromMyMin = Abs(Subtract(AMinimum, BMaximum));
+        BVector DistFromMyMax = Abs(Subtract(AMaximum, BMinimum));
+        BVector Gap = Min(DistFromMyMax, DistFromMyMin); // Same operand order as std::min(DistFromMyMin, DistFromMyMax)
+
+        BVector Weighted = And(Less(Broadcast(0.0), GapWeight), Less(Abs(Gap), Broadcast(CNumber::Infinity)));
+        BVector Cost = Select(Weighted, Multiply(Gap, GapWeight), VectorBaseCost);
+        Store(oCosts + Lane, AndNot(Intersects(AMinimum, AMaximum, BMinimum, BMaximum, VectorTolerance), Cost));
+    }
+#endif
+
+    for (; Lane < Count; Lane++)
+    {
+        SSegment A(AMinimums[Lane], AMaximums[Lane]);
+        SSegment B(BMinimums[Lane], BMaximums[Lane]);
+        if (A.HasIntersection(B, Tolerance))
+        {
+            oCosts[Lane] = 0;
+            continue;
+        }
+
+        BValue DistFromMyMin = std::abs(AMinimums[Lane] - BMaximums[Lane]);
+        BValue DistFromMyMax = std::abs(AMaximums[Lane] - BMinimums[Lane]);
+        BValue Gap = std::min(DistFromMyMin, DistFromMyMax);
+        oCosts[Lane] = (GapWeights[Lane] > 0 && std::isfinite(Gap)) ? Gap * GapWeights[Lane] : BaseCost.Get();
+    }
+}
+
+void ArithGOAP::ClampLanes(BValue* ioMinimums, BValue* ioMaximums, const BValue* RangeMinimums, const BValue* RangeMaximums, int Count)
+{
+    assert(Count <= LaneBlockSize);
+
+    int Lane = 0;
+
+#if defined(ARITHGOAP_AVX2) || defined(ARITHGOAP_SSE2)
+    for (; Lane + VectorWidth <= Count; Lane += VectorWidth)
+    {
+        BVector Minimum = Load(ioMinimums + Lane);
+        BVector Maximum = Load(ioMaximums + Lane);
+        BVector RangeMinimum = Load(RangeMinimums + Lane);
+        BVector RangeMaximum = Load(RangeMaximums + Lane);
+
+        // Unset lanes hold NaNs, which fail every comparison and pass through the clamps unchanged.
+        BVector Emptied = AndNot(LessOrEqual(RangeMinimum, RangeMaximum), IsSet(Minimum, Maximum));
+        Store(ioMinimums + Lane, Select(Emptied, Broadcast(SSegment::Empty.Minimum), Clamp(Minimum, RangeMinimum, RangeMaximum)));
+        Store(ioMaximums + Lane, Select(Emptied, Broadcast(SSegment::Empty.Maximum), Clamp(Maximum, RangeMinimum, RangeMaximum)));
+    }
+#endif
+
+    for (; Lane < Count; Lane++)
+    {
+        SSegment Segment(ioMinimums[Lane], ioMaximums[Lane]);
+        if (Segment.IsSet())
+        {
+            SSegment(RangeMinimums[Lane], RangeMaximums[Lane]).Clamp(Segment);
+            ioMinimums[Lane] = Segment.Minimum;
+            ioMaximums[Lane] = Segment.Maximum;
+        }
+    }
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
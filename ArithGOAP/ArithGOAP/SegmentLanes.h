@@ -0,0 +1,81 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+#include "Number.h"
+
+
+namespace ArithGOAP
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Kernels over segments stored as a structure of arrays, i.e. an array of minimums and another of maximums.
+    // Each call processes up to LaneBlockSize lanes and reports its results as one bit per lane.
+    // Unset lanes are recognized bitwise like SSegment::IsUnset, so states don't need to store separate set flags.
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    using BLaneMask = std::uint64_t;
+    static constexpr int LaneBlockSize = 64;
+
+    // Return a bitmask of the first given number of lanes.
+    constexpr BLaneMask MaskLanes(int Count) { return Count < LaneBlockSize ? (BLaneMask(1) << Count) - 1 : ~BLaneMask(0); }
+
+    // Return a bitmask of the lanes that are set.
+    BLaneMask FindSetLanes(const CNumber::BValue* Minimums, const CNumber::BValue* Maximums, int Count);
+    // Return a bitmask of the lanes in which the segments of A intersect with those of B. See SSegment::HasIntersection.
+    BLaneMask FindIntersectingLanes(const CNumber::BValue* AMinimums, const CNumber::BValue* AMaximums, const CNumber::BValue* BMinimums, const CNumber::BValue* BMaximums, int Count, CNumber Tolerance);
+    // Calculate the heuristic costs from the segments of A to those of B, assuming both are set. Intersecting lanes cost 0. The others cost their gaps 
+    // times their gap weights, or BaseCost if the weights are 0 or the gaps are infinite. See EHeuristicKind.
+    void CalcHeuristicLanes(CNumber::BValue* oCosts, const CNumber::BValue* AMinimums, const CNumber::BValue* AMaximums, const CNumber::BValue* BMinimums, const CNumber::BValue* BMaximums, const CNumber::BValue* GapWeights, int Count, CNumber BaseCost, CNumber Tolerance);
+    // Clamp the set segments to the ranges in the same lanes. See SSegment::Clamp.
+    void ClampLanes(CNumber::BValue* ioMinimums, CNumber::BValue* ioMaximums, const CNumber::BValue* RangeMinimums, const CNumber::BValue* RangeMaximums, int Count);
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    class CLaneRange // Range of the indexes of the set bits in consecutive lane masks, in ascending order
+    {
+    public:
+        class CIterator
+        {
+        public:
+            CIterator(const BLaneMask* Masks, int Block, int BlockCount)
+                : mMasks(Masks)
+                , mBlock(Block)
+                , mBlockCount(BlockCount)
+                , mMask(Block < BlockCount ? Masks[Block] : 0)
+            {
+                Skip();
+            }
+
+            int operator * () const { return mBlock * LaneBlockSize + std::countr_zero(mMask); }
+            CIterator& operator ++ () { mMask &= mMask - 1; Skip(); return *this; }
+            bool operator != (const CIterator& Another) const { return mBlock != Another.mBlock || mMask != Another.mMask; }
+
+        private:
+            void Skip() // Move on to the next block with any set bits, or the end.
+            {
+                while (mMask == 0 && mBlock < mBlockCount)
+                {
+                    mBlock++;
+                    mMask = (mBlock < mBlockCount) ? mMasks[mBlock] : 0;
+                }
+            }
+
+        private:
+            const BLaneMask* mMasks = nullptr;
+            int mBlock = 0;
+            int mBlockCount = 0;
+            BLaneMask mMask = 0; // Bits of the current block not visited yet
+        };
+
+    public:
+        CLaneRange(const BLaneMask* Masks, int BlockCount) : mMasks(Masks), mBlockCount(BlockCount) {}
+
+        CIterator begin() const { return CIterator(mMasks, 0, mBlockCount); }
+        CIterator end() const   { return CIterator(mMasks, mBlockCount, mBlockCount); }
+
+    private:
+        const BLaneMask* mMasks = nullptr;
+        int mBlockCount = 0;
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -1,11 +1,16 @@
 // Copyright 2024 Isaac Hsu
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <memory>
+#include <typeinfo>
 
 #include "Fact.h"
 #include "Notation.h"
+#include "SegmentLanes.h"
 #include "State.h"
+#include "StateArena.h"
 
 
 using namespace ArithGOAP;
@@ -16,12 +21,47 @@ CState::CState(const CFactDefinition& Definition)
     Expand(Definition.GetFactCount());
 }
 
+CState::CState(const CState& Another, std::pmr::memory_resource* Resource)
+    : mDefinition(Another.mDefinition), mBounds(Another.mBounds, Resource), mSetLanes(Another.mSetLanes, Resource)
+{
+}
+
 void CState::Expand(int Size)
 {
-    if (Size > mProperties.size())
+    const int Capacity = GetPropertyCapacity();
+    if (Size > Capacity)
+    {
+        // Both halves grow, so the maximums have to be moved behind the new minimums.
+        std::pmr::vector<CNumber::BValue> Bounds(Size * 2, mBounds.get_allocator()); // Swapped storage must share the memory resource.
+        std::copy_n(GetMinimums(), Capacity, Bounds.begin());
+        std::fill(Bounds.begin() + Capacity, Bounds.begin() + Size, SSegment::Unset.Minimum.Get());
+        std::copy_n(GetMaximums(), Capacity, Bounds.begin() + Size);
+        std::fill(Bounds.begin() + Size + Capacity, Bounds.end(), SSegment::Unset.Maximum.Get());
+        mBounds.swap(Bounds);
+        mSetLanes.resize((Size + LaneBlockSize - 1) / LaneBlockSize, 0);
+    }
+}
+
+CState* CState::CloneInto(CStateArena& Arena) const
+{
+    if (typeid(*this) == typeid(CState))
+    {
+        return Arena.Create<CState>(*this, &Arena);
+    }
+
+    return Arena.Adopt(Clone()); // Subclasses without their own overrides are still cloned with their dynamic types.
+}
+
+void CState::CopyTo(std::unique_ptr<CState>& ioState) const
+{
+    if (!ioState || typeid(*this) != typeid(CState) || typeid(*ioState) != typeid(CState) || &ioState->mDefinition != &mDefinition)
     {
-        mProperties.resize(Size);
+        ioState = Clone();
+        return;
     }
+
+    ioState->mBounds.assign(mBounds.begin(), mBounds.end());
+    ioState->mSetLanes.assign(mSetLanes.begin(), mSetLanes.end());
 }
 
 std::string CState::ToString() const
@@ -29,14 +69,9 @@ std::string CState::ToString() const
     std::string Return;
     bool Successive = false;
 
-    for (int FactIndex = 0; FactIndex < mProperties.size(); FactIndex++)
+    for (int FactIndex : GetSetProperties())
     {
-        const SSegment& Segment = mProperties[FactIndex];
-        if (Segment.IsUnset())
-        {
-            continue;
-        }
-
+        const SSegment Segment = GetProperty(FactIndex);
         if (Successive)
         {
             Return += ", ";
@@ -55,36 +90,19 @@ std::string CState::ToString() const
 int CState::CountProperties() const
 {
     int Count = 0;
-
-    for (const SSegment& Segment : mProperties)
+    for (BLaneMask Lanes : mSetLanes)
     {
-        if (Segment.IsSet())
-        {
-            Count++;
-        }
+        Count += std::popcount(Lanes);
     }
 
     return Count;
 }
 
-SSegment& CState::GetProperty(int FactIndex)
-{
-    Expand(FactIndex + 1);
-    return mProperties[FactIndex];
-}
-
-SSegment& CState::GetProperty(const CFact& Fact)
+SSegment CState::GetProperty(int FactIndex) const
 {
-    assert(&Fact.GetOwner() == &mDefinition);
-
-    return GetProperty(Fact.GetIndex());
-}
-
-const SSegment& CState::GetProperty(int FactIndex) const
-{
-    if (FactIndex >= 0 && FactIndex < mProperties.size())
+    if (FactIndex >= 0 && FactIndex < GetPropertyCapacity())
     {
-        return mProperties[FactIndex];
+        return SSegment(GetMinimums()[FactIndex], GetMaximums()[FactIndex]);
     }
     else
     {
@@ -92,7 +110,7 @@ const SSegment& CState::GetProperty(int FactIndex) const
     }
 }
 
-const SSegment& CState::GetProperty(const CFact& Fact) const
+SSegment CState::GetProperty(const CFact& Fact) const
 {
     assert(&Fact.GetOwner() == &mDefinition);
 
@@ -102,7 +120,12 @@ const SSegment& CState::GetProperty(const CFact& Fact) const
 bool CState::SetProperty(int FactIndex, const SSegment& Segment)
 {
     Expand(FactIndex + 1);
-    mProperties[FactIndex] = Segment;
+    GetMinimums()[FactIndex] = Segment.Minimum;
+    GetMaximums()[FactIndex] = Segment.Maximum;
+
+    const BLaneMask LaneBit = BLaneMask(1) << (FactIndex % LaneBlockSize);
+    BLaneMask& Lanes = mSetLanes[FactIndex / LaneBlockSize];
+    Lanes = Segment.IsSet() ? (Lanes | LaneBit) : (Lanes & ~LaneBit);
     return true;
 }
 
@@ -144,26 +167,40 @@ bool CState::IsContradictory(const CState& Another) const
     assert(&Another.GetDefinition() == &mDefinition);
 
     const CNumber Tolerance = GetDefinition().GetTolerance();
-    for (int FactIndex = 0; FactIndex < mProperties.size(); FactIndex++)
+    const int SharedCapacity = std::min(GetPropertyCapacity(), Another.GetPropertyCapacity());
+
+    for (int Begin = 0; Begin < SharedCapacity; Begin += LaneBlockSize)
     {
-        const SSegment& Source = mProperties[FactIndex];
-        if (Source.IsUnset())
+        const int Block = Begin / LaneBlockSize;
+        const BLaneMask Sources = GetSetLanes(Block);
+        if (Sources == 0)
         {
             continue;
         }
 
-        const SSegment& Other = Another.GetProperty(FactIndex);
-        if (Other.IsUnset())
+        const BLaneMask Others = Another.GetSetLanes(Block); // Properties beyond the capacity of another state are never set in its masks.
+        if (Sources & ~Others)
         {
             return true;
         }
 
-        if (!Source.HasIntersection(Other, Tolerance))
+        const int Count = std::min(LaneBlockSize, SharedCapacity - Begin);
+        const BLaneMask Intersections = FindIntersectingLanes(GetMinimums() + Begin, GetMaximums() + Begin, Another.GetMinimums() + Begin, Another.GetMaximums() + Begin, Count, Tolerance);
+        if (Sources & ~Intersections)
         {
             return true;
         }
     }
 
+    const int BlockCount = static_cast<int>(mSetLanes.size());
+    for (int Block = (SharedCapacity + LaneBlockSize - 1) / LaneBlockSize; Block < BlockCount; Block++)
+    {
+        if (GetSetLanes(Block))
+        {
+            return true; // Properties beyond the capacity of another state are empty, so they can't intersect with anything.
+        }
+    }
+
     return false;
 }
 
@@ -3,10 +3,13 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
 #include "Segment.h"
+#include "SegmentLanes.h"
+#include "StateArena.h"
 
 
 namespace ArithGOAP
@@ -23,9 +26,18 @@ namespace ArithGOAP
         friend class CFactDefinition;
     public:
         CState(const CFactDefinition& Definition);
+        CState(const CState& Another) = default;
+        // Copy another state with its storage allocated from a given memory resource, such as a state arena.
+        CState(const CState& Another, std::pmr::memory_resource* Resource);
         virtual ~CState() {}
 
         virtual std::unique_ptr<CState> Clone() const { return std::make_unique<CState>(*this); }
+        // Clone this state into an arena. Subclasses override it with Arena.Create<CSubclass>(*this, &Arena) and a constructor passing the arena
+        // on to the copy constructor of CState with a memory resource, or their Clone results are adopted.
+        virtual CState* CloneInto(CStateArena& Arena) const;
+        // Copy this state into a given one, which keeps its storage for later copies. It's replaced by a clone unless both are CState
+        // instances of the same definition.
+        void CopyTo(std::unique_ptr<CState>& ioState) const;
         virtual std::string ToString() const; // For debugging
         virtual float GetExtraHeuristicCost(const CState& Another) const { return 0.f; } // Custom heuristic cost
 
@@ -34,11 +46,17 @@ namespace ArithGOAP
 
         bool IsEmpty() const { return CountProperties() <= 0; }
         int CountProperties() const; // Number of properties that are set
-        int GetPropertyCapacity() const { return static_cast<int>(mProperties.size()); } // Total number of all properties, including unset ones
-        const std::vector<SSegment>& GetProperties() const { return mProperties; }
-        SSegment& GetProperty(const CFact& Fact);
-        const SSegment& GetProperty(const CFact& Fact) const;
-        const SSegment& GetProperty(int FactIndex) const;
+        int GetPropertyCapacity() const { return static_cast<int>(mBounds.size() / 2); } // Total number of all properties, including unset ones
+        // Lower and upper bounds of all properties, stored as a structure of arrays for the segment lane kernels
+        const CNumber::BValue* GetMinimums() const { return mBounds.data(); }
+        const CNumber::BValue* GetMaximums() const { return mBounds.data() + GetPropertyCapacity(); }
+        // Bitmask of the set properties in a given block of LaneBlockSize properties
+        BLaneMask GetSetLanes(int Block) const { return mSetLanes[Block]; }
+        int GetLaneBlockCount() const { return static_cast<int>(mSetLanes.size()); }
+        // Indexes of the set properties in ascending order, so sparse states are iterated without visiting unset properties
+        CLaneRange GetSetProperties() const { return CLaneRange(mSetLanes.data(), static_cast<int>(mSetLanes.size())); }
+        SSegment GetProperty(const CFact& Fact) const;
+        SSegment GetProperty(int FactIndex) const;
         bool SetProperty(const CFact& Fact, const SSegment& Segment);
         bool SetProperty(const CFact& Fact, CNumber Value);
         bool SetProperty(const SFactEquation& Equation);
@@ -51,12 +69,15 @@ namespace ArithGOAP
 
     protected:
         void Expand(int Size);
-        SSegment& GetProperty(int FactIndex);
+        CNumber::BValue* GetMinimums() { return mBounds.data(); }
+        CNumber::BValue* GetMaximums() { return mBounds.data() + GetPropertyCapacity(); }
         bool SetProperty(int FactIndex, const SSegment& Segment);
 
     private:
         const CFactDefinition& mDefinition;
-        std::vector<SSegment> mProperties;
+        // Copies take the default memory resource.
+        std::pmr::vector<CNumber::BValue> mBounds; // The minimums of all properties followed by their maximums
+        std::pmr::vector<BLaneMask> mSetLanes; // Bitmasks of the set properties, one per block of LaneBlockSize properties, kept up to date by SetProperty
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
 }
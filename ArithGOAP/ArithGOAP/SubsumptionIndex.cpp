@@ -0,0 +1,113 @@
+// Copyright 2026 Isaac Hsu
+
+#include <typeinfo>
+
+#include "State.h"
+#include "SubsumptionIndex.h"
+
+
+using namespace ArithGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void CSubsumptionIndex::Clear()
+{
+    for (int BucketIndex = 0; BucketIndex < mBucketCount; BucketIndex++)
+    {
+        mBuckets[BucketIndex].Entries.clear();
+    }
+
+    mBucketCount = 0;
+}
+
+void CSubsumptionIndex::Add(const CState& State, float Cost, int Depth)
+{
+    if (typeid(State) != typeid(CState))
+    {
+        return;
+    }
+
+    const int PropertyCount = State.CountProperties();
+    for (int BucketIndex = 0; BucketIndex < mBucketCount; BucketIndex++)
+    {
+        SBucket& Bucket = mBuckets[BucketIndex];
+        if (Bucket.PropertyCount == PropertyCount && IsSubset(Bucket.Lanes, State)) // A subset of the same size is the same set.
+        {
+            Bucket.Entries.push_back({&State, Cost, Depth});
+            return;
+        }
+    }
+
+    if (mBucketCount == static_cast<int>(mBuckets.size()))
+    {
+        mBuckets.emplace_back();
+    }
+
+    const int BlockCount = State.GetLaneBlockCount();
+    SBucket& Bucket = mBuckets[mBucketCount++];
+    Bucket.PropertyCount = PropertyCount;
+    Bucket.Lanes.resize(BlockCount);
+    for (int Block = 0; Block < BlockCount; Block++)
+    {
+        Bucket.Lanes[Block] = State.GetSetLanes(Block);
+    }
+
+    Bucket.Entries.push_back({&State, Cost, Depth});
+}
+
+bool CSubsumptionIndex::IsDominated(const CState& State, float Cost, int Depth) const
+{
+    if (typeid(State) != typeid(CState))
+    {
+        return false;
+    }
+
+    const int PropertyCount = State.CountProperties();
+    for (int BucketIndex = 0; BucketIndex < mBucketCount; BucketIndex++)
+    {
+        const SBucket& Bucket = mBuckets[BucketIndex];
+        if (Bucket.PropertyCount > PropertyCount || !IsSubset(Bucket.Lanes, State))
+        {
+            continue;
+        }
+
+        for (const SEntry& Entry : Bucket.Entries)
+        {
+            if (Entry.Cost <= Cost && Entry.Depth <= Depth && Contain(*Entry.State, State))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool CSubsumptionIndex::IsSubset(const std::vector<BLaneMask>& Lanes, const CState& State)
+{
+    const int BlockCount = State.GetLaneBlockCount();
+    for (int Block = 0; Block < static_cast<int>(Lanes.size()); Block++)
+    {
+        const BLaneMask StateLanes = (Block < BlockCount) ? State.GetSetLanes(Block) : 0;
+        if (Lanes[Block] & ~StateLanes)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CSubsumptionIndex::Contain(const CState& Outer, const CState& Inner)
+{
+    for (int FactIndex : Outer.GetSetProperties())
+    {
+        const SSegment OuterSegment = Outer.GetProperty(FactIndex);
+        const SSegment InnerSegment = Inner.GetProperty(FactIndex);
+        if (!(OuterSegment.Minimum.Get() <= InnerSegment.Minimum.Get() && InnerSegment.Maximum.Get() <= OuterSegment.Maximum.Get()))
+        {
+            return false; // Exact bounds without tolerance, so only true subsumption prunes.
+        }
+    }
+
+    return true;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
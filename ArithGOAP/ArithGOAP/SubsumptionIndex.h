@@ -0,0 +1,56 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <vector>
+
+#include "SegmentLanes.h"
+
+
+namespace ArithGOAP
+{
+    class CState;
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Index of the desired states expanded by a regressive search. A desired state is dominated by an expanded one if the expanded state
+    // asks for no more, i.e. each of its set properties is set in the given state to a segment within its own, and it was reached at no
+    // higher cost and no greater depth. Any plan reaching the dominated state also reaches the expanded one, so the dominated node can be 
+    // skipped without losing a better plan, as long as the costs and effects of the actions do not depend on the states beyond their
+    // preconditions, i.e. no action overrides CAction::GetCustomCost or CAction::Affect. The states are bucketed by their masks of set
+    // properties, so a whole bucket is skipped if its mask is not a subset of the one of the given state.
+    class CSubsumptionIndex
+    {
+    public:
+        // Remove all states, and keep the capacity of the buckets.
+        void Clear();
+        // Add an expanded state, which has to outlive this index or the next Clear call.
+        // States of subclasses may carry more than their properties, so they are ignored.
+        void Add(const CState& State, float Cost, int Depth);
+        // Is a given state reached at a given cost and depth dominated by any added state?
+        bool IsDominated(const CState& State, float Cost, int Depth) const;
+
+    private:
+        struct SEntry
+        {
+            const CState* State = nullptr;
+            float Cost = 0.f;
+            int Depth = 0;
+        };
+
+        struct SBucket
+        {
+            std::vector<BLaneMask> Lanes;   // Mask of the set properties of the states in this bucket
+            int PropertyCount = 0;          // Number of the set properties in the mask
+            std::vector<SEntry> Entries;    // States in the order they are added
+        };
+
+        // Are the set properties in a given mask also set in a given state?
+        static bool IsSubset(const std::vector<BLaneMask>& Lanes, const CState& State);
+        // Does each set property of an outer state contain the property of an inner state?
+        static bool Contain(const CState& Outer, const CState& Inner);
+
+    private:
+        std::vector<SBucket> mBuckets;
+        int mBucketCount = 0; // Number of the buckets in use. Cleared buckets are kept for reuse.
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
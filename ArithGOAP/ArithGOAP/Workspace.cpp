@@ -0,0 +1,31 @@
+// Copyright 2026 Isaac Hsu
+
+#include <atomic>
+
+#include "State.h"
+#include "Workspace.h"
+
+
+using namespace ArithGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void CPlannerWorkspace::Clear()
+{
+    mNodes.clear();
+    mStateArena.Clear();
+    mOpenList.Clear();
+
+    for (std::unique_ptr<SScratch>& Scratch : mScratches)
+    {
+        if (Scratch)
+        {
+            Scratch->Clear();
+        }
+    }
+}
+
+int CPlannerWorkspace::AssignScratchIndex()
+{
+    static std::atomic<int> ScratchTypeCount(0); // Workspaces on different threads may meet a scratch type at the same time.
+    return ScratchTypeCount++;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
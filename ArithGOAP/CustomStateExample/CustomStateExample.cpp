@@ -19,6 +19,8 @@ class CStateWithPosition : public CState
     using Super = CState;
 public:
     using Super::Super;
+    CStateWithPosition(const CStateWithPosition& Another) = default;
+    CStateWithPosition(const CStateWithPosition& Another, std::pmr::memory_resource* Resource) : Super(Another, Resource), mPosition(Another.mPosition) {}
 
     const SVector& GetPosition() const { return mPosition; }
     void SetPosition(const SVector& Value) { mPosition = Value; }
@@ -26,6 +28,7 @@ public:
 
 protected:
     std::unique_ptr<CState> Clone() const override { return std::make_unique<CStateWithPosition>(*this); }
+    CState* CloneInto(CStateArena& Arena) const override { return Arena.Create<CStateWithPosition>(*this, &Arena); }
 
     float GetExtraHeuristicCost(const CState& Another) const override
     {
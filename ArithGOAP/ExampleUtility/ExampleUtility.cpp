@@ -3,6 +3,7 @@
 #include <iostream>
 
 #include "ArithGOAP/ArithGOAP.h"
+#include "ArithGOAP/Observer.h"
 #include "ExampleUtility.h"
 
 
@@ -64,15 +65,16 @@ void RunGOAPs(const CState& StartingState, const CState& GoalState, const std::v
     std::cout << std::endl;
 
     std::vector<const CAction*> Steps;
-    bool Found1 = ForwardSearch(Steps, StartingState, GoalState, Actions, MaxDepth);
+    CConsoleObserver Observer;
+    bool Found1 = ForwardSearch(Steps, StartingState, GoalState, Actions, MaxDepth, &Observer);
     std::cout << StringizeGOAPResult(Found1, Steps) << std::endl;
 
     Steps.clear();
-    bool Found2 = RegressiveSearch(Steps, StartingState, GoalState, Actions, MaxDepth);
+    bool Found2 = RegressiveSearch(Steps, StartingState, GoalState, Actions, MaxDepth, &Observer);
     std::cout << StringizeGOAPResult(Found2, Steps) << std::endl;
 
     Steps.clear();
-    bool Found3 = AdvRegressiveSearch(Steps, StartingState, GoalState, Actions, MaxDepth);
+    bool Found3 = AdvRegressiveSearch(Steps, StartingState, GoalState, Actions, MaxDepth, &Observer);
     std::cout << StringizeGOAPResult(Found3, Steps) << std::endl;
 }
 
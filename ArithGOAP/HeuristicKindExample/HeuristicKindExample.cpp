@@ -0,0 +1,202 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This example shows how each fact estimates its part of the heuristic cost, and checks that the 
+// definition evaluates the estimates from its tables of heuristic kinds and gap weights.
+// 
+// Numeric facts measure the gap between segments times a gap weight, while Boolean and enumeration
+// facts only tell whether the segments intersect. A custom heuristic functor replaces either kind, 
+// and setting a gap weight or a null functor restores the default kind. The first part prints the
+// kind of a few facts along these changes. The second part computes the heuristic costs of random 
+// pairs of states fact by fact, and compares them with those of the definition.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ArithGOAP/Fact.h"
+#include "ArithGOAP/State.h"
+
+
+using namespace ArithGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+    std::mt19937 Random(7);
+
+    const char* GetKindName(EHeuristicKind Kind)
+    {
+        switch (Kind)
+        {
+        case EHeuristicKind::gap: return "gap";
+        case EHeuristicKind::mismatch: return "mismatch";
+        case EHeuristicKind::custom: return "custom";
+        }
+
+        return "?";
+    }
+
+    void PrintKind(const std::string& Label, const CFact& Fact)
+    {
+        std::cout << Label << ": " << GetKindName(Fact.GetHeuristicKind()) << std::endl;
+    }
+
+    CNumber MakeNumber()
+    {
+        switch (Random() % 10)
+        {
+        case 0: return CNumber::Infinity;
+        case 1: return -CNumber::Infinity;
+        case 2: return 5.0;
+        case 3: return 0.0;
+        default: return static_cast<double>(static_cast<int>(Random() % 20) - 10) / (1 + Random() % 3);
+        }
+    }
+
+    void FillState(CState& oState, const std::vector<CFact*>& Facts)
+    {
+        for (const CFact* Fact : Facts)
+        {
+            if (Random() % 3)
+            {
+                const CNumber Value = MakeNumber();
+                oState.SetProperty(*Fact, (Random() % 3) ? SSegment(Value) : SSegment(Value, MakeNumber(), Autocorrect));
+            }
+        }
+    }
+
+    // Same as CFactDefinition::GetHeuristicCost but one fact at a time, with the gap weights given by the caller
+    CNumber GetHeuristicCostOneByOne(const CFactDefinition& Definition, const std::vector<CNumber>& GapWeights, const CState& SourceState, const CState& DesiredState)
+    {
+        CNumber Cost = 0;
+        for (const auto& Fact : Definition)
+        {
+            const SSegment Target = DesiredState.GetProperty(Fact->GetIndex());
+            if (Target.IsUnset())
+            {
+                continue;
+            }
+
+            const SSegment Source = SourceState.GetProperty(Fact->GetIndex());
+            if (Source.IsUnset())
+            {
+                Cost += Definition.GetBaseRelationCost();
+                continue;
+            }
+
+            switch (Fact->GetHeuristicKind())
+            {
+            case EHeuristicKind::gap:
+                if (CNumber Gap = Source.GetGap(Target, Definition.GetTolerance()); Gap.IsFinite())
+                {
+                    Cost += Gap * GapWeights[Fact->GetIndex()];
+                }
+                else
+                {
+                    Cost += Definition.GetBaseRelationCost();
+                }
+                break;
+            case EHeuristicKind::mismatch:
+                Cost += Source.HasIntersection(Target, Definition.GetTolerance()) ? CNumber(0) : Definition.GetBaseRelationCost();
+                break;
+            case EHeuristicKind::custom:
+                Cost += Fact->GetHeuristicFunctor()(Source, Target);
+                break;
+            }
+        }
+
+        return Cost;
+    }
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    {
+        CFactDefinition Definition;
+        CFact& Flag = *Definition.DefineBoolean("Flag");
+        CFact& Mode = *Definition.DefineEnumeration("Mode", SSegment(0, 3));
+        CFact& Gold = *Definition.DefineNumber("Gold", 2);
+
+        PrintKind("Boolean", Flag);
+        PrintKind("Enumeration", Mode);
+        PrintKind("Number", Gold);
+
+        Gold.SetHeuristicFunctor([](const SSegment& Source, const SSegment& Target) { return Source.GetGap(Target) / 10; });
+        PrintKind("Number with a functor", Gold);
+        Gold.SetHeuristicFunctor(nullptr);
+        PrintKind("Number with a null functor", Gold);
+        Gold.SetHeuristicFunctor([](const SSegment& Source, const SSegment& Target) { return Source.GetGap(Target) / 10; });
+        Gold.SetGapWeight(3);
+        PrintKind("Number with a functor and then a gap weight", Gold);
+        Mode.SetGapWeight(3);
+        PrintKind("Enumeration with a gap weight", Mode);
+        std::cout << std::endl;
+    }
+
+    constexpr int DefinitionCount = 3000;
+    int CostMismatches = 0;
+
+    for (int DefinitionIndex = 0; DefinitionIndex < DefinitionCount; DefinitionIndex++)
+    {
+        CFactDefinition Definition(1 + Random() % 3, (Random() % 2) ? CNumber::DefaultTolerance : CNumber(0.01));
+        std::vector<CFact*> Facts;
+        std::vector<CNumber> GapWeights; // Gap weights set to the facts, which the definition keeps to itself
+        const int FactCount = 1 + Random() % 150;
+        for (int FactIndex = 0; FactIndex < FactCount; FactIndex++)
+        {
+            const std::string Name = "F" + std::to_string(FactIndex);
+            CNumber GapWeight = 1;
+            switch (Random() % 4)
+            {
+            case 0:
+                Facts.push_back(Definition.DefineBoolean(Name));
+                break;
+            case 1:
+                Facts.push_back(Definition.DefineEnumeration(Name, SSegment(0, 5)));
+                break;
+            case 2:
+                GapWeight = 0.5 + Random() % 3;
+                Facts.push_back(Definition.DefineNumber(Name, SSegment(-3, 7), GapWeight));
+                break;
+            default:
+                Facts.push_back(Definition.DefineNumber(Name));
+                Facts.back()->SetHeuristicFunctor([](const SSegment& Source, const SSegment& Target) { return Source.GetGap(Target) * 3 + 0.25; });
+                break;
+            }
+
+            // Change the heuristics of some facts after their definitions.
+            CFact& Fact = *Facts.back();
+            switch (Random() % 8)
+            {
+            case 0:
+                Fact.SetHeuristicFunctor([](const SSegment& Source, const SSegment& Target) { return Source.HasIntersection(Target) ? 0.5 : 7.0; });
+                break;
+            case 1:
+                GapWeight = 0.25;
+                Fact.SetGapWeight(GapWeight);
+                break;
+            case 2:
+                GapWeight = 1;
+                Fact.SetHeuristicFunctor(nullptr);
+                break;
+            }
+
+            GapWeights.push_back(GapWeight);
+        }
+
+        CState SourceState(Definition);
+        CState DesiredState(Definition);
+        FillState(SourceState, Facts);
+        FillState(DesiredState, Facts);
+
+        const CNumber Cost = Definition.GetHeuristicCost(SourceState, DesiredState);
+        const CNumber ExpectedCost = GetHeuristicCostOneByOne(Definition, GapWeights, SourceState, DesiredState);
+        CostMismatches += Cost.GetBitwiseInteger() != ExpectedCost.GetBitwiseInteger();
+    }
+
+    std::cout << "Definitions: " << DefinitionCount << std::endl;
+    std::cout << "GetHeuristicCost mismatches: " << CostMismatches << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This program times the state operations built on the segment lane kernels, so that the effect of
+// the instruction sets chosen for them can be compared across builds. It reports the nanoseconds 
+// per call of the heuristic cost, the contradiction test, and copying and clamping a state, for 
+// definitions of increasing sizes. Half of the facts are Boolean and half are bounded numbers, and 
+// a quarter of the properties of each state are left unset.
+// 
+// Usage: LaneBenchmark [Repeats=N]
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ArithGOAP/Fact.h"
+#include "ArithGOAP/State.h"
+
+
+using namespace ArithGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+    constexpr int StateCount = 64; // Number of the states compared with the goal in each repeat
+
+    double GetNanoseconds(std::chrono::steady_clock::time_point Start, std::chrono::steady_clock::time_point End, double CallCount)
+    {
+        return std::chrono::duration<double, std::nano>(End - Start).count() / CallCount;
+    }
+
+    void RunSize(int FactCount, int Repeats)
+    {
+        std::mt19937 Random(3);
+        CFactDefinition Definition;
+        std::vector<const CFact*> Facts;
+        for (int FactIndex = 0; FactIndex < FactCount; FactIndex++)
+        {
+            const std::string Name = "F" + std::to_string(FactIndex);
+            if (FactIndex % 2)
+            {
+                Facts.push_back(Definition.DefineNumber(Name, SSegment(-100, 100)));
+            }
+            else
+            {
+                Facts.push_back(Definition.DefineBoolean(Name));
+            }
+        }
+
+        std::vector<CState> States;
+        for (int StateIndex = 0; StateIndex < StateCount; StateIndex++)
+        {
+            CState& State = States.emplace_back(Definition);
+            for (int FactIndex = 0; FactIndex < FactCount; FactIndex++)
+            {
+                if (Random() % 4)
+                {
+                    State.SetProperty(*Facts[FactIndex], CNumber(static_cast<double>(Random() % ((FactIndex % 2) ? 50 : 2))));
+                }
+            }
+        }
+
+        CState GoalState(Definition);
+        for (int FactIndex = 0; FactIndex < FactCount; FactIndex++)
+        {
+            GoalState.SetProperty(*Facts[FactIndex], (FactIndex % 2) ? SSegment(0, 200) : SSegment(0, 1));
+        }
+
+        // Accumulate the results, so that the calls aren't optimized away.
+        double CostSum = 0.0;
+        long long Count = 0;
+
+        const auto HeuristicStart = std::chrono::steady_clock::now();
+        for (int Repeat = 0; Repeat < Repeats; Repeat++)
+        {
+            for (const CState& State : States)
+            {
+                CostSum += Definition.GetHeuristicCost(State, GoalState);
+            }
+        }
+
+        const auto ContradictionStart = std::chrono::steady_clock::now();
+        for (int Repeat = 0; Repeat < Repeats; Repeat++)
+        {
+            for (const CState& State : States)
+            {
+                Count += GoalState.IsContradictory(State) + State.IsContradictory(GoalState);
+            }
+        }
+
+        const auto ClampStart = std::chrono::steady_clock::now();
+        const int ClampRepeats = std::max(Repeats / 10, 1);
+        for (int Repeat = 0; Repeat < ClampRepeats; Repeat++)
+        {
+            for (CState State : States)
+            {
+                State.Clamp();
+                Count += State.CountProperties();
+            }
+        }
+
+        const auto End = std::chrono::steady_clock::now();
+        const double CallCount = static_cast<double>(Repeats) * StateCount;
+
+        std::cout << std::setw(5) << FactCount << std::fixed << std::setprecision(1);
+        std::cout << std::setw(14) << GetNanoseconds(HeuristicStart, ContradictionStart, CallCount);
+        std::cout << std::setw(16) << GetNanoseconds(ContradictionStart, ClampStart, CallCount * 2);
+        std::cout << std::setw(14) << GetNanoseconds(ClampStart, End, static_cast<double>(ClampRepeats) * StateCount);
+        std::cout << "    (" << CostSum << " " << Count << ")" << std::endl;
+    }
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void PrintUsage()
+{
+    std::cout << "Usage: LaneBenchmark [Repeats=N]\n";
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    int Repeats = 20000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string Argument = argv[i];
+        const size_t Separator = Argument.find('=');
+        if (Separator == std::string::npos || Argument.substr(0, Separator) != "Repeats")
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        Repeats = std::max(std::atoi(argv[i] + Separator + 1), 1);
+    }
+
+    std::cout << "Facts  Heuristic(ns)  Contradiction(ns)  Copy+Clamp(ns)" << std::endl;
+    for (int FactCount : {16, 64, 256})
+    {
+        RunSize(FactCount, Repeats);
+    }
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This example shows repetition macro nodes, which take an additive or multiplicative action as 
+// many times as needed in one step. An agent chops 5 wood at a time and needs 40 wood to build a 
+// cabin. Without repetition, the planners expand the intermediate amounts of wood one chop at a 
+// time. With it, the number of chops is solved from the effect and the precondition of building, so
+// the regressive planners find the plan in a few expansions. The forward planner also creates the 
+// macro node, but its heuristic only measures the distance to the goal, which says nothing about 
+// wood, so it still walks through the cheaper intermediate nodes first.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+
+#include "ArithGOAP/AdvRegressionPlanner.h"
+#include "ArithGOAP/ForwardPlanner.h"
+#include "ArithGOAP/Observer.h"
+#include "ArithGOAP/PlannerStats.h"
+#include "ArithGOAP/RegressionPlanner.h"
+#include "ExampleUtility/ExampleUtility.h"
+
+
+using namespace ArithGOAP;
+using VAR = ArithGOAP::SVariable;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TPlanner>
+void RunPlanner(int MaxRepetition, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
+{
+    CConsoleObserver Observer;
+    SPlannerStats Stats;
+    TPlanner Planner;
+    Planner.SetObserver(&Observer);
+    Planner.SetStats(&Stats);
+    Planner.SetMaxRepetition(MaxRepetition);
+
+    std::vector<const CAction*> Steps;
+    if (Planner.Plan(Steps, StartingState, GoalState, Actions, MaxDepth))
+    {
+        std::cout << "SUCCEEDED |";
+        for (int i = 0; i < Steps.size(); i++)
+        {
+            std::cout << (i > 0 ? " " : "") << Steps[i]->GetName();
+        }
+        std::cout << "| with " << Stats.ExpandedCount << " expansions" << std::endl << std::endl;
+    }
+    else
+    {
+        std::cout << "FAILED" << std::endl << std::endl;
+    }
+}
+
+int main()
+{
+    CFactDefinition Definition;
+    const auto& Wood  = *Definition.DefineNumber(VAR("Wood") >= 0);
+    const auto& Cabin = *Definition.DefineBoolean("Cabin");
+
+    CState StartingState(Definition);
+    StartingState.SetProperty(Wood == 0);
+    StartingState.SetProperty(Cabin == false);
+
+    CState GoalState(Definition);
+    GoalState.SetProperty(Cabin == true);
+
+    CAction Chop("Chop", Definition);
+    Chop.SetEffect(Wood += 5);
+
+    CAction Build("Build", Definition);
+    Build.SetPrecondition(Wood >= 40);
+    Build.SetEffect(Wood -= 40);
+    Build.SetEffect(Cabin = true);
+
+    const std::vector<const CAction*> Actions = {&Chop, &Build};
+    const int MaxDepth = 20;
+
+    for (int MaxRepetition : {1, 100})
+    {
+        std::cout << "MaxRepetition=" << MaxRepetition << std::endl << std::endl;
+        RunPlanner<CForwardPlanner>(MaxRepetition, StartingState, GoalState, Actions, MaxDepth);
+        RunPlanner<CRegressionPlanner>(MaxRepetition, StartingState, GoalState, Actions, MaxDepth);
+        RunPlanner<CAdvRegressionPlanner>(MaxRepetition, StartingState, GoalState, Actions, MaxDepth);
+    }
+
+    return 0;
+}
@@ -0,0 +1,194 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This example checks the segment lane kernels, which scan the bounds of states a block of 
+// properties at a time, against plain loops over the properties one by one. Random definitions mix
+// Boolean, enumeration and numeric facts, and random states hold degenerate, unbounded, infinite 
+// and NaN segments, some of which fall outside fact ranges narrowed after the states are filled.
+// Every kernel should agree with its loop on every pair of states.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ArithGOAP/Fact.h"
+#include "ArithGOAP/State.h"
+
+
+using namespace ArithGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+    std::mt19937 Random(7);
+
+    CNumber MakeNumber()
+    {
+        switch (Random() % 12)
+        {
+        case 0: return CNumber::Infinity;
+        case 1: return -CNumber::Infinity;
+        case 2: return CNumber::NaN;
+        case 3: return 1e300;
+        case 4: return 5.0 + 1e-15;
+        case 5: return 5.0;
+        case 6: return 0.0;
+        case 7: return -0.0;
+        default: return static_cast<double>(static_cast<int>(Random() % 20) - 10) / (1 + Random() % 3);
+        }
+    }
+
+    SSegment MakeSegment()
+    {
+        const int Kind = Random() % 4;
+        const CNumber Value = MakeNumber();
+        return Kind == 0 ? SSegment(Value) : SSegment(Value, MakeNumber());
+    }
+
+    // Set about two thirds of the properties, leaving those whose segments miss the fact ranges unset.
+    void FillState(CState& oState, const std::vector<CFact*>& Facts)
+    {
+        for (const CFact* Fact : Facts)
+        {
+            if (Random() % 3)
+            {
+                oState.SetProperty(*Fact, MakeSegment());
+            }
+        }
+    }
+
+    bool IsIdentical(const SSegment& Left, const SSegment& Right)
+    {
+        return Left.Minimum.GetBitwiseInteger() == Right.Minimum.GetBitwiseInteger() && Left.Maximum.GetBitwiseInteger() == Right.Maximum.GetBitwiseInteger();
+    }
+
+    // Same as CState::IsContradictory but one property at a time
+    bool IsContradictoryOneByOne(const CState& State, const CState& Another)
+    {
+        for (int FactIndex = 0; FactIndex < State.GetPropertyCapacity(); FactIndex++)
+        {
+            const SSegment Segment = State.GetProperty(FactIndex);
+            if (Segment.IsUnset())
+            {
+                continue;
+            }
+
+            const SSegment AnotherSegment = Another.GetProperty(FactIndex);
+            if (AnotherSegment.IsUnset() || !Segment.HasIntersection(AnotherSegment, State.GetDefinition().GetTolerance()))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Does a clamped state hold the segments of a given state clamped one property at a time?
+    bool IsClampedOneByOne(const CState& Clamped, const CState& State)
+    {
+        for (int FactIndex = 0; FactIndex < State.GetPropertyCapacity(); FactIndex++)
+        {
+            SSegment Segment = State.GetProperty(FactIndex);
+            if (Segment.IsSet())
+            {
+                State.GetDefinition().GetFact(FactIndex)->GetRange().Clamp(Segment);
+            }
+
+            if (!IsIdentical(Clamped.GetProperty(FactIndex), Segment))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Do the set properties of a state match those found one property at a time?
+    bool AreSetPropertiesListed(const CState& State)
+    {
+        std::vector<int> Listed;
+        for (int FactIndex : State.GetSetProperties())
+        {
+            Listed.push_back(FactIndex);
+        }
+
+        std::vector<int> Expected;
+        for (int FactIndex = 0; FactIndex < State.GetPropertyCapacity(); FactIndex++)
+        {
+            if (State.GetProperty(FactIndex).IsSet())
+            {
+                Expected.push_back(FactIndex);
+            }
+        }
+
+        return Listed == Expected && State.CountProperties() == static_cast<int>(Expected.size());
+    }
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    constexpr int DefinitionCount = 3000;
+    int ContradictionMismatches = 0;
+    int ClampMismatches = 0;
+    int ListMismatches = 0;
+
+    for (int DefinitionIndex = 0; DefinitionIndex < DefinitionCount; DefinitionIndex++)
+    {
+        // Cover both partial and full blocks of properties.
+        CFactDefinition Definition(1 + Random() % 3, (Random() % 2) ? CNumber::DefaultTolerance : CNumber(0.01));
+        std::vector<CFact*> Facts;
+        const int FactCount = 1 + Random() % 150;
+        for (int FactIndex = 0; FactIndex < FactCount; FactIndex++)
+        {
+            const std::string Name = "F" + std::to_string(FactIndex);
+            switch (Random() % 4)
+            {
+            case 0: Facts.push_back(Definition.DefineBoolean(Name)); break;
+            case 1: Facts.push_back(Definition.DefineEnumeration(Name, SSegment(0, 5))); break;
+            case 2: Facts.push_back(Definition.DefineNumber(Name, SSegment(-3, 7))); break;
+            default: Facts.push_back(Definition.DefineNumber(Name)); break;
+            }
+        }
+
+        CState State(Definition);
+        CState Another(Definition);
+        FillState(State, Facts);
+        FillState(Another, Facts);
+        if (Random() % 3 == 0)
+        {
+            // Share the set segments, so that some pairs are consistent in at least one direction.
+            for (const CFact* Fact : Facts)
+            {
+                const SSegment Segment = State.GetProperty(*Fact);
+                if (Segment.IsSet())
+                {
+                    Another.SetProperty(*Fact, Segment);
+                }
+            }
+        }
+
+        ContradictionMismatches += State.IsContradictory(Another) != IsContradictoryOneByOne(State, Another);
+        ContradictionMismatches += Another.IsContradictory(State) != IsContradictoryOneByOne(Another, State);
+        ListMismatches += !AreSetPropertiesListed(State) + !AreSetPropertiesListed(Another);
+
+        // Narrow some ranges so that clamping changes the states.
+        for (CFact* Fact : Facts)
+        {
+            if (Random() % 10 == 0)
+            {
+                Fact->SetRange((Random() % 2) ? SSegment(1, 4) : SSegment(-2, 3));
+            }
+        }
+
+        CState Clamped = State;
+        Clamped.Clamp();
+        ClampMismatches += !IsClampedOneByOne(Clamped, State);
+    }
+
+    std::cout << "Definitions: " << DefinitionCount << std::endl;
+    std::cout << "IsContradictory mismatches: " << ContradictionMismatches << std::endl;
+    std::cout << "Clamp mismatches: " << ClampMismatches << std::endl;
+    std::cout << "GetSetProperties mismatches: " << ListMismatches << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This example plans for many requests of mixed difficulty in a batch and compares the results with
+// planning for them one by one, for the forward and regressive planners with a few thread counts.
+//
+// Each domain hides a chain of actions like those of the benchmark, whose length sets the difficulty,
+// among distractors on other Boolean facts. Every fifth request limits the depth below the length of
+// the chain, so its search fails. The batch results should match the serial ones in request order,
+// including the failures, also when a batch reuses the results of the previous one.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ExtendedGOAP/Action.h"
+#include "ExtendedGOAP/BatchPlanner.h"
+#include "ExtendedGOAP/Condition.h"
+#include "ExtendedGOAP/Fact.h"
+#include "ExtendedGOAP/Formula.h"
+#include "ExtendedGOAP/ForwardPlanner.h"
+#include "ExtendedGOAP/Notation.h"
+#include "ExtendedGOAP/RegressionPlanner.h"
+#include "ExtendedGOAP/State.h"
+
+
+using namespace ExtendedGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct SDomain // A planning problem, which refers to its own fact definition and can't be copied
+{
+    CFactDefinition Definition;
+    std::unique_ptr<CState> StartingState;      // Created after all facts are defined
+    std::unique_ptr<CCondition> GoalCondition;
+    std::vector<CAction> Actions;
+    std::vector<const CAction*> ActionPtrs;
+};
+
+constexpr int RequestCount = 60;
+constexpr int FlagCount = 6;
+constexpr int DistractorCount = 8;
+constexpr int MaxChainLength = 5;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GenerateDomain(SDomain& oDomain, int ChainLength, std::mt19937& Random)
+{
+    auto RandomInt = [&Random](int Count) { return static_cast<int>(Random() % static_cast<unsigned>(Count)); };
+
+    std::vector<const CBooleanFact*> ChainFacts;
+    std::vector<const CBooleanFact*> Flags;
+    for (int i = 0; i <= ChainLength; i++)
+    {
+        ChainFacts.push_back(oDomain.Definition.DefineBoolean("Chain" + std::to_string(i)));
+    }
+    for (int i = 0; i < FlagCount; i++)
+    {
+        Flags.push_back(oDomain.Definition.DefineBoolean("Flag" + std::to_string(i)));
+    }
+
+    oDomain.StartingState = std::make_unique<CState>(oDomain.Definition);
+    for (int i = 0; i <= ChainLength; i++)
+    {
+        oDomain.StartingState->SetProperty(*ChainFacts[i], i == 0);
+    }
+    for (const CBooleanFact* Flag : Flags)
+    {
+        oDomain.StartingState->SetProperty(*Flag, RandomInt(2) == 1);
+    }
+
+    oDomain.GoalCondition = std::make_unique<CCondition>(oDomain.Definition);
+    oDomain.GoalCondition->SetConstraint(*ChainFacts.back() == true);
+
+    oDomain.Actions.reserve(ChainLength + DistractorCount);
+    for (int i = 0; i < ChainLength; i++)
+    {
+        CAction& Action = oDomain.Actions.emplace_back("Step" + std::to_string(i), oDomain.Definition);
+        Action.SetPrecondition(*ChainFacts[i] == true);
+        Action.AddEffect(*ChainFacts[i + 1] = true);
+    }
+    for (int i = 0; i < DistractorCount; i++)
+    {
+        CAction& Action = oDomain.Actions.emplace_back("Act" + std::to_string(i), oDomain.Definition);
+        Action.SetBaseCost(static_cast<float>(1 + RandomInt(3)));
+        Action.SetPrecondition(*Flags[RandomInt(FlagCount)] == (RandomInt(2) == 1));
+        Action.AddEffect(*Flags[RandomInt(FlagCount)] = (RandomInt(2) == 1));
+    }
+
+    for (const CAction& Action : oDomain.Actions)
+    {
+        oDomain.ActionPtrs.push_back(&Action);
+    }
+}
+
+void RunBatch(const char* PlannerName, const CBatchPlanner::CPlannerFactory& Factory, const std::vector<SPlanRequest>& Requests)
+{
+    std::vector<SPlanResult> SerialResults(Requests.size());
+    std::unique_ptr<CBasePlanner> SerialPlanner = Factory();
+    int Successes = 0;
+    for (size_t i = 0; i < Requests.size(); i++)
+    {
+        const SPlanRequest& Request = Requests[i];
+        SerialResults[i].Succeeded = SerialPlanner->Plan(SerialResults[i].Steps, *Request.StartingState, *Request.GoalCondition, *Request.Actions, Request.MaxDepth);
+        Successes += SerialResults[i].Succeeded;
+    }
+
+    std::cout << PlannerName << ": " << Successes << " of " << Requests.size() << " requests planned serially\n";
+
+    std::vector<SPlanResult> Results;
+    for (int ThreadCount : {1, 2, 4})
+    {
+        CBatchPlanner BatchPlanner(Factory, ThreadCount);
+        int Matches = 0;
+        for (int Round = 0; Round < 2; Round++) // The second round reuses the results of the first.
+        {
+            BatchPlanner.BatchPlan(Results, Requests);
+            for (size_t i = 0; i < Requests.size(); i++)
+            {
+                Matches += Results[i].Succeeded == SerialResults[i].Succeeded && Results[i].Steps == SerialResults[i].Steps;
+            }
+        }
+
+        std::cout << "    " << BatchPlanner.GetThreadCount() << " thread(s): " << Matches << "/" << 2 * Requests.size() << " results as serial\n";
+    }
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::mt19937 Random(7);
+    std::vector<std::unique_ptr<SDomain>> Domains;
+    std::vector<SPlanRequest> Requests;
+    for (int i = 0; i < RequestCount; i++)
+    {
+        const int ChainLength = 1 + i % MaxChainLength;
+        SDomain& Domain = *Domains.emplace_back(std::make_unique<SDomain>());
+        GenerateDomain(Domain, ChainLength, Random);
+
+        SPlanRequest& Request = Requests.emplace_back();
+        Request.StartingState = Domain.StartingState.get();
+        Request.GoalCondition = Domain.GoalCondition.get();
+        Request.Actions = &Domain.ActionPtrs;
+        Request.MaxDepth = (i % 5 == 4) ? ChainLength - 1 : ChainLength + 1; // Every fifth request can't reach the end of the chain.
+    }
+
+    RunBatch("Forward", [] { return std::make_unique<CForwardPlanner>(); }, Requests);
+    RunBatch("Regressive", [] { return std::make_unique<CRegressionPlanner>(); }, Requests);
+    return 0;
+}
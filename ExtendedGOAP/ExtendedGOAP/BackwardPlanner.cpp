@@ -8,6 +8,7 @@
 #include "BackwardPlanner.h"
 #include "BitVector.h"
 #include "Fact.h"
+#include "PlannerStats.h"
 #include "State.h"
 
 
@@ -43,80 +44,97 @@ std::string CBackwardPlanner::SNode::ToString() const
     return Stream.str();
 }
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-bool CBackwardPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CState& StartingState, CCondition& GoalCondition, std::vector<CAction*>& Actions, int MaxDepth)
+void CBackwardPlanner::BeginSearch()
 {
-    int Step = 0;
-    oSteps.clear();
-    mNodes.reserve(Actions.size() * MaxDepth);
+    mNodes.swap(mWorkspace->GetScratch<SNodeScratch>().Nodes); // Borrow the search tree of the workspace until PostPlan.
+    mNodes.reserve(mSearchActions.size() * mMaxDepth);
 
     if (ShouldPrintExcessiveHeuristic())
     {
-        mPathGetter = [&](int NodeIndex)
+        mPathGetter = [this](int NodeIndex)
         {
             const SNode& Node = mNodes[NodeIndex];
-            bool Reached = GoalCondition.IsSatisfiedBy(*Node.ConstState);
+            bool Reached = mGoalCondition->IsSatisfiedBy(*Node.ConstState);
             return StringizeBackwardPath(mNodes, NodeIndex, Reached);
         };
     }
 
     SNode& RootNode = mNodes.emplace_back();
-    RootNode.ConstState = &StartingState;
-    RootNode.DesiredFactBits = GoalCondition.GetUsedFactBits();
-    RootNode.BaseHeuristicCost = GetBaseHeuristicCost(StartingState, GoalCondition, 0);
-    RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalCondition);
+    RootNode.ConstState = mStartingState;
+    RootNode.DesiredFactBits = mGoalCondition->GetUsedFactBits();
+    RootNode.BaseHeuristicCost = GetBaseHeuristicCost(*mStartingState, *mGoalCondition, 0);
+    RootNode.ExtraHeuristicCost = mStartingState->GetExtraHeuristicCost(*mGoalCondition);
+    mWorkspace->GetOpenList().Push(RootNode.GetTotalCost(), 0);
+}
 
-    std::multimap<float, int> OpenMap; // The open set in A*
-    OpenMap.emplace(RootNode.GetTotalCost(), 0);
+EPlanStatus CBackwardPlanner::ExpandNext()
+{
+    COpenList& OpenList = mWorkspace->GetOpenList(); // The open set in A*
+    if (OpenList.IsEmpty())
+    {
+        return EPlanStatus::failed;
+    }
 
-    while (!OpenMap.empty())
+    if (mStats)
     {
-        auto itCurr = OpenMap.begin();
-        const int CurrIndex = itCurr->second;
-        OpenMap.erase(itCurr);
-        SNode& CurrNode = mNodes[CurrIndex];
+        mStats->AddExpansion(OpenList.GetSize());
+    }
 
-        bool Reached = GoalCondition.IsSatisfiedBy(*CurrNode.ConstState);
-        if (mFlags & ShowSteps)
-        {
-            std::cout << "#" << ++Step << " #Nodes=" << mNodes.size();
-            std::cout << ' ' << StringizeBackwardPath(mNodes, CurrIndex, Reached) << ' ';
-            std::cout << CurrNode.ToString() << std::endl;
-        }
-        if (Reached)
-        {
-            if (mFlags & ShowFinalOpenNodes)
-            {
-                std::cout << StringizeNodes(OpenMap, GoalCondition);
-            }
-            
-            BuildBackwardPlan(oSteps, mNodes, CurrIndex);
-            return true;
-        }
+    const int CurrIndex = OpenList.Pop();
+    SNode& CurrNode = mNodes[CurrIndex];
+    mExpansionCount++;
 
-        if (CurrNode.Depth >= MaxDepth)
+    CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime);
+    bool Reached = mGoalCondition->IsSatisfiedBy(*CurrNode.ConstState);
+    GoalTestTimer.Stop();
+    if (mFlags & ShowSteps)
+    {
+        std::cout << "#" << mExpansionCount << " #Nodes=" << mNodes.size();
+        std::cout << ' ' << StringizeBackwardPath(mNodes, CurrIndex, Reached) << ' ';
+        std::cout << CurrNode.ToString() << std::endl;
+    }
+    if (Reached)
+    {
+        if (mFlags & ShowFinalOpenNodes)
         {
-            continue;
+            std::cout << StringizeNodes(OpenList, *mGoalCondition);
         }
+        
+        BuildBackwardPlan(mSteps, mNodes, CurrIndex);
+        return EPlanStatus::succeeded;
+    }
 
-        for (const CAction* Action : Actions)
+    if (CurrNode.Depth < mMaxDepth)
+    {
+        for (const CAction* Action : mSearchActions)
         {
-            Explore(OpenMap, CurrIndex, *Action, StartingState, GoalCondition);
+            Explore(OpenList, CurrIndex, *Action, *mStartingState, *mGoalCondition);
         }
     }
 
-    return false;
+    return OpenList.IsEmpty() ? EPlanStatus::failed : EPlanStatus::searching;
 }
 
 void CBackwardPlanner::PostPlan()
 {
     mNodes.clear();
+    mNodes.swap(mWorkspace->GetScratch<SNodeScratch>().Nodes); // Return the search tree to the workspace.
 }
 
-void CBackwardPlanner::Explore(std::multimap<float, int>& oOpenMap, int NodeIndex, const CAction& Action, const CState& StartingState, const CCondition& GoalCondition)
+void CBackwardPlanner::Explore(COpenList& oOpenList, int NodeIndex, const CAction& Action, const CState& StartingState, const CCondition& GoalCondition)
 {
     const CCondition& Precondition = Action.GetPrecondition();
     const CEffect& Effect = Action.GetEffect();
-    if (!Effect.HasAnyTransform(mNodes[NodeIndex].DesiredFactBits))
+    CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
+    const bool Relevant = Effect.HasAnyTransform(mNodes[NodeIndex].DesiredFactBits);
+    PreconditionTimer.Stop();
+
+    if (mStats)
+    {
+        mStats->AddCheck(Action, Relevant);
+    }
+
+    if (!Relevant)
     {
         return;
     }
@@ -125,21 +143,30 @@ void CBackwardPlanner::Explore(std::multimap<float, int>& oOpenMap, int NodeInde
     SNode& ChildNode = mNodes.emplace_back();
     SNode& CurrNode = mNodes[NodeIndex];
     ChildNode.Action = &Action;
-    ChildNode.MutableState = StartingState.Clone();
-    ChildNode.ConstState = ChildNode.MutableState.get();
+    CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+    ChildNode.MutableState = StartingState.CloneInto(mWorkspace->GetStateArena());
+    ChildNode.ConstState = ChildNode.MutableState;
     ChildNode.Parent = NodeIndex;
     ChildNode.Depth = CurrNode.Depth + 1;
     ApplyEffectsOnPath(*ChildNode.MutableState, ChildIndex); // TODO: Avoid exploring infeasible paths.
     Action.Affect(*ChildNode.MutableState);    
+    CloneTimer.Stop();
     ChildNode.DesiredFactBits = CurrNode.DesiredFactBits 
         | Effect.GetAffectingFactBits(CurrNode.DesiredFactBits) 
         | Precondition.GetUsedFactBits();
     ChildNode.PreviousCost = CurrNode.GetActualCost();
     ChildNode.CurrentCost = Action.GetCost(*CurrNode.ConstState, *ChildNode.ConstState);
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
     ChildNode.BaseHeuristicCost = GetBaseHeuristicCost(*ChildNode.ConstState, GoalCondition, ChildIndex);
     ChildNode.ExtraHeuristicCost = ChildNode.ConstState->GetExtraHeuristicCost(GoalCondition);
+    HeuristicTimer.Stop();
     float TotalCost = ChildNode.GetTotalCost();
-    oOpenMap.emplace(TotalCost, ChildIndex);
+    oOpenList.Push(TotalCost, ChildIndex);
 }
 
 bool CBackwardPlanner::ApplyEffectsOnPath(CState& oState, int NodeIndex)
@@ -160,11 +187,11 @@ bool CBackwardPlanner::ApplyEffectsOnPath(CState& oState, int NodeIndex)
     return true;
 }
 
-std::string CBackwardPlanner::StringizeNodes(const std::multimap<float, int>& OpenMap, const CCondition& GoalCondition) const
+std::string CBackwardPlanner::StringizeNodes(const COpenList& OpenList, const CCondition& GoalCondition) const
 {
     std::string Return;
 
-    for (auto [Cost, NodeIndex] : OpenMap)
+    for (auto [Cost, NodeIndex] : OpenList.GetSortedEntries())
     {
         const SNode& CurrNode = mNodes[NodeIndex];
         Return += "Nodes[";
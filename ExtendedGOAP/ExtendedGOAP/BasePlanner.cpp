@@ -1,13 +1,16 @@
 // Copyright 2026 Isaac Hsu
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <typeinfo>
 
 #include "BasePlanner.h"
 #include "Action.h"
 #include "Fact.h"
+#include "PlannerStats.h"
 #include "State.h"
 
 
@@ -15,7 +18,37 @@ using namespace ExtendedGOAP;
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool CBasePlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CCondition& GoalCondition, const std::vector<const CAction*>& Actions, int MaxDepth)
 {
-    MaxDepth = std::max(MaxDepth, 0);
+    return Plan(oSteps, StartingState, GoalCondition, Actions, MaxDepth, mDefaultWorkspace);
+}
+
+bool CBasePlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CCondition& GoalCondition, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace)
+{
+    Begin(StartingState, GoalCondition, Actions, MaxDepth, Workspace);
+    Step(std::numeric_limits<int>::max());
+
+    bool Return = GetResult(oSteps);
+    End();
+    return Return;
+}
+
+void CBasePlanner::Begin(const CState& StartingState, const CCondition& GoalCondition, const std::vector<const CAction*>& Actions, int MaxDepth)
+{
+    Begin(StartingState, GoalCondition, Actions, MaxDepth, mDefaultWorkspace);
+}
+
+void CBasePlanner::Begin(const CState& StartingState, const CCondition& GoalCondition, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace)
+{
+    End();
+
+    mWorkspace = &Workspace;
+    mWorkspace->Clear();
+    mStartingState = &StartingState;
+    mActions = Actions;
+    mMaxDepth = std::max(MaxDepth, 0);
+    if (mStats)
+    {
+        mStats->Reset();
+    }
     mDebugInfo.Clear();
 
     if (mFlags & ShowMethodName)
@@ -34,46 +67,133 @@ bool CBasePlanner::Plan(std::vector<const CAction*>& oSteps, const CState& Start
     // It's difficult to estimate the heuristic for logical formulas with negation. 
     // Thus, we apply De Morgan's laws to push logical NOTs into the inner relational expressions.  
     // So, we only need to calculate the heuristics for negated relational expressions instead.
-    std::unique_ptr<CCondition> ModifiedGoal = GoalCondition.Clone(); // Clone the goal for later modification.
-    ModifiedGoal->GetConstraint().ApplyDeMorgansLaws();
+    mGoalCondition = GoalCondition.Clone(); // Clone the goal for later modification.
+    mGoalCondition->GetConstraint().ApplyDeMorgansLaws();
 
-    std::vector<std::unique_ptr<CAction>> ModifiedActions;  // A vector for holding cloned actions
-    std::vector<CAction*> ModifiableActions;                // A modifiable vector of non-const actions to pass to DoPlan
-    ModifiedActions.reserve(Actions.size());
-    ModifiableActions.reserve(Actions.size());
+    mModifiedActions.reserve(Actions.size());
+    mSearchActions.reserve(Actions.size());
     for (const CAction* Action : Actions)
     {
         std::unique_ptr<CAction> ModifiedAction = Action->Clone(); // Clone the action for later modification.
         ModifiedAction->GetPrecondition().GetConstraint().ApplyDeMorgansLaws();
-        auto& ModifiableAction = ModifiedActions.emplace_back(std::move(ModifiedAction));
-        ModifiableActions.push_back(ModifiableAction.get());
+        auto& ModifiableAction = mModifiedActions.emplace_back(std::move(ModifiedAction));
+        mSearchActions.push_back(ModifiableAction.get());
+    }
+
+    PrePlan(StartingState, *mGoalCondition, mSearchActions);
+
+    mStatus = EPlanStatus::searching;
+    BeginSearch();
+}
+
+EPlanStatus CBasePlanner::Step(int MaxExpansions)
+{
+    if (mStatus != EPlanStatus::searching)
+    {
+        return mStatus;
+    }
+
+    for (int Expansion = 0; Expansion < MaxExpansions && mStatus == EPlanStatus::searching; Expansion++)
+    {
+        mStatus = ExpandNext();
+    }
+
+    if (mStatus != EPlanStatus::searching)
+    {
+        FinishSearch();
+    }
+
+    return mStatus;
+}
+
+EPlanStatus CBasePlanner::Step(std::chrono::steady_clock::time_point Deadline)
+{
+    if (mStatus != EPlanStatus::searching)
+    {
+        return mStatus;
+    }
+
+    do
+    {
+        mStatus = ExpandNext();
+    }
+    while (mStatus == EPlanStatus::searching && std::chrono::steady_clock::now() < Deadline);
+
+    if (mStatus != EPlanStatus::searching)
+    {
+        FinishSearch();
+    }
+
+    return mStatus;
+}
+
+bool CBasePlanner::GetResult(std::vector<const CAction*>& oSteps) const
+{
+    if (mStatus != EPlanStatus::succeeded)
+    {
+        oSteps.clear();
+        return false;
     }
 
-    PrePlan(StartingState, *ModifiedGoal, ModifiableActions);
-    bool Return = DoPlan(oSteps, StartingState, *ModifiedGoal, ModifiableActions, MaxDepth);
+    oSteps = mSteps;
+    return true;
+}
+
+void CBasePlanner::End()
+{
+    if (mStatus == EPlanStatus::idle)
+    {
+        return;
+    }
+
+    PostPlan();
+    mDebugInfo.Clear();
+    mPathGetter = nullptr;
+    if (mStats)
+    {
+        mStats->MapActions(mModifiedActions, mActions); // The clones are destroyed below.
+    }
+
+    mStatus = EPlanStatus::idle;
+    mStartingState = nullptr;
+    mGoalCondition.reset();
+    mActions.clear();
+    mModifiedActions.clear();
+    mSearchActions.clear();
+    mExpansionCount = 0;
+    mWorkspace->GetOpenList().Clear();
+    mWorkspace = nullptr;
+    mSteps.clear();
+}
+
+void CBasePlanner::FinishSearch()
+{
+    // Map the steps from the cloned actions, which are destroyed at the end of the search, back to the given actions.
+    for (const CAction*& Step : mSteps)
+    {
+        auto itClone = std::find_if(mModifiedActions.begin(), mModifiedActions.end(), [Step](const std::unique_ptr<CAction>& Clone) { return Clone.get() == Step; });
+        if (itClone != mModifiedActions.end())
+        {
+            Step = mActions[itClone - mModifiedActions.begin()];
+        }
+    }
 
     if (ShouldPrintExcessiveHeuristic())
     {
-        PrintExcessiveHeuristic(StartingState.GetDefinition());
+        PrintExcessiveHeuristic(mStartingState->GetDefinition());
     }
 
     if (mFlags & ShowResult)
     {
-        if (Return)
+        if (mStatus == EPlanStatus::succeeded)
         {
-            std::cout << "SUCCEEDED |" << StringizeSteps(oSteps) << "| \n";
+            std::cout << "SUCCEEDED |" << StringizeSteps(mSteps) << "| \n";
         }
         else
         {
             std::cout << "FAILED\n";
         }
     }
-
-    PostPlan();
-    mDebugInfo.Clear();
-    mPathGetter = nullptr;
-
-    return Return;
 }
 
 void CBasePlanner::PrePlan(const CState& StartingState, CCondition& GoalCondition, std::vector<CAction*>& Actions)
@@ -2,18 +2,32 @@
 
 #pragma once
 
+#include <chrono>
 #include <functional>
+#include <memory>
+#include <vector>
 
+#include "Action.h"
 #include "Common.h"
+#include "Condition.h"
 #include "Debug.h"
+#include "OpenList.h"
+#include "Workspace.h"
 
 
 namespace ExtendedGOAP
 {
-    class CAction;
-    class CCondition;
     class CFactDefinition;
     class CState;
+    struct SPlannerStats;
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    enum class EPlanStatus : unsigned char // Enum of the statuses of resumable searches
+    {
+        idle,       // No search has begun.
+        searching,  // The search needs more steps.
+        succeeded,
+        failed
+    };
     ///////////////////////////////////////////////////////////////////////////////////////////////
     class CBasePlanner // Base class for GOAP planners
     {
@@ -38,13 +52,41 @@ namespace ExtendedGOAP
         explicit CBasePlanner(unsigned Flags = 0) : mFlags(Flags) {}
         virtual ~CBasePlanner() {}
 
+        // Formulate a plan from the input if possible. Return true if successful.
         bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CCondition& GoalCondition, const std::vector<const CAction*>& Actions, int MaxDepth);
+        // Same as above but with the buffers of a given workspace, which keeps their capacity for later calls.
+        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CCondition& GoalCondition, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace);
+
+        // Begin a resumable search, which can be stepped across frames. The starting state and actions must outlive the search.
+        void Begin(const CState& StartingState, const CCondition& GoalCondition, const std::vector<const CAction*>& Actions, int MaxDepth);
+        // Same as above but with the buffers of a given workspace, which must outlive the search and not be used by other searches meanwhile.
+        void Begin(const CState& StartingState, const CCondition& GoalCondition, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace);
+        // Expand at most a given number of nodes and return the status of the search.
+        EPlanStatus Step(int MaxExpansions);
+        // Expand nodes until a deadline passes and return the status of the search. At least one node is expanded per call.
+        EPlanStatus Step(std::chrono::steady_clock::time_point Deadline);
+        EPlanStatus GetStatus() const { return mStatus; }
+        // Return the number of the nodes expanded by the current search.
+        int GetExpansionCount() const { return mExpansionCount; }
+        // Copy the plan of a succeeded search. Return true if successful.
+        bool GetResult(std::vector<const CAction*>& oSteps) const;
+        // Release the nodes and the input of the search. Begin ends the previous search implicitly.
+        void End();
+        // Collect the statistics of each search into a given instance, or stop collecting them with null.
+        // The applicable counts are keyed by clones of the given actions until the search ends.
+        void SetStats(SPlannerStats* Value) { mStats = Value; }
 
     protected:
         virtual void PrePlan(const CState& StartingState, CCondition& GoalCondition, std::vector<CAction*>& Actions);
-        virtual bool DoPlan(std::vector<const CAction*>& oSteps, const CState& StartingState, CCondition& GoalCondition, std::vector<CAction*>& Actions, int MaxDepth) = 0;
+        // Create the root node from the input of the search.
+        virtual void BeginSearch() = 0;
+        // Expand the best open node. Return succeeded after building the plan, failed if no open nodes are left, or searching otherwise.
+        virtual EPlanStatus ExpandNext() = 0;
         virtual void PostPlan() {}
 
+        // Map the plan back to the given actions and print the result.
+        void FinishSearch();
+
         std::string StringizeSteps(const std::vector<const CAction*>& Steps) const;
         bool ShouldPrintExcessiveHeuristic() const { return mFlags & ShowExcessiveHeuristic; }
         void PrintExcessiveHeuristic(const CFactDefinition& Definition) const;
@@ -62,6 +104,20 @@ namespace ExtendedGOAP
         unsigned mFlags = 0;
         SDebugInfo mDebugInfo;
         std::function<std::string (int NodeIndex)> mPathGetter;
+
+        // Input and progress of the current search, kept between steps
+        EPlanStatus mStatus = EPlanStatus::idle;
+        const CState* mStartingState = nullptr;
+        std::unique_ptr<CCondition> mGoalCondition;             // The goal modified for the search
+        std::vector<const CAction*> mActions;                   // The given actions
+        std::vector<std::unique_ptr<CAction>> mModifiedActions; // Clones of the given actions in the same order, modified for the search
+        std::vector<CAction*> mSearchActions;                   // The modified actions to search, which PrePlan may remove some of
+        int mMaxDepth = 0;
+        int mExpansionCount = 0;                                // Number of the expanded nodes
+        CPlannerWorkspace* mWorkspace = nullptr;                // Workspace of the current search
+        CPlannerWorkspace mDefaultWorkspace;                    // Workspace of the searches without a given one
+        std::vector<const CAction*> mSteps;                     // The plan of a succeeded search
+        SPlannerStats* mStats = nullptr;                        // Optional statistics of the last search
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
     template <typename TNode>
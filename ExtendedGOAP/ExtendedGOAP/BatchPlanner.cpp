@@ -0,0 +1,46 @@
+// Copyright 2026 Isaac Hsu
+
+#include "Action.h"
+#include "BatchPlanner.h"
+#include "Condition.h"
+#include "State.h"
+
+
+using namespace ExtendedGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+CBatchPlanner::CBatchPlanner(const CPlannerFactory& Factory, int ThreadCount)
+    : mThreadPool(ThreadCount)
+{
+    mPlanners.reserve(mThreadPool.GetThreadCount());
+    for (int WorkerIndex = 0; WorkerIndex < mThreadPool.GetThreadCount(); WorkerIndex++)
+    {
+        mPlanners.push_back(Factory());
+    }
+}
+
+std::vector<SPlanResult> CBatchPlanner::BatchPlan(const std::vector<SPlanRequest>& Requests)
+{
+    std::vector<SPlanResult> Results;
+    BatchPlan(Results, Requests);
+    return Results;
+}
+
+void CBatchPlanner::BatchPlan(std::vector<SPlanResult>& oResults, const std::vector<SPlanRequest>& Requests)
+{
+    oResults.resize(Requests.size());
+
+    // Submit a task per request. Work stealing balances the uneven costs of plans among the workers.
+    for (size_t RequestIndex = 0; RequestIndex < Requests.size(); RequestIndex++)
+    {
+        mThreadPool.Submit([this, &oResults, &Requests, RequestIndex](int WorkerIndex)
+        {
+            const SPlanRequest& Request = Requests[RequestIndex];
+            SPlanResult& Result = oResults[RequestIndex];
+            Result.Steps.clear();
+            Result.Succeeded = mPlanners[WorkerIndex]->Plan(Result.Steps, *Request.StartingState, *Request.GoalCondition, *Request.Actions, Request.MaxDepth);
+        });
+    }
+
+    mThreadPool.Wait();
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,55 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "BasePlanner.h"
+#include "ThreadPool.h"
+
+
+namespace ExtendedGOAP
+{
+    class CAction;
+    class CCondition;
+    class CState;
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct SPlanRequest // Input of a plan, which must stay alive and unchanged until the batch is finished
+    {
+        const CState* StartingState = nullptr;
+        const CCondition* GoalCondition = nullptr;
+        const std::vector<const CAction*>* Actions = nullptr;
+        int MaxDepth = 0;
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct SPlanResult
+    {
+        bool Succeeded = false;
+        std::vector<const CAction*> Steps;
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Planner formulating plans for many requests in parallel.
+    // Planners keep their nodes as members and are not reentrant, so each worker thread owns a planner, which also reuses its buffers across requests.
+    class CBatchPlanner
+    {
+    public:
+        using CPlannerFactory = std::function<std::unique_ptr<CBasePlanner>()>;
+
+        // Create a planner per worker with a given factory. Use one worker per hardware thread if the thread count is not positive.
+        explicit CBatchPlanner(const CPlannerFactory& Factory, int ThreadCount = 0);
+
+        int GetThreadCount() const { return mThreadPool.GetThreadCount(); }
+
+        // Formulate plans for the requests in parallel. The results are in the order of the requests.
+        std::vector<SPlanResult> BatchPlan(const std::vector<SPlanRequest>& Requests);
+        // Same as above but with a given result vector, which keeps the capacity of its plans for later calls.
+        void BatchPlan(std::vector<SPlanResult>& oResults, const std::vector<SPlanRequest>& Requests);
+
+    private:
+        std::vector<std::unique_ptr<CBasePlanner>> mPlanners; // Planners indexed by workers
+        CThreadPool mThreadPool;
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
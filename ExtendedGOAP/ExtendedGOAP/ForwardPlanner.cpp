@@ -1,12 +1,12 @@
 // Copyright 2026 Isaac Hsu
 
 #include <iostream>
-#include <map>
 #include <sstream>
 
 #include "Action.h"
 #include "Condition.h"
 #include "Fact.h"
+#include "PlannerStats.h"
 #include "ForwardPlanner.h"
 #include "State.h"
 
@@ -31,80 +31,105 @@ std::string CForwardPlanner::SNode::ToString() const
     return Stream.str();
 }
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-bool CForwardPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CState& StartingState, CCondition& GoalCondition, std::vector<CAction*>& Actions, int MaxDepth)
+void CForwardPlanner::BeginSearch()
 {
-    int Step = 0;
-    oSteps.clear();
-    mNodes.reserve(Actions.size() * MaxDepth);
+    mNodes.swap(mWorkspace->GetScratch<SNodeScratch>().Nodes); // Borrow the search tree of the workspace until PostPlan.
+    mNodes.reserve(mSearchActions.size() * mMaxDepth);
 
     if (ShouldPrintExcessiveHeuristic())
     {
-        mPathGetter = [&](int NodeIndex)
+        mPathGetter = [this](int NodeIndex)
         {
             return StringizeForwardPath(NodeIndex);
         };
     }
 
     SNode& RootNode = mNodes.emplace_back();
-    RootNode.ConstState = &StartingState;
-    RootNode.BaseHeuristicCost = GetBaseHeuristicCost(StartingState, GoalCondition, 0);
-    RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalCondition);
-
-    std::multimap<float, int> OpenMap; // The open set in A*
-    OpenMap.emplace(RootNode.GetTotalCost(), 0);
+    RootNode.ConstState = mStartingState;
+    RootNode.BaseHeuristicCost = GetBaseHeuristicCost(*mStartingState, *mGoalCondition, 0);
+    RootNode.ExtraHeuristicCost = mStartingState->GetExtraHeuristicCost(*mGoalCondition);
+    mWorkspace->GetOpenList().Push(RootNode.GetTotalCost(), 0);
+}
 
-    while (!OpenMap.empty())
+EPlanStatus CForwardPlanner::ExpandNext()
+{
+    COpenList& OpenList = mWorkspace->GetOpenList(); // The open set in A*
+    if (OpenList.IsEmpty())
     {
-        auto itCurr = OpenMap.begin();
-        const int CurrIndex = itCurr->second;
-        OpenMap.erase(itCurr);
-        SNode& CurrNode = mNodes[CurrIndex];
+        return EPlanStatus::failed;
+    }
 
-        if (mFlags & ShowSteps)
-        {
-            std::cout << "#" << ++Step << " #Nodes=" << mNodes.size();
-            std::cout << ' ' << StringizeForwardPath(CurrIndex) << ' ' << CurrNode.ToString() << std::endl;
-        }
+    if (mStats)
+    {
+        mStats->AddExpansion(OpenList.GetSize());
+    }
 
-        if (GoalCondition.IsSatisfiedBy(*CurrNode.ConstState))
-        {
-            if (mFlags & ShowFinalOpenNodes)
-            {
-                std::cout << StringizeNodes(OpenMap, GoalCondition);
-            }
+    const int CurrIndex = OpenList.Pop();
+    SNode& CurrNode = mNodes[CurrIndex];
+    mExpansionCount++;
 
-            BuildForwardPlan(oSteps, CurrIndex);
-            return true;
-        }
+    if (mFlags & ShowSteps)
+    {
+        std::cout << "#" << mExpansionCount << " #Nodes=" << mNodes.size();
+        std::cout << ' ' << StringizeForwardPath(CurrIndex) << ' ' << CurrNode.ToString() << std::endl;
+    }
 
-        if (CurrNode.Depth >= MaxDepth)
+    CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime);
+    const bool Reached = mGoalCondition->IsSatisfiedBy(*CurrNode.ConstState);
+    GoalTestTimer.Stop();
+    if (Reached)
+    {
+        if (mFlags & ShowFinalOpenNodes)
         {
-            continue;
+            std::cout << StringizeNodes(OpenList, *mGoalCondition);
         }
 
-        for (const CAction* Action : Actions)
+        BuildForwardPlan(mSteps, CurrIndex);
+        return EPlanStatus::succeeded;
+    }
+
+    if (CurrNode.Depth < mMaxDepth)
+    {
+        for (const CAction* Action : mSearchActions)
         {
-            Explore(OpenMap, CurrIndex, *Action, GoalCondition);
+            Explore(OpenList, CurrIndex, *Action, *mGoalCondition);
         }
     }
 
-    return false;
+    return OpenList.IsEmpty() ? EPlanStatus::failed : EPlanStatus::searching;
 }
 
 void CForwardPlanner::PostPlan()
 {
     mNodes.clear();
+    mNodes.swap(mWorkspace->GetScratch<SNodeScratch>().Nodes); // Return the search tree to the workspace.
 }
 
-void CForwardPlanner::Explore(std::multimap<float, int>& oOpenMap, int NodeIndex, const CAction& Action, const CCondition& GoalCondition)
+void CForwardPlanner::Explore(COpenList& oOpenList, int NodeIndex, const CAction& Action, const CCondition& GoalCondition)
 {
-    if (!Action.CheckPrecondition(*mNodes[NodeIndex].ConstState))
+    CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
+    bool Applicable = Action.CheckPrecondition(*mNodes[NodeIndex].ConstState);
+    PreconditionTimer.Stop();
+
+    CStateArena& StateArena = mWorkspace->GetStateArena();
+    CState* MutableState = nullptr;
+    if (Applicable)
     {
-        return;
+        CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+        MutableState = mNodes[NodeIndex].ConstState->CloneInto(StateArena);
+        Applicable = Action.GetEffect().ApplyTo(*MutableState);
+        if (!Applicable)
+        {
+            StateArena.DestroyLast();
+        }
     }
 
-    auto MutableState = mNodes[NodeIndex].ConstState->Clone();
-    if (!Action.GetEffect().ApplyTo(*MutableState))
+    if (mStats)
+    {
+        mStats->AddCheck(Action, Applicable); // Count an action rejected by its effect once, like one rejected by its precondition.
+    }
+
+    if (!Applicable)
     {
         return;
     }
@@ -113,24 +138,31 @@ void CForwardPlanner::Explore(std::multimap<float, int>& oOpenMap, int NodeIndex
     SNode& ChildNode = mNodes.emplace_back();
     SNode& CurrNode = mNodes[NodeIndex];
     ChildNode.Action = &Action;
-    ChildNode.MutableState = std::move(MutableState);
+    ChildNode.MutableState = MutableState;
     Action.Affect(*ChildNode.MutableState);
-    ChildNode.ConstState = ChildNode.MutableState.get();
+    ChildNode.ConstState = ChildNode.MutableState;
     ChildNode.Parent = NodeIndex;
     ChildNode.Depth = CurrNode.Depth + 1;
     ChildNode.PreviousCost = CurrNode.GetActualCost();
     ChildNode.CurrentCost = Action.GetCost(*CurrNode.ConstState, *ChildNode.ConstState);
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
     ChildNode.BaseHeuristicCost = GetBaseHeuristicCost(*ChildNode.ConstState, GoalCondition, ChildIndex);
     ChildNode.ExtraHeuristicCost = ChildNode.ConstState->GetExtraHeuristicCost(GoalCondition);
+    HeuristicTimer.Stop();
     float TotalCost = ChildNode.GetTotalCost();
-    oOpenMap.emplace(TotalCost, ChildIndex);
+    oOpenList.Push(TotalCost, ChildIndex);
 }
 
-std::string CForwardPlanner::StringizeNodes(const std::multimap<float, int>& OpenMap, const CCondition& GoalCondition) const
+std::string CForwardPlanner::StringizeNodes(const COpenList& OpenList, const CCondition& GoalCondition) const
 {
     std::string Return;
 
-    for (auto [Cost, NodeIndex] : OpenMap)
+    for (auto [Cost, NodeIndex] : OpenList.GetSortedEntries())
     {
         const SNode& CurrNode = mNodes[NodeIndex];
         Return += "Nodes["; 
@@ -0,0 +1,60 @@
+// Copyright 2026 Isaac Hsu
+
+#include <sstream>
+
+#include "Action.h"
+#include "PlannerStats.h"
+
+
+using namespace ExtendedGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void SPlannerStats::Reset()
+{
+    *this = SPlannerStats();
+}
+
+void SPlannerStats::AddCheck(const CAction& Action, bool Applicable)
+{
+    if (Applicable)
+    {
+        ApplicableCounts[&Action]++;
+    }
+    else
+    {
+        PrunedCount++;
+    }
+}
+
+void SPlannerStats::MapActions(const std::vector<std::unique_ptr<CAction>>& Clones, const std::vector<const CAction*>& Actions)
+{
+    std::unordered_map<const CAction*, long long> MappedCounts;
+    for (size_t ActionIndex = 0; ActionIndex < Clones.size(); ActionIndex++)
+    {
+        auto itCount = ApplicableCounts.find(Clones[ActionIndex].get());
+        if (itCount != ApplicableCounts.end())
+        {
+            MappedCounts[Actions[ActionIndex]] = itCount->second;
+        }
+    }
+
+    ApplicableCounts.swap(MappedCounts);
+}
+
+std::string SPlannerStats::ToString() const
+{
+    auto ToMicroseconds = [](CDuration Duration) { return std::chrono::duration_cast<std::chrono::microseconds>(Duration).count(); };
+
+    std::stringstream Stream;
+    Stream << "Expanded=" << ExpandedCount << " Generated=" << GeneratedCount << " Pruned=" << PrunedCount;
+    Stream << " MaxOpen=" << MaxOpenCount << " MaxDepth=" << MaxDepth;
+    Stream << " Heuristic=" << ToMicroseconds(HeuristicTime) << "us Precondition=" << ToMicroseconds(PreconditionTime) << "us";
+    Stream << " Clone=" << ToMicroseconds(CloneTime) << "us GoalTest=" << ToMicroseconds(GoalTestTime) << "us";
+
+    for (const auto& [Action, Count] : ApplicableCounts)
+    {
+        Stream << " " << Action->GetName() << "=" << Count;
+    }
+
+    return Stream.str();
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
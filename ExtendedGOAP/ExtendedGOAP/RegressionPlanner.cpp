@@ -7,83 +7,101 @@
 #include "Action.h"
 #include "BitVector.h"
 #include "Fact.h"
+#include "PlannerStats.h"
 #include "RegressionPlanner.h"
 #include "State.h"
 
 
 using namespace ExtendedGOAP;
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-bool CRegressionPlanner::DoPlan(std::vector<const CAction*>& oSteps, const CState& StartingState, CCondition& GoalCondition, std::vector<CAction*>& Actions, int MaxDepth)
+void CRegressionPlanner::BeginSearch()
 {
-    int Step = 0;
-    oSteps.clear();
-    mNodes.reserve(Actions.size() * MaxDepth);
+    mNodes.swap(mWorkspace->GetScratch<SNodeScratch>().Nodes); // Borrow the search tree of the workspace until PostPlan.
+    mNodes.reserve(mSearchActions.size() * mMaxDepth);
 
     if (ShouldPrintExcessiveHeuristic())
     {
-        mPathGetter = [&](int NodeIndex)
+        mPathGetter = [this](int NodeIndex)
         {
             const SNode& Node = mNodes[NodeIndex];
-            bool Reached = Node.ConstCondition->IsSatisfiedBy(StartingState);
+            bool Reached = Node.ConstCondition->IsSatisfiedBy(*mStartingState);
             return StringizeBackwardPath(mNodes, NodeIndex, Reached);
         };
     }
 
     SNode& RootNode = mNodes.emplace_back();
-    RootNode.ConstCondition = &GoalCondition;
-    RootNode.BaseHeuristicCost = GetBaseHeuristicCost(StartingState, GoalCondition, 0);
-    RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalCondition);
-
-    std::multimap<float, int> OpenMap; // The open set in A*
-    OpenMap.emplace(RootNode.GetTotalCost(), 0);
+    RootNode.ConstCondition = mGoalCondition.get();
+    RootNode.BaseHeuristicCost = GetBaseHeuristicCost(*mStartingState, *mGoalCondition, 0);
+    RootNode.ExtraHeuristicCost = mStartingState->GetExtraHeuristicCost(*mGoalCondition);
+    mWorkspace->GetOpenList().Push(RootNode.GetTotalCost(), 0);
+}
 
-    while (!OpenMap.empty())
+EPlanStatus CRegressionPlanner::ExpandNext()
+{
+    COpenList& OpenList = mWorkspace->GetOpenList(); // The open set in A*
+    if (OpenList.IsEmpty())
     {
-        auto itCurr = OpenMap.begin();
-        const int CurrIndex = itCurr->second;
-        OpenMap.erase(itCurr);
-        SNode& CurrNode = mNodes[CurrIndex];
+        return EPlanStatus::failed;
+    }
 
-        bool Reached = CurrNode.ConstCondition->IsSatisfiedBy(StartingState);
-        if (mFlags & ShowSteps)
-        {
-            std::cout << "#" << ++Step << " #Nodes=" << mNodes.size();
-            std::cout << ' ' << StringizeBackwardPath(mNodes, CurrIndex, Reached) << ' ';
-            std::cout << StringizeNode(CurrNode) << std::endl;
-        }
-        if (Reached)
-        {
-            if (mFlags & ShowFinalOpenNodes)
-            {
-                std::cout << StringizeNodes(OpenMap, StartingState);
-            }
+    if (mStats)
+    {
+        mStats->AddExpansion(OpenList.GetSize());
+    }
 
-            BuildBackwardPlan(oSteps, mNodes, CurrIndex);
-            return true;
-        }
+    const int CurrIndex = OpenList.Pop();
+    SNode& CurrNode = mNodes[CurrIndex];
+    mExpansionCount++;
 
-        if (CurrNode.Depth >= MaxDepth)
+    CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime);
+    bool Reached = CurrNode.ConstCondition->IsSatisfiedBy(*mStartingState);
+    GoalTestTimer.Stop();
+    if (mFlags & ShowSteps)
+    {
+        std::cout << "#" << mExpansionCount << " #Nodes=" << mNodes.size();
+        std::cout << ' ' << StringizeBackwardPath(mNodes, CurrIndex, Reached) << ' ';
+        std::cout << StringizeNode(CurrNode) << std::endl;
+    }
+    if (Reached)
+    {
+        if (mFlags & ShowFinalOpenNodes)
         {
-            continue;
+            std::cout << StringizeNodes(OpenList, *mStartingState);
         }
 
-        for (const CAction* Action : Actions)
+        BuildBackwardPlan(mSteps, mNodes, CurrIndex);
+        return EPlanStatus::succeeded;
+    }
+
+    if (CurrNode.Depth < mMaxDepth)
+    {
+        for (const CAction* Action : mSearchActions)
         {
-            Explore(OpenMap, CurrIndex, *Action, StartingState);
+            Explore(OpenList, CurrIndex, *Action, *mStartingState);
         }
     }
 
-    return false;
+    return OpenList.IsEmpty() ? EPlanStatus::failed : EPlanStatus::searching;
 }
 
 void CRegressionPlanner::PostPlan()
 {
     mNodes.clear();
+    mNodes.swap(mWorkspace->GetScratch<SNodeScratch>().Nodes); // Return the search tree to the workspace.
 }
 
-void CRegressionPlanner::Explore(std::multimap<float, int>& oOpenMap, int NodeIndex, const CAction& Action, const CState& StartingState)
+void CRegressionPlanner::Explore(COpenList& oOpenList, int NodeIndex, const CAction& Action, const CState& StartingState)
 {
+    // Regression both checks the action and applies its inverse effect.
+    CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
     std::unique_ptr<CCondition> DesiredCondition = CheckPostcondition(*mNodes[NodeIndex].ConstCondition, Action);
+    PreconditionTimer.Stop();
+
+    if (mStats)
+    {
+        mStats->AddCheck(Action, DesiredCondition != nullptr);
+    }
+
     if (!DesiredCondition)
     {
         return;
@@ -101,10 +119,17 @@ void CRegressionPlanner::Explore(std::multimap<float, int>& oOpenMap, int NodeIn
     Action.Affect(*ChildNode.MutableCondition);
     ChildNode.PreviousCost = CurrNode.GetActualCost();
     ChildNode.CurrentCost = Action.GetCost(*CurrNode.ConstCondition, *ChildNode.ConstCondition);
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
     ChildNode.BaseHeuristicCost = GetBaseHeuristicCost(StartingState, *ChildNode.ConstCondition, ChildIndex);
     ChildNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(*ChildNode.ConstCondition);
+    HeuristicTimer.Stop();
     float TotalCost = ChildNode.GetTotalCost();
-    oOpenMap.emplace(TotalCost, ChildIndex);
+    oOpenList.Push(TotalCost, ChildIndex);
 }
 
 std::unique_ptr<CCondition> CRegressionPlanner::CheckPostcondition(const CCondition& Postcondition, const CAction& Action) const
@@ -152,11 +177,11 @@ void CRegressionPlanner::ConjoinCondition(CCondition& oLeft, const CCondition& R
     oLeft.GetConstraint().RemoveRedundancy(oLeft.GetDefinition());
 }
 
-std::string CRegressionPlanner::StringizeNodes(const std::multimap<float, int>& OpenMap, const CState& StartingState) const
+std::string CRegressionPlanner::StringizeNodes(const COpenList& OpenList, const CState& StartingState) const
 {
     std::string Return;
 
-    for (auto [Cost, NodeIndex] : OpenMap)
+    for (auto [Cost, NodeIndex] : OpenList.GetSortedEntries())
     {
         const SNode& CurrNode = mNodes[NodeIndex];
         Return += "Nodes[";
@@ -2,10 +2,10 @@
 
 #pragma once
 
-#include <map>
 #include <memory>
 
 #include "BasePlanner.h"
+#include "OpenList.h"
 
 
 namespace ExtendedGOAP
@@ -22,25 +22,33 @@ namespace ExtendedGOAP
             std::unique_ptr<CCondition> MutableCondition;
         };
 
+        struct SNodeScratch : CPlannerWorkspace::SScratch // Search tree kept by a workspace between searches
+        {
+            std::vector<SNode> Nodes;
+
+            void Clear() override { Nodes.clear(); }
+        };
+
     public:
         using Super::Super;
 
     protected:
-        bool DoPlan(std::vector<const CAction*>& oSteps, const CState& StartingState, CCondition& GoalCondition, std::vector<CAction*>& Actions, int MaxDepth) override;
+        void BeginSearch() override;
+        EPlanStatus ExpandNext() override;
         void PostPlan() override;
 
         virtual void ConjoinCondition(CCondition& oLeft, const CCondition& Right) const;
         virtual std::string StringizeNode(const SNode& Node) const;
 
         // Create a search node for a given action from a given node if feasible.
-        void Explore(std::multimap<float, int>& oOpenMap, int NodeIndex, const CAction& Action, const CState& StartingState);
+        void Explore(COpenList& oOpenList, int NodeIndex, const CAction& Action, const CState& StartingState);
         // Reverse a given action from a given postcondition and return the desired condition, if feasible.
         std::unique_ptr<CCondition> CheckPostcondition(const CCondition& Postcondition, const CAction& Action) const;
         // Return a description of listed nodes.
-        std::string StringizeNodes(const std::multimap<float, int>& OpenMap, const CState& StartingState) const;
+        std::string StringizeNodes(const COpenList& OpenList, const CState& StartingState) const;
 
     protected:
-        std::vector<SNode> mNodes;
+        std::vector<SNode> mNodes; // The search tree, which is borrowed from the workspace during a search
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
 }
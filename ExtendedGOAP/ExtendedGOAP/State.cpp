@@ -1,6 +1,7 @@
 // Copyright 2026 Isaac Hsu
 
 #include <cassert>
+#include <typeinfo>
 
 #include "Condition.h"
 #include "Fact.h"
@@ -176,6 +177,16 @@ CState::CState(const CFactDefinition& Definition)
     : CStateBase(Definition)
 {}
 
+CState* CState::CloneInto(CStateArena& Arena) const
+{
+    if (typeid(*this) == typeid(CState))
+    {
+        return Arena.Create<CState>(*this, &Arena);
+    }
+
+    return Arena.Adopt(Clone()); // Subclasses without their own overrides are still cloned with their dynamic types.
+}
+
 std::string CState::ToString() const
 {
     std::string Return;
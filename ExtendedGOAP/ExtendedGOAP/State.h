@@ -3,8 +3,10 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
+#include "StateArena.h"
 #include "Variant.h"
 
 
@@ -25,6 +27,9 @@ namespace ExtendedGOAP
     {
     public:
         explicit CStateBase(const CFactDefinition& Definition);
+        CStateBase(const CStateBase& Another) = default;
+        // Copy another state with its storage allocated from a given memory resource, such as a state arena.
+        CStateBase(const CStateBase& Another, std::pmr::memory_resource* Resource) : mDefinition(Another.mDefinition), mProperties(Another.mProperties, Resource) {}
 
         const CFactDefinition& GetDefinition() const { return mDefinition; }
 
@@ -56,7 +61,7 @@ namespace ExtendedGOAP
 
     protected:
         const CFactDefinition& mDefinition;
-        std::vector<CVariant> mProperties;
+        std::pmr::vector<CVariant> mProperties; // Copies take the default memory resource.
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
     class CState : public CStateBase // World state composed of world properties
@@ -65,9 +70,15 @@ namespace ExtendedGOAP
         friend class CEffect;
     public:
         explicit CState(const CFactDefinition& Definition);
+        CState(const CState& Another) = default;
+        // Copy another state with its storage allocated from a given memory resource, such as a state arena.
+        CState(const CState& Another, std::pmr::memory_resource* Resource) : CStateBase(Another, Resource) {}
         virtual ~CState() {}
 
         virtual std::unique_ptr<CState> Clone() const { return std::make_unique<CState>(*this); }
+        // Clone this state into an arena. Subclasses override it with Arena.Create<CSubclass>(*this, &Arena) and a constructor passing the arena
+        // on to the copy constructor of CState with a memory resource, or their Clone results are adopted.
+        virtual CState* CloneInto(CStateArena& Arena) const;
         virtual std::string ToString() const; // For debugging
         virtual float GetExtraHeuristicCost(const CCondition& Condition) const { return 0.f; } // Custom heuristic cost
 
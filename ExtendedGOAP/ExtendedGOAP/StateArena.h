@@ -0,0 +1,90 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+
+namespace ExtendedGOAP
+{
+    class CState;
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Bump allocator owning the states generated in a search. States are laid out contiguously in blocks and destroyed in bulk.
+    // It is also the memory resource of the storage of the states it creates, so a cloned state and its properties share a block.
+    // Deallocation is a no-op and the memory is reused only after DestroyLast or Clear. Since DestroyLast rewinds the allocation to
+    // the position before the last state, only the most recently created state may grow its storage; if an earlier state grew, its new
+    // storage would be placed after later states and reused while still in use.
+    class CStateArena : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+        explicit CStateArena(size_t BlockSize = DefaultBlockSize) : mBlockSize(BlockSize) {}
+        CStateArena(const CStateArena&) = delete;
+        CStateArena& operator = (const CStateArena&) = delete;
+        ~CStateArena() { Clear(); }
+
+        // Construct a state of a given type in the arena. Overrides of CState::CloneInto call it with their own types.
+        template <typename TState, typename... TArgs>
+        TState* Create(TArgs&&... Args);
+        // Take the ownership of a state allocated elsewhere.
+        CState* Adopt(std::unique_ptr<CState> State);
+        // Destroy the most recently created or adopted state and reuse its memory for the next one.
+        void DestroyLast();
+        // Destroy all states but keep the blocks for later searches.
+        void Clear();
+
+        int GetStateCount() const { return static_cast<int>(mEntries.size()); }
+
+    private:
+        struct SBlock
+        {
+            std::unique_ptr<std::byte[]> Memory;
+            size_t Size = 0;
+        };
+
+        struct SEntry
+        {
+            CState* State = nullptr;
+            size_t BlockIndex = 0;  // Allocation position before the state, which DestroyLast rewinds to
+            size_t Offset = 0;
+            bool Adopted = false;
+        };
+
+        // Return aligned memory from the current block, or move on to the next block if it runs out.
+        void* Allocate(size_t Size, size_t Alignment);
+
+        void* do_allocate(size_t Size, size_t Alignment) override { return Allocate(Size, Alignment); }
+        void do_deallocate(void* Memory, size_t Size, size_t Alignment) override {} // Released in bulk
+        bool do_is_equal(const std::pmr::memory_resource& Another) const noexcept override { return this == &Another; }
+
+        size_t mBlockSize;
+        std::vector<SBlock> mBlocks;
+        size_t mBlockIndex = 0;                                 // Index of the block being allocated from
+        size_t mOffset = 0;                                     // Offset of the free space in the current block
+        std::vector<SEntry> mEntries;                           // States in the order of creation
+        std::vector<std::unique_ptr<CState>> mAdoptedStates;    // States allocated elsewhere
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename TState, typename... TArgs>
+    TState* CStateArena::Create(TArgs&&... Args)
+    {
+        static_assert(alignof(TState) <= alignof(std::max_align_t), "Over-aligned states are not supported.");
+
+        SEntry Entry;
+        Entry.BlockIndex = mBlockIndex;
+        Entry.Offset = mOffset;
+
+        void* Memory = Allocate(sizeof(TState), alignof(TState));
+        TState* State = new (Memory) TState(std::forward<TArgs>(Args)...);
+        Entry.State = State;
+        mEntries.push_back(Entry);
+        return State;
+    }
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
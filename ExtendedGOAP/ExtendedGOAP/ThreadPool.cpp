@@ -0,0 +1,126 @@
+// Copyright 2026 Isaac Hsu
+
+#include <algorithm>
+
+#include "ThreadPool.h"
+
+
+using namespace ExtendedGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+CThreadPool::CThreadPool(int ThreadCount)
+{
+    if (ThreadCount <= 0)
+    {
+        ThreadCount = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    }
+
+    mQueues.reserve(ThreadCount);
+    for (int WorkerIndex = 0; WorkerIndex < ThreadCount; WorkerIndex++)
+    {
+        mQueues.push_back(std::make_unique<SWorkerQueue>());
+    }
+
+    mThreads.reserve(ThreadCount);
+    for (int WorkerIndex = 0; WorkerIndex < ThreadCount; WorkerIndex++)
+    {
+        mThreads.emplace_back(&CThreadPool::Run, this, WorkerIndex);
+    }
+}
+
+CThreadPool::~CThreadPool()
+{
+    {
+        std::lock_guard Lock(mMutex);
+        mStopping = true;
+    }
+
+    mWorkAvailable.notify_all();
+    for (std::thread& Thread : mThreads)
+    {
+        Thread.join();
+    }
+}
+
+void CThreadPool::Submit(CTask Task)
+{
+    mPendingCount++;
+
+    SWorkerQueue& Queue = *mQueues[mNextQueue++ % mQueues.size()];
+    {
+        std::lock_guard Lock(Queue.Mutex);
+        Queue.Tasks.push_back(std::move(Task));
+    }
+
+    mQueuedCount++;
+    {
+        std::lock_guard Lock(mMutex); // Pair with the predicate check of sleeping workers so that the notification is not lost.
+    }
+
+    mWorkAvailable.notify_one();
+}
+
+void CThreadPool::Wait()
+{
+    std::unique_lock Lock(mMutex);
+    mAllDone.wait(Lock, [this] { return mPendingCount == 0; });
+}
+
+void CThreadPool::Run(int WorkerIndex)
+{
+    CTask Task;
+
+    while (true)
+    {
+        if (TryTake(WorkerIndex, Task))
+        {
+            mQueuedCount--;
+            Task(WorkerIndex);
+            Task = nullptr;
+
+            if (--mPendingCount == 0)
+            {
+                std::lock_guard Lock(mMutex);
+                mAllDone.notify_all();
+            }
+
+            continue;
+        }
+
+        std::unique_lock Lock(mMutex);
+        mWorkAvailable.wait(Lock, [this] { return mStopping || mQueuedCount > 0; });
+        if (mStopping && mQueuedCount == 0)
+        {
+            return;
+        }
+    }
+}
+
+bool CThreadPool::TryTake(int WorkerIndex, CTask& oTask)
+{
+    {
+        SWorkerQueue& Queue = *mQueues[WorkerIndex];
+        std::lock_guard Lock(Queue.Mutex);
+        if (!Queue.Tasks.empty())
+        {
+            oTask = std::move(Queue.Tasks.back());
+            Queue.Tasks.pop_back();
+            return true;
+        }
+    }
+
+    const int QueueCount = static_cast<int>(mQueues.size());
+    for (int Offset = 1; Offset < QueueCount; Offset++)
+    {
+        SWorkerQueue& Victim = *mQueues[(WorkerIndex + Offset) % QueueCount];
+        std::lock_guard Lock(Victim.Mutex);
+        if (!Victim.Tasks.empty())
+        {
+            oTask = std::move(Victim.Tasks.front());
+            Victim.Tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
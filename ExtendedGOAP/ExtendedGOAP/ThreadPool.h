@@ -0,0 +1,59 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace ExtendedGOAP
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Work-stealing thread pool. Each worker takes tasks from the back of its own queue and steals from the front of the others when idle.
+    class CThreadPool
+    {
+    public:
+        using CTask = std::function<void(int WorkerIndex)>; // A task receives the index of the worker running it to access per-thread data.
+
+        // Start a given number of workers, or one per hardware thread if the number is not positive.
+        explicit CThreadPool(int ThreadCount = 0);
+        CThreadPool(const CThreadPool&) = delete;
+        CThreadPool& operator = (const CThreadPool&) = delete;
+        ~CThreadPool();
+
+        int GetThreadCount() const { return static_cast<int>(mThreads.size()); }
+
+        // Queue a task on the workers in round-robin order.
+        void Submit(CTask Task);
+        // Block until all submitted tasks are finished.
+        void Wait();
+
+    private:
+        struct SWorkerQueue
+        {
+            std::mutex Mutex;
+            std::deque<CTask> Tasks;
+        };
+
+        void Run(int WorkerIndex);
+        // Take a task from the worker's own queue or steal one from another queue.
+        bool TryTake(int WorkerIndex, CTask& oTask);
+
+        std::vector<std::unique_ptr<SWorkerQueue>> mQueues;
+        std::vector<std::thread> mThreads;
+        std::mutex mMutex;                          // Guards sleeping and waking
+        std::condition_variable mWorkAvailable;     // Signaled when tasks are queued or the pool stops
+        std::condition_variable mAllDone;           // Signaled when the last pending task finishes
+        std::atomic<int> mQueuedCount = 0;          // Number of tasks in the queues
+        std::atomic<int> mPendingCount = 0;         // Number of tasks queued or running
+        std::atomic<unsigned> mNextQueue = 0;       // Queue receiving the next submitted task
+        bool mStopping = false;
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
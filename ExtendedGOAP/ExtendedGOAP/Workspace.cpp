@@ -0,0 +1,31 @@
+// Copyright 2026 Isaac Hsu
+
+#include <atomic>
+
+#include "State.h"
+#include "Workspace.h"
+
+
+using namespace ExtendedGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void CPlannerWorkspace::Clear()
+{
+    mOpenList.Clear();
+
+    for (std::unique_ptr<SScratch>& Scratch : mScratches)
+    {
+        if (Scratch)
+        {
+            Scratch->Clear();
+        }
+    }
+
+    mStateArena.Clear(); // After the scratch structs, which may still point to the states
+}
+
+int CPlannerWorkspace::AssignScratchIndex()
+{
+    static std::atomic<int> ScratchTypeCount(0); // Workspaces on different threads may meet a scratch type at the same time.
+    return ScratchTypeCount++;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,185 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This example steps resumable searches of every planner and compares their results with those of
+// Plan, which runs each search at once.
+//
+// Each domain hides a chain of actions like those of the benchmark among distractors, and every 
+// fifth domain limits the depth below the length of the chain, so its search fails. A search is
+// stepped one expansion at a time, with deadlines already passed, which still expand a node per 
+// step, and with a far deadline, which finishes it in one step. Finally, a search is begun while
+// another is still running, which ends the earlier one implicitly.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ExtendedGOAP/Action.h"
+#include "ExtendedGOAP/AdvRegressionPlanner.h"
+#include "ExtendedGOAP/BackwardPlanner.h"
+#include "ExtendedGOAP/Condition.h"
+#include "ExtendedGOAP/Fact.h"
+#include "ExtendedGOAP/Formula.h"
+#include "ExtendedGOAP/ForwardPlanner.h"
+#include "ExtendedGOAP/Notation.h"
+#include "ExtendedGOAP/RegressionPlanner.h"
+#include "ExtendedGOAP/State.h"
+
+
+using namespace ExtendedGOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct SDomain // A planning problem, which refers to its own fact definition and can't be copied
+{
+    CFactDefinition Definition;
+    std::unique_ptr<CState> StartingState;      // Created after all facts are defined
+    std::unique_ptr<CCondition> GoalCondition;
+    std::vector<CAction> Actions;
+    std::vector<const CAction*> ActionPtrs;
+    int MaxDepth = 0;
+};
+
+using CPlannerFactory = std::function<std::unique_ptr<CBasePlanner>()>;
+
+constexpr int DomainCount = 10;
+constexpr int FlagCount = 6;
+constexpr int DistractorCount = 8;
+constexpr int MaxChainLength = 5;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GenerateDomain(SDomain& oDomain, int ChainLength, std::mt19937& Random)
+{
+    auto RandomInt = [&Random](int Count) { return static_cast<int>(Random() % static_cast<unsigned>(Count)); };
+
+    std::vector<const CBooleanFact*> ChainFacts;
+    std::vector<const CBooleanFact*> Flags;
+    for (int i = 0; i <= ChainLength; i++)
+    {
+        ChainFacts.push_back(oDomain.Definition.DefineBoolean("Chain" + std::to_string(i)));
+    }
+    for (int i = 0; i < FlagCount; i++)
+    {
+        Flags.push_back(oDomain.Definition.DefineBoolean("Flag" + std::to_string(i)));
+    }
+
+    oDomain.StartingState = std::make_unique<CState>(oDomain.Definition);
+    for (int i = 0; i <= ChainLength; i++)
+    {
+        oDomain.StartingState->SetProperty(*ChainFacts[i], i == 0);
+    }
+    for (const CBooleanFact* Flag : Flags)
+    {
+        oDomain.StartingState->SetProperty(*Flag, RandomInt(2) == 1);
+    }
+
+    oDomain.GoalCondition = std::make_unique<CCondition>(oDomain.Definition);
+    oDomain.GoalCondition->SetConstraint(*ChainFacts.back() == true);
+
+    oDomain.Actions.reserve(ChainLength + DistractorCount);
+    for (int i = 0; i < ChainLength; i++)
+    {
+        CAction& Action = oDomain.Actions.emplace_back("Step" + std::to_string(i), oDomain.Definition);
+        Action.SetPrecondition(*ChainFacts[i] == true);
+        Action.AddEffect(*ChainFacts[i + 1] = true);
+    }
+    for (int i = 0; i < DistractorCount; i++)
+    {
+        CAction& Action = oDomain.Actions.emplace_back("Act" + std::to_string(i), oDomain.Definition);
+        Action.SetBaseCost(static_cast<float>(1 + RandomInt(3)));
+        Action.SetPrecondition(*Flags[RandomInt(FlagCount)] == (RandomInt(2) == 1));
+        Action.AddEffect(*Flags[RandomInt(FlagCount)] = (RandomInt(2) == 1));
+    }
+
+    for (const CAction& Action : oDomain.Actions)
+    {
+        oDomain.ActionPtrs.push_back(&Action);
+    }
+}
+
+// Return true if a finished search has the same outcome and plan as given ones.
+bool CheckResult(const CBasePlanner& Planner, bool Succeeded, const std::vector<const CAction*>& PlannedSteps)
+{
+    std::vector<const CAction*> Steps;
+    const bool Returned = Planner.GetResult(Steps);
+    const EPlanStatus Status = Succeeded ? EPlanStatus::succeeded : EPlanStatus::failed;
+    return Planner.GetStatus() == Status && Returned == Succeeded && Steps == PlannedSteps;
+}
+
+void RunResumable(const char* PlannerName, const CPlannerFactory& Factory, const std::vector<std::unique_ptr<SDomain>>& Domains)
+{
+    std::unique_ptr<CBasePlanner> Planner = Factory();
+    int Successes = 0;
+    int SingleMatches = 0;      // Searches stepped one expansion at a time like Plan
+    int CountMatches = 0;       // Searches taking as many single steps as expansions
+    int PassedMatches = 0;      // Searches stepped with passed deadlines like Plan
+    int FarMatches = 0;         // Searches finished in one step with a far deadline like Plan
+    std::vector<std::vector<const CAction*>> PlannedSteps(Domains.size());
+    std::vector<bool> Plannable(Domains.size());
+    for (size_t i = 0; i < Domains.size(); i++)
+    {
+        const SDomain& Domain = *Domains[i];
+        Plannable[i] = Planner->Plan(PlannedSteps[i], *Domain.StartingState, *Domain.GoalCondition, Domain.ActionPtrs, Domain.MaxDepth);
+        Successes += Plannable[i];
+
+        Planner->Begin(*Domain.StartingState, *Domain.GoalCondition, Domain.ActionPtrs, Domain.MaxDepth);
+        int StepCount = 0;
+        while (Planner->Step(1) == EPlanStatus::searching)
+        {
+            StepCount++;
+        }
+        SingleMatches += CheckResult(*Planner, Plannable[i], PlannedSteps[i]);
+        CountMatches += StepCount + 1 == Planner->GetExpansionCount();
+        Planner->End();
+
+        Planner->Begin(*Domain.StartingState, *Domain.GoalCondition, Domain.ActionPtrs, Domain.MaxDepth);
+        while (Planner->Step(std::chrono::steady_clock::now() - std::chrono::seconds(1)) == EPlanStatus::searching)
+        {
+        }
+        PassedMatches += CheckResult(*Planner, Plannable[i], PlannedSteps[i]);
+        Planner->End();
+
+        Planner->Begin(*Domain.StartingState, *Domain.GoalCondition, Domain.ActionPtrs, Domain.MaxDepth);
+        Planner->Step(std::chrono::steady_clock::now() + std::chrono::seconds(10));
+        FarMatches += CheckResult(*Planner, Plannable[i], PlannedSteps[i]);
+        Planner->End();
+    }
+
+    // Begin the last domain after stepping the first, which is still searching, and then finish the last one.
+    const SDomain& FirstDomain = *Domains.front();
+    const SDomain& LastDomain = *Domains.back();
+    Planner->Begin(*FirstDomain.StartingState, *FirstDomain.GoalCondition, FirstDomain.ActionPtrs, FirstDomain.MaxDepth);
+    const bool Interrupted = Planner->Step(1) == EPlanStatus::searching;
+    Planner->Begin(*LastDomain.StartingState, *LastDomain.GoalCondition, LastDomain.ActionPtrs, LastDomain.MaxDepth);
+    const bool Restarted = Planner->GetExpansionCount() == 0;
+    Planner->Step(std::chrono::steady_clock::now() + std::chrono::seconds(10));
+    const bool Replaced = CheckResult(*Planner, Plannable.back(), PlannedSteps.back());
+    Planner->End();
+
+    std::cout << PlannerName << ": " << Successes << " of " << Domains.size() << " domains planned\n";
+    std::cout << "    Single steps as Plan:       " << SingleMatches << "/" << Domains.size() << "\n";
+    std::cout << "    Single steps as expansions: " << CountMatches << "/" << Domains.size() << "\n";
+    std::cout << "    Passed deadlines as Plan:   " << PassedMatches << "/" << Domains.size() << "\n";
+    std::cout << "    Far deadline as Plan:       " << FarMatches << "/" << Domains.size() << "\n";
+    std::cout << "    Implicit End:               " << (Interrupted && Restarted && Replaced ? "as Plan" : "failed") << "\n";
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::mt19937 Random(7);
+    std::vector<std::unique_ptr<SDomain>> Domains;
+    for (int i = 0; i < DomainCount; i++)
+    {
+        const int ChainLength = 1 + i % MaxChainLength;
+        SDomain& Domain = *Domains.emplace_back(std::make_unique<SDomain>());
+        GenerateDomain(Domain, ChainLength, Random);
+        Domain.MaxDepth = (i % 5 == 4) ? ChainLength - 1 : ChainLength + 1; // Every fifth domain can't reach the end of the chain.
+    }
+
+    RunResumable("Forward", [] { return std::make_unique<CForwardPlanner>(); }, Domains);
+    RunResumable("Backward", [] { return std::make_unique<CBackwardPlanner>(); }, Domains);
+    RunResumable("Regressive", [] { return std::make_unique<CRegressionPlanner>(); }, Domains);
+    RunResumable("AdvRegressive", [] { return std::make_unique<CAdvRegressionPlanner>(); }, Domains);
+    return 0;
+}
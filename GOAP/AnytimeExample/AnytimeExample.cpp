@@ -0,0 +1,174 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This example checks the anytime repairing A* (ARA*) planner on random domains against an 
+// exhaustive search. The planner starts with a heavily weighted heuristic and reports a plan after 
+// each search with a smaller weight.
+//
+// Every reported plan should be valid, within the maximum depth, and priced at the cost of its 
+// steps, and each should be cheaper than the one before. The final search has a weight of 1, so 
+// the final plan should be optimal, except where duplicate states are pruned by cost alone: a state 
+// first reached by a cheaper but deeper path may have no room left within the maximum depth.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "GOAP/Action.h"
+#include "GOAP/AnytimePlanner.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+constexpr int DomainCount = 1000;
+constexpr int FactCount = 8;
+constexpr int ActionCount = 14;
+constexpr int MaxDepth = 6;
+constexpr float NoPlan = std::numeric_limits<float>::infinity();
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool IsValidPlan(const std::vector<const CAction*>& Steps, const CState& StartingState, const CState& GoalState)
+{
+    CState State = StartingState;
+    for (const CAction* Step : Steps)
+    {
+        if (!Step->CheckPrecondition(State))
+        {
+            return false;
+        }
+        Step->GetEffect().Overwrite(State);
+    }
+    return GoalState.IsSatisfiedBy(State);
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+float GetPlanCost(const std::vector<const CAction*>& Steps)
+{
+    float Cost = 0.f;
+    for (const CAction* Step : Steps)
+    {
+        Cost += Step->GetBaseCost();
+    }
+    return Cost;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Try all action sequences up to a given depth, and return the cost of the cheapest plan or NoPlan.
+float FindCheapestCost(const CState& State, const CState& GoalState, const std::vector<const CAction*>& Actions, int Depth)
+{
+    if (GoalState.IsSatisfiedBy(State))
+    {
+        return 0.f;
+    }
+
+    float Cheapest = NoPlan;
+    for (int i = 0; Depth > 0 && i < static_cast<int>(Actions.size()); ++i)
+    {
+        const CAction* Action = Actions[i];
+        if (Action->CheckPrecondition(State))
+        {
+            CState NextState = State;
+            Action->GetEffect().Overwrite(NextState);
+            Cheapest = std::min(Cheapest, Action->GetBaseCost() + FindCheapestCost(NextState, GoalState, Actions, Depth - 1));
+        }
+    }
+    return Cheapest;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::mt19937 Random(5);
+    std::vector<std::string> FactNames;
+    for (int i = 0; i < FactCount; ++i)
+    {
+        FactNames.push_back("F" + std::to_string(i));
+    }
+
+    int FoundPlans = 0;
+    int ExistingPlans = 0;
+    int OptimalPlans = 0;
+    int ReportedPlans = 0;
+    int ImprovedPlans = 0;     // Reported plans cheaper than the previous ones of the same search
+    int InvalidPlans = 0;      // Reported or final plans that don't reach the goal
+    int DeepPlans = 0;         // Reported or final plans longer than the maximum depth
+    int MispricedPlans = 0;    // Reported plans whose costs differ from those of their steps
+    int UnreportedPlans = 0;   // Final plans other than the last reported ones
+    for (int DomainIndex = 0; DomainIndex < DomainCount; ++DomainIndex)
+    {
+        std::vector<CAction> Actions;
+        for (int i = 0; i < ActionCount; ++i)
+        {
+            CAction& Action = Actions.emplace_back("A" + std::to_string(i));
+            Action.SetBaseCost(static_cast<float>(1 + Random() % 9));
+            const int PreconditionCount = static_cast<int>(1 + Random() % 2);
+            for (int k = 0; k < PreconditionCount; ++k)
+            {
+                const std::string& Name = FactNames[Random() % FactCount];
+                Action.SetPrecondition(Name, static_cast<int>(Random() % 2));
+            }
+            const int EffectCount = static_cast<int>(1 + Random() % 3);
+            for (int k = 0; k < EffectCount; ++k)
+            {
+                const std::string& Name = FactNames[Random() % FactCount];
+                Action.SetEffect(Name, static_cast<int>(Random() % 2));
+            }
+        }
+
+        std::vector<const CAction*> ActionPointers;
+        for (const CAction& Action : Actions)
+        {
+            ActionPointers.push_back(&Action);
+        }
+
+        CState StartingState;
+        for (const std::string& Name : FactNames)
+        {
+            StartingState.SetProperty(Name, static_cast<int>(Random() % 2));
+        }
+        CState GoalState;
+        for (int k = 0; k < 3; ++k)
+        {
+            const std::string& Name = FactNames[Random() % FactCount];
+            GoalState.SetProperty(Name, static_cast<int>(Random() % 2));
+        }
+
+        std::vector<const CAction*> ReportedSteps;
+        float ReportedCost = NoPlan;
+        CAnytimePlanner Planner(5.f, 1.f);
+        Planner.SetSolutionCallback([&](const std::vector<const CAction*>& Steps, float Cost, float Weight)
+        {
+            ReportedPlans++;
+            ImprovedPlans += Cost < ReportedCost;
+            InvalidPlans += !IsValidPlan(Steps, StartingState, GoalState);
+            DeepPlans += static_cast<int>(Steps.size()) > MaxDepth;
+            MispricedPlans += GetPlanCost(Steps) != Cost;
+            ReportedSteps = Steps;
+            ReportedCost = Cost;
+        });
+
+        std::vector<const CAction*> Steps;
+        const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10); // Far enough for the final search to finish
+        const bool Found = Planner.Plan(Steps, StartingState, GoalState, ActionPointers, MaxDepth, Deadline);
+        const float CheapestCost = FindCheapestCost(StartingState, GoalState, ActionPointers, MaxDepth);
+
+        FoundPlans += Found;
+        ExistingPlans += CheapestCost != NoPlan;
+        OptimalPlans += Found && GetPlanCost(Steps) == CheapestCost;
+        InvalidPlans += Found && !IsValidPlan(Steps, StartingState, GoalState);
+        DeepPlans += static_cast<int>(Steps.size()) > MaxDepth;
+        UnreportedPlans += Found && Steps != ReportedSteps;
+    }
+
+    std::cout << "Plans found:                " << FoundPlans << "\n";
+    std::cout << "Plans of exhaustive search: " << ExistingPlans << "\n";
+    std::cout << "Optimal plans:              " << OptimalPlans << "\n";
+    std::cout << "Reported plans:             " << ReportedPlans << "\n";
+    std::cout << "Improved plans:             " << ImprovedPlans << "/" << ReportedPlans << "\n";
+    std::cout << "Invalid plans:              " << InvalidPlans << "\n";
+    std::cout << "Plans over the max depth:   " << DeepPlans << "\n";
+    std::cout << "Mispriced plans:            " << MispricedPlans << "\n";
+    std::cout << "Final plans not reported:   " << UnreportedPlans << "\n";
+
+    return 0;
+}
@@ -0,0 +1,388 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This program runs every planner on synthetic domains and reports the number of expansions, the 
+// time per expansion, the peak memory allocated during the search, and the plan cost, so that 
+// scaling curves and regressions can be tracked across changes.
+// 
+// A generated domain hides a chain of actions, each of which requires the Boolean fact set by the 
+// previous one, so the optimal plan has exactly as many steps as the chain. The other actions are
+// distractors with random preconditions and effects on the facts off the chain, which widen the 
+// search without offering any shortcut.
+// 
+// Usage: Benchmark [Facts=N] [Actions=N] [Preconditions=N] [Effects=N] [Enumerations=R] [Depth=N] [Seed=N] [Repeats=N]
+// Enumerations is the ratio of enumeration facts among the facts off the chain.
+// Without a domain parameter, a sweep over action counts and plan depths is run.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+
+#include "GOAP/Action.h"
+#include "GOAP/AdvRegressionPlanner.h"
+#include "GOAP/AnytimePlanner.h"
+#include "GOAP/BackwardPlanner.h"
+#include "GOAP/BidirectionalPlanner.h"
+#include "GOAP/Common.h"
+#include "GOAP/ForwardPlanner.h"
+#include "GOAP/IDAStarPlanner.h"
+#include "GOAP/Observer.h"
+#include "GOAP/RegressionPlanner.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Allocation tracking through the replaceable global allocation functions
+namespace
+{
+    constexpr size_t AllocationHeader = alignof(std::max_align_t); // Room before each block to remember its size
+    size_t LiveBytes = 0;   // Bytes currently allocated
+    size_t PeakBytes = 0;   // Highest LiveBytes since the last reset
+}
+
+void* operator new(size_t Size)
+{
+    char* Block = static_cast<char*>(std::malloc(Size + AllocationHeader));
+    if (!Block)
+    {
+        throw std::bad_alloc();
+    }
+
+    *reinterpret_cast<size_t*>(Block) = Size;
+    LiveBytes += Size;
+    PeakBytes = std::max(PeakBytes, LiveBytes);
+    return Block + AllocationHeader;
+}
+
+void operator delete(void* Pointer) noexcept
+{
+    if (Pointer)
+    {
+        char* Block = static_cast<char*>(Pointer) - AllocationHeader;
+        LiveBytes -= *reinterpret_cast<size_t*>(Block);
+        std::free(Block);
+    }
+}
+
+void* operator new[](size_t Size) { return operator new(Size); }
+void operator delete[](void* Pointer) noexcept { operator delete(Pointer); }
+void operator delete(void* Pointer, size_t) noexcept { operator delete(Pointer); }
+void operator delete[](void* Pointer, size_t) noexcept { operator delete(Pointer); }
+///////////////////////////////////////////////////////////////////////////////////////////////////
+struct SDomainSpec // Parameters of a synthetic domain
+{
+    int FactCount = 32;             // Number of facts including the chain
+    int ActionCount = 32;           // Number of actions including the chain
+    int PreconditionCount = 2;      // Number of preconditions of each distractor
+    int EffectCount = 2;            // Number of effects of each distractor
+    float EnumerationRatio = 0.25f; // Ratio of enumeration facts among the facts off the chain
+    int Depth = 4;                  // Number of steps of the optimal plan
+    unsigned Seed = 1;
+};
+
+struct SDomain // A synthetic planning problem
+{
+    CState StartingState;
+    CState GoalState;
+    std::vector<CAction> Actions;
+    std::vector<const CAction*> ActionPtrs;
+};
+
+struct SRunResult
+{
+    bool Found = false;
+    float Cost = 0.f;
+    long long Expansions = 0;
+    double Nanoseconds = 0.0;   // Time of the fastest repeat
+    size_t PeakBytes = 0;
+};
+
+class CExpansionCounter : public CSearchObserver // Observer counting expansions without building any text
+{
+public:
+    void OnExpand(int Step, int NodeCount, const CTextGetter& GetPath, const CTextGetter& GetNode) override { mCount++; }
+
+    long long mCount = 0;
+};
+
+using CPlanFunction = std::function<bool(std::vector<const CAction*>& oSteps, const SDomain& Domain, int MaxDepth, CSearchObserver& Observer)>;
+
+struct SPlannerEntry
+{
+    const char* Name;
+    CPlanFunction Plan;
+};
+
+constexpr int EnumerationValueCount = 4;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+std::string GetChainFactName(int Index)
+{
+    return "Chain" + std::to_string(Index);
+}
+
+std::string GetFreeFactName(int Index)
+{
+    return "Fact" + std::to_string(Index);
+}
+
+void GenerateDomain(SDomain& oDomain, const SDomainSpec& Spec)
+{
+    std::mt19937 Random(Spec.Seed);
+    auto RandomInt = [&Random](int Count) { return static_cast<int>(Random() % static_cast<unsigned>(Count)); };
+
+    const int ChainFactCount = Spec.Depth + 1;
+    const int FreeFactCount = std::max(Spec.FactCount - ChainFactCount, 0);
+    const int EnumerationCount = static_cast<int>(FreeFactCount * std::clamp(Spec.EnumerationRatio, 0.f, 1.f));
+    auto GetValueCount = [&](int FreeFact) { return FreeFact < EnumerationCount ? EnumerationValueCount : 2; };
+
+    oDomain = SDomain();
+    for (int i = 0; i < ChainFactCount; i++)
+    {
+        oDomain.StartingState.SetProperty(GetChainFactName(i), i == 0);
+    }
+    for (int i = 0; i < FreeFactCount; i++)
+    {
+        oDomain.StartingState.SetProperty(GetFreeFactName(i), RandomInt(GetValueCount(i)));
+    }
+    oDomain.GoalState.SetProperty(GetChainFactName(Spec.Depth), true);
+
+    oDomain.Actions.reserve(std::max(Spec.ActionCount, Spec.Depth));
+    for (int i = 0; i < Spec.Depth; i++)
+    {
+        CAction& Action = oDomain.Actions.emplace_back("Step" + std::to_string(i));
+        Action.SetPrecondition(GetChainFactName(i), true);
+        Action.SetEffect(GetChainFactName(i + 1), true);
+    }
+
+    for (int i = Spec.Depth; i < Spec.ActionCount; i++)
+    {
+        CAction& Action = oDomain.Actions.emplace_back("Act" + std::to_string(i));
+        Action.SetBaseCost(static_cast<float>(1 + RandomInt(3)));
+
+        for (int j = 0; j < Spec.PreconditionCount; j++)
+        {
+            const int Fact = RandomInt(ChainFactCount + FreeFactCount);
+            if (Fact < ChainFactCount)
+            {
+                Action.SetPrecondition(GetChainFactName(Fact), RandomInt(2));
+            }
+            else
+            {
+                Action.SetPrecondition(GetFreeFactName(Fact - ChainFactCount), RandomInt(GetValueCount(Fact - ChainFactCount)));
+            }
+        }
+
+        for (int j = 0; j < Spec.EffectCount && FreeFactCount > 0; j++) // Distractors never touch the chain, which keeps the chain optimal.
+        {
+            const int Fact = RandomInt(FreeFactCount);
+            Action.SetEffect(GetFreeFactName(Fact), RandomInt(GetValueCount(Fact)));
+        }
+    }
+
+    for (const CAction& Action : oDomain.Actions)
+    {
+        oDomain.ActionPtrs.push_back(&Action);
+    }
+}
+
+std::vector<SPlannerEntry> GetPlanners()
+{
+    return {
+        {"Forward", [](auto& oSteps, const SDomain& Domain, int MaxDepth, CSearchObserver& Observer)
+        {
+            CForwardPlanner Planner;
+            Planner.SetObserver(&Observer);
+            return Planner.Plan(oSteps, Domain.StartingState, Domain.GoalState, Domain.ActionPtrs, MaxDepth);
+        }},
+        {"Forward+Duplicates", [](auto& oSteps, const SDomain& Domain, int MaxDepth, CSearchObserver& Observer)
+        {
+            CForwardPlanner Planner(DetectDuplicates);
+            Planner.SetObserver(&Observer);
+            return Planner.Plan(oSteps, Domain.StartingState, Domain.GoalState, Domain.ActionPtrs, MaxDepth);
+        }},
+        {"Backward", [](auto& oSteps, const SDomain& Domain, int MaxDepth, CSearchObserver& Observer)
+        {
+            CBackwardPlanner Planner;
+            Planner.SetObserver(&Observer);
+            return Planner.Plan(oSteps, Domain.StartingState, Domain.GoalState, Domain.ActionPtrs, MaxDepth);
+        }},
+        {"Regressive", [](auto& oSteps, const SDomain& Domain, int MaxDepth, CSearchObserver& Observer)
+        {
+            CRegressionPlanner Planner;
+            Planner.SetObserver(&Observer);
+            return Planner.Plan(oSteps, Domain.StartingState, Domain.GoalState, Domain.ActionPtrs, MaxDepth);
+        }},
+        {"AdvRegressive", [](auto& oSteps, const SDomain& Domain, int MaxDepth, CSearchObserver& Observer)
+        {
+            CAdvRegressionPlanner Planner;
+            Planner.SetObserver(&Observer);
+            return Planner.Plan(oSteps, Domain.StartingState, Domain.GoalState, Domain.ActionPtrs, MaxDepth);
+        }},
+        {"Bidirectional", [](auto& oSteps, const SDomain& Domain, int MaxDepth, CSearchObserver& Observer)
+        {
+            CBidirectionalPlanner Planner;
+            Planner.SetObserver(&Observer);
+            return Planner.Plan(oSteps, Domain.StartingState, Domain.GoalState, Domain.ActionPtrs, MaxDepth);
+        }},
+        {"Anytime", [](auto& oSteps, const SDomain& Domain, int MaxDepth, CSearchObserver& Observer)
+        {
+            CAnytimePlanner Planner;
+            Planner.SetObserver(&Observer);
+            return Planner.Plan(oSteps, Domain.StartingState, Domain.GoalState, Domain.ActionPtrs, MaxDepth, CAnytimePlanner::CClock::time_point::max()); // Run until the plan is optimal.
+        }},
+        {"IDA*", [](auto& oSteps, const SDomain& Domain, int MaxDepth, CSearchObserver& Observer)
+        {
+            CIDAStarPlanner Planner;
+            Planner.SetObserver(&Observer);
+            return Planner.Plan(oSteps, Domain.StartingState, Domain.GoalState, Domain.ActionPtrs, MaxDepth);
+        }},
+    };
+}
+
+SRunResult RunPlanner(const SPlannerEntry& Planner, const SDomain& Domain, int MaxDepth, int Repeats)
+{
+    SRunResult Result;
+    std::vector<const CAction*> Steps;
+
+    for (int i = 0; i < Repeats; i++)
+    {
+        CExpansionCounter Counter;
+        Steps.clear();
+        Steps.shrink_to_fit(); // Count the plan itself in the peak memory of every repeat.
+        const size_t BaseBytes = LiveBytes;
+        PeakBytes = LiveBytes;
+
+        auto StartTime = std::chrono::steady_clock::now();
+        Result.Found = Planner.Plan(Steps, Domain, MaxDepth, Counter);
+        auto EndTime = std::chrono::steady_clock::now();
+
+        const double Nanoseconds = std::chrono::duration<double, std::nano>(EndTime - StartTime).count();
+        Result.Nanoseconds = (i == 0) ? Nanoseconds : std::min(Result.Nanoseconds, Nanoseconds);
+        Result.Expansions = Counter.mCount;
+        Result.PeakBytes = std::max(Result.PeakBytes, PeakBytes - BaseBytes);
+    }
+
+    Result.Cost = 0.f;
+    for (const CAction* Step : Steps)
+    {
+        Result.Cost += Step->GetBaseCost();
+    }
+
+    return Result;
+}
+
+void RunBenchmark(const SDomainSpec& Spec, int Repeats)
+{
+    SDomain Domain;
+    GenerateDomain(Domain, Spec);
+
+    std::cout << "Facts=" << Spec.FactCount << " Actions=" << Spec.ActionCount << " Preconditions=" << Spec.PreconditionCount << " Effects=" << Spec.EffectCount;
+    std::cout << " Enumerations=" << Spec.EnumerationRatio << " Depth=" << Spec.Depth << " Seed=" << Spec.Seed << "\n";
+    std::cout << std::left << std::setw(20) << "Planner" << std::right << std::setw(7) << "Found" << std::setw(8) << "Cost";
+    std::cout << std::setw(12) << "Expansions" << std::setw(14) << "ns/Expansion" << std::setw(12) << "Peak KiB" << "\n";
+
+    for (const SPlannerEntry& Planner : GetPlanners())
+    {
+        SRunResult Result = RunPlanner(Planner, Domain, Spec.Depth, Repeats);
+        const double NanosecondsPerExpansion = Result.Nanoseconds / std::max(Result.Expansions, 1LL);
+
+        std::cout << std::left << std::setw(20) << Planner.Name << std::right << std::setw(7) << (Result.Found ? "yes" : "no") << std::setw(8) << Result.Cost;
+        std::cout << std::setw(12) << Result.Expansions << std::setw(14) << std::fixed << std::setprecision(1) << NanosecondsPerExpansion;
+        std::cout << std::setw(12) << Result.PeakBytes / 1024.0 << std::defaultfloat << std::setprecision(6) << "\n";
+    }
+
+    std::cout << std::endl;
+}
+
+void PrintUsage()
+{
+    std::cout << "Usage: Benchmark [Facts=N] [Actions=N] [Preconditions=N] [Effects=N] [Enumerations=R] [Depth=N] [Seed=N] [Repeats=N]\n";
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    SDomainSpec Spec;
+    int Repeats = 3;
+    bool Sweep = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string Argument = argv[i];
+        const size_t Separator = Argument.find('=');
+        if (Separator == std::string::npos)
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        const std::string Key = Argument.substr(0, Separator);
+        const char* Value = argv[i] + Separator + 1;
+
+        if (Key == "Repeats")
+        {
+            Repeats = std::max(std::atoi(Value), 1);
+            continue;
+        }
+
+        if (Key == "Facts")
+        {
+            Spec.FactCount = std::atoi(Value);
+        }
+        else if (Key == "Actions")
+        {
+            Spec.ActionCount = std::atoi(Value);
+        }
+        else if (Key == "Preconditions")
+        {
+            Spec.PreconditionCount = std::atoi(Value);
+        }
+        else if (Key == "Effects")
+        {
+            Spec.EffectCount = std::atoi(Value);
+        }
+        else if (Key == "Enumerations")
+        {
+            Spec.EnumerationRatio = static_cast<float>(std::atof(Value));
+        }
+        else if (Key == "Depth")
+        {
+            Spec.Depth = std::max(std::atoi(Value), 1);
+        }
+        else if (Key == "Seed")
+        {
+            Spec.Seed = static_cast<unsigned>(std::atoi(Value));
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        Sweep = false; // Any domain parameter selects a single run.
+    }
+
+    if (!Sweep)
+    {
+        RunBenchmark(Spec, Repeats);
+        return 0;
+    }
+
+    for (int Depth : {3, 5})
+    {
+        for (int ActionCount : {16, 32, 64, 128})
+        {
+            Spec.Depth = Depth;
+            Spec.ActionCount = ActionCount;
+            RunBenchmark(Spec, Repeats);
+        }
+    }
+
+    return 0;
+}
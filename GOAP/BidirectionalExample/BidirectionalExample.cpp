@@ -0,0 +1,167 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This example checks the bidirectional planner against A* and an exhaustive search on random 
+// domains, with each way of balancing the frontiers.
+//
+// Every plan found should be valid and as cheap as the cheapest one within the maximum depth, and 
+// a plan should be found whenever one exists. Each domain is also planned for a goal that no action 
+// achieves, so the two searches never meet and both frontiers run out.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "GOAP/Action.h"
+#include "GOAP/BidirectionalPlanner.h"
+#include "GOAP/ForwardPlanner.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+constexpr int DomainCount = 300;
+constexpr int FactCount = 12;
+constexpr int ActionCount = 10;
+constexpr int MaxDepth = 5;
+constexpr float NoPlan = std::numeric_limits<float>::infinity();
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool IsValidPlan(const std::vector<const CAction*>& Steps, const CState& StartingState, const CState& GoalState)
+{
+    CState State = StartingState;
+    for (const CAction* Step : Steps)
+    {
+        if (!Step->CheckPrecondition(State))
+        {
+            return false;
+        }
+        Step->GetEffect().Overwrite(State);
+    }
+    return GoalState.IsSatisfiedBy(State);
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+float GetPlanCost(const std::vector<const CAction*>& Steps)
+{
+    float Cost = 0.f;
+    for (const CAction* Step : Steps)
+    {
+        Cost += Step->GetBaseCost();
+    }
+    return Cost;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Try all action sequences up to a given depth, and return the cost of the cheapest plan or NoPlan.
+float FindCheapestCost(const CState& State, const CState& GoalState, const std::vector<const CAction*>& Actions, int Depth)
+{
+    if (GoalState.IsSatisfiedBy(State))
+    {
+        return 0.f;
+    }
+
+    float Cheapest = NoPlan;
+    for (int i = 0; Depth > 0 && i < static_cast<int>(Actions.size()); ++i)
+    {
+        const CAction* Action = Actions[i];
+        if (Action->CheckPrecondition(State))
+        {
+            CState NextState = State;
+            Action->GetEffect().Overwrite(NextState);
+            Cheapest = std::min(Cheapest, Action->GetBaseCost() + FindCheapestCost(NextState, GoalState, Actions, Depth - 1));
+        }
+    }
+    return Cheapest;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void RunBidirectional(EFrontierBalance Balance, const char* BalanceName)
+{
+    std::mt19937 Random(9);
+    std::vector<std::string> FactNames;
+    for (int i = 0; i < FactCount; ++i)
+    {
+        FactNames.push_back("F" + std::to_string(i));
+    }
+
+    int FoundPlans = 0;
+    int Agreements = 0;
+    int InvalidPlans = 0;
+    int OptimalPlans = 0;
+    int AStarCosts = 0;         // Plans as cheap as those of A*, or domains where neither finds any
+    int UnmetSearches = 0;      // Searches for the unachievable goals that found nothing
+    for (int DomainIndex = 0; DomainIndex < DomainCount; ++DomainIndex)
+    {
+        std::vector<CAction> Actions;
+        for (int i = 0; i < ActionCount; ++i)
+        {
+            CAction& Action = Actions.emplace_back("A" + std::to_string(i));
+            Action.SetBaseCost(static_cast<float>(1 + Random() % 4));
+            const int PreconditionCount = static_cast<int>(1 + Random() % 3);
+            for (int k = 0; k < PreconditionCount; ++k)
+            {
+                const std::string& Name = FactNames[Random() % FactCount];
+                Action.SetPrecondition(Name, static_cast<int>(Random() % 2));
+            }
+            const int EffectCount = static_cast<int>(1 + Random() % 3);
+            for (int k = 0; k < EffectCount; ++k)
+            {
+                const std::string& Name = FactNames[Random() % FactCount];
+                Action.SetEffect(Name, static_cast<int>(Random() % 2));
+            }
+        }
+
+        std::vector<const CAction*> ActionPointers;
+        for (const CAction& Action : Actions)
+        {
+            ActionPointers.push_back(&Action);
+        }
+
+        CState StartingState;
+        for (const std::string& Name : FactNames)
+        {
+            StartingState.SetProperty(Name, static_cast<int>(Random() % 2));
+        }
+        StartingState.SetProperty("Unachievable", 0);
+        CState GoalState;
+        for (int k = 0; k < 3; ++k)
+        {
+            const std::string& Name = FactNames[Random() % FactCount];
+            GoalState.SetProperty(Name, static_cast<int>(Random() % 2));
+        }
+
+        CBidirectionalPlanner Planner(Balance);
+        std::vector<const CAction*> Steps;
+        const bool Found = Planner.Plan(Steps, StartingState, GoalState, ActionPointers, MaxDepth);
+        const float CheapestCost = FindCheapestCost(StartingState, GoalState, ActionPointers, MaxDepth);
+
+        CForwardPlanner AStarPlanner;
+        std::vector<const CAction*> AStarSteps;
+        const bool AStarFound = AStarPlanner.Plan(AStarSteps, StartingState, GoalState, ActionPointers, MaxDepth);
+
+        FoundPlans += Found;
+        Agreements += Found == (CheapestCost != NoPlan);
+        InvalidPlans += Found && !IsValidPlan(Steps, StartingState, GoalState);
+        OptimalPlans += Found && GetPlanCost(Steps) == CheapestCost;
+        AStarCosts += Found == AStarFound && (!Found || GetPlanCost(Steps) == GetPlanCost(AStarSteps));
+
+        GoalState.SetProperty("Unachievable", 1);
+        UnmetSearches += !Planner.Plan(Steps, StartingState, GoalState, ActionPointers, MaxDepth) && Steps.empty();
+    }
+
+    std::cout << "    " << BalanceName << "\n";
+    std::cout << "      Plans found:                " << FoundPlans << "\n";
+    std::cout << "      Found as exhaustive search: " << Agreements << "/" << DomainCount << "\n";
+    std::cout << "      Invalid plans:              " << InvalidPlans << "\n";
+    std::cout << "      Optimal plans:              " << OptimalPlans << "\n";
+    std::cout << "      Costs as A*:                " << AStarCosts << "/" << DomainCount << "\n";
+    std::cout << "      Unachievable goals refused: " << UnmetSearches << "/" << DomainCount << "\n";
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    RunBidirectional(EFrontierBalance::Alternate, "Alternate");
+    RunBidirectional(EFrontierBalance::SmallerFrontier, "Smaller frontier");
+    RunBidirectional(EFrontierBalance::CheaperFrontier, "Cheaper frontier");
+
+    return 0;
+}
@@ -27,6 +27,9 @@ class CStateWithPosition : public CState
     using Super = CState;
 public:
     using Super::Super;
+    CStateWithPosition() = default;
+    CStateWithPosition(const CStateWithPosition& Another) = default;
+    CStateWithPosition(const CStateWithPosition& Another, std::pmr::memory_resource* Resource) : Super(Another, Resource), mPosition(Another.mPosition) {}
 
     const SVector& GetPosition() const { return mPosition; }
     void SetPosition(const SVector& Value) { mPosition = Value; }
@@ -34,6 +37,7 @@ public:
 
 protected:
     std::unique_ptr<CState> Clone() const override { return std::make_unique<CStateWithPosition>(*this);}
+    CState* CloneInto(CStateArena& Arena) const override { return Arena.Create<CStateWithPosition>(*this, &Arena); }
 
     float GetExtraHeuristicCost(const CState& Another) const override
     {
@@ -56,6 +60,15 @@ protected:
         return (Pos1 - Pos2).Length() * gDistanceCost;
     }
 
+    bool IsIdentical(const CState& Another) const override
+    {
+        const CStateWithPosition* State = dynamic_cast<const CStateWithPosition*>(&Another);
+        if (!State)
+            return false;
+
+        return Super::IsIdentical(Another) && mPosition.X == State->mPosition.X && mPosition.Y == State->mPosition.Y;
+    }
+
     std::string ToString() const override
     {
         std::string Return = Super::ToString();
@@ -5,6 +5,7 @@
 
 #include "ExampleUtility.h"
 #include "GOAP/GOAP.h"
+#include "GOAP/Observer.h"
 
 
 using namespace GOAP;
@@ -64,31 +65,39 @@ void RunGOAPs(const CState& StartingState, const CState& GoalState, const std::v
     std::cout << "\n";
 
     std::vector<const CAction*> Steps;
+    CConsoleObserver Observer;
 
     if (GOAPTypes & ForwardGOAP)
     {
-        bool Found = ForwardSearch(Steps, StartingState, GoalState, Actions, MaxDepth);
+        bool Found = ForwardSearch(Steps, StartingState, GoalState, Actions, MaxDepth, 0, &Observer);
         std::cout << StringizeGOAPResult(Found, Steps) << "\n";
     }
 
     if (GOAPTypes & BackwardGOAP)
     {
         Steps.clear();
-        bool Found = BackwardSearch(Steps, StartingState, GoalState, Actions, MaxDepth);
+        bool Found = BackwardSearch(Steps, StartingState, GoalState, Actions, MaxDepth, &Observer);
         std::cout << StringizeGOAPResult(Found, Steps) << "\n";
     }
 
     if (GOAPTypes & RegressiveGOAP)
     {
         Steps.clear();
-        bool Found = RegressiveSearch(Steps, StartingState, GoalState, Actions, MaxDepth);
+        bool Found = RegressiveSearch(Steps, StartingState, GoalState, Actions, MaxDepth, &Observer);
         std::cout << StringizeGOAPResult(Found, Steps) << "\n";
     }
 
     if (GOAPTypes & AdvRegressiveGOAP)
     {
         Steps.clear();
-        bool Found = AdvRegressiveSearch(Steps, StartingState, GoalState, Actions, MaxDepth);
+        bool Found = AdvRegressiveSearch(Steps, StartingState, GoalState, Actions, MaxDepth, &Observer);
+        std::cout << StringizeGOAPResult(Found, Steps) << "\n";
+    }
+
+    if (GOAPTypes & BidirectionalGOAP)
+    {
+        Steps.clear();
+        bool Found = BidirectionalSearch(Steps, StartingState, GoalState, Actions, MaxDepth, &Observer);
         std::cout << StringizeGOAPResult(Found, Steps) << "\n";
     }
 }
@@ -13,6 +13,7 @@ namespace GOAP
         BackwardGOAP        = 1 << 1,
         RegressiveGOAP      = 1 << 2,
         AdvRegressiveGOAP   = 1 << 3,
+        BidirectionalGOAP   = 1 << 4,
     };
 
     constexpr unsigned DefaultGOAPs = ForwardGOAP | RegressiveGOAP | AdvRegressiveGOAP;
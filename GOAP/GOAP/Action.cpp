@@ -54,9 +54,9 @@ bool CAction::CheckPostcondition(const CState& State) const
     // and its effects and preconditions have no conflicts with the desired state.
     bool AnySatisfaction = false;
 
-    for (auto& [Name, Target] : State)
+    for (const auto& [Index, Target] : State)
     {
-        std::optional<BProperty> Effect = mEffect.GetProperty(Name);
+        std::optional<BProperty> Effect = mEffect.GetProperty(Index);
         if (Effect == Target)
         {
             AnySatisfaction = true;
@@ -67,7 +67,7 @@ bool CAction::CheckPostcondition(const CState& State) const
             return false; // Any mismatched effects are not allowed.
         }
 
-        std::optional<BProperty> Constraint = mPrecondition.GetProperty(Name);
+        std::optional<BProperty> Constraint = mPrecondition.GetProperty(Index);
         if (Constraint && Constraint != Target)
         {
             return false; // The precondition conflicts with the desired state, making the action infeasible.
@@ -1,107 +1,83 @@
 // Copyright 2024 Isaac Hsu
 
-#include <iostream>
-#include <map>
-#include <typeinfo>
-#include <unordered_set>
+#include <optional>
 
 #include "Action.h"
 #include "AdvRegressionPlanner.h"
-#include "Hash.h"
+#include "EffectIndex.h"
 #include "Node.h"
+#include "PlannerStats.h"
+#include "Workspace.h"
 
 
 using namespace GOAP;
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-bool CAdvRegressionPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
+void CAdvRegressionPlanner::SEffectScratch::Clear()
 {
-    std::cout << typeid(*this).name() << std::endl;
-    std::cout << "START: {" << StartingState.ToString() << "}" << std::endl;
-    std::cout << "GOAL : {" << GoalState.ToString() << "}" << std::endl;
-
-    using FactPair = std::pair<std::string, BProperty>;
-    std::unordered_multimap<FactPair, const CAction*> EffectMap;
-    for (const CAction* Action : Actions)
+    SearchIndex = nullptr;
+    CandidateBits.clear();
+    SortedCandidates.clear();
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void CAdvRegressionPlanner::PrepareSearch(const std::vector<const CAction*>& Actions, CPlannerWorkspace& Workspace)
+{
+    SEffectScratch& Scratch = Workspace.GetScratch<SEffectScratch>();
+    Scratch.SearchIndex = mEffectIndex;
+    if (!mEffectIndex || !mEffectIndex->IsBuiltFrom(Actions)) // Fall back on a per-call index if the shared one is missing or mismatched.
     {
-        for (const auto& Pair : Action->GetEffect())
-        {
-            EffectMap.emplace(Pair, Action);
-        }
+        Scratch.EffectIndex.Build(Actions);
+        Scratch.SearchIndex = &Scratch.EffectIndex;
     }
 
-    std::unordered_set<const CAction*> FeasibleActions;
-    FeasibleActions.reserve(Actions.size());
-
-    int Step = 0;
-    oSteps.clear();
-    MaxDepth = std::max(MaxDepth, 0);
-
-    std::vector<SNode> Nodes;
-    Nodes.reserve(Actions.size() * MaxDepth);
-
-    SNode& RootNode = Nodes.emplace_back();
-    RootNode.ConstState = &GoalState;
-    RootNode.BaseHeuristicCost = static_cast<float>(GoalState.CountUnsatisfiedProperties(StartingState));
-    RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalState);
-
-    std::multimap<float, int> OpenMap; // The open set in A*
-    OpenMap.emplace(RootNode.GetTotalCost(), 0);
+    Scratch.CandidateBits.assign(Scratch.SearchIndex->GetWordCount(), 0);
+}
 
-    while (!OpenMap.empty())
+void CAdvRegressionPlanner::ExpandNode(CPlannerWorkspace& Workspace, SRegressionScratch& Scratch, int NodeIndex, const CState& StartingState)
+{
+    SEffectScratch& EffectScratch = Workspace.GetScratch<SEffectScratch>();
+    const CEffectIndex* EffectIndex = EffectScratch.SearchIndex;
+    if (!EffectIndex)
     {
-        auto itCurr = OpenMap.begin();
-        const int CurrIndex = itCurr->second;
-        SNode& CurrNode = Nodes[CurrIndex];
-
-        bool Reached = CurrNode.ConstState->IsSatisfiedBy(StartingState);
-        std::cout << "#" << ++Step << " #Nodes=" << Nodes.size();
-        std::cout << " |" << ((Reached || CurrIndex == 0) ? "" : "? ") << StringizePath(Nodes, CurrIndex) << "| ";
-        std::cout << CurrNode.ToString() << std::endl;
-        if (Reached)
-        {
-            BuildPlan(oSteps, Nodes, CurrIndex);
-            return true;
-        }
+        Super::ExpandNode(Workspace, Scratch, NodeIndex, StartingState); // The kept search was started by a plain regressive planner.
+        return;
+    }
 
-        OpenMap.erase(itCurr);
+    std::vector<BMaskWord>& CandidateBits = EffectScratch.CandidateBits; // Bitset of the actions having any desired effect
+    std::vector<int>& FeasibleActions = EffectScratch.SortedCandidates; // Indexes of feasible actions
+    const CState& DesiredState = *Workspace.GetNodes()[NodeIndex].ConstState;
 
-        if (CurrNode.Depth >= MaxDepth)
+    CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
+    bool Unsatisfiable = false;
+    for (const auto& DesiredFact : DesiredState)
+    {
+        if (!EffectIndex->AddActions(CandidateBits, DesiredFact)) // Check if no effects match the desired property.
         {
-            continue;
-        }
-
-        bool Unsatisfiable = false;
-        FeasibleActions.clear();
-        for (const auto& DesiredFact : *CurrNode.ConstState)
-        {            
-            auto Range = EffectMap.equal_range(DesiredFact);
-            if (Range.first == Range.second) // Check if no effects match the desired property.
+            std::optional<BProperty> StartingValue = StartingState.GetProperty(DesiredFact.first);
+            if (StartingValue != DesiredFact.second)
             {
-                std::optional<BProperty> StartingValue = StartingState.GetProperty(DesiredFact.first);
-                if (StartingValue != DesiredFact.second)
-                {
-                    Unsatisfiable = true; // It's impossible to satisfy the desired property because neither the starting value nor the effects match it.
-                    break;
-                }
+                Unsatisfiable = true; // It's impossible to satisfy the desired property because neither the starting value nor the effects match it.
+                break;
             }
+        }
+    }
 
-            for (auto it = Range.first; it != Range.second; ++it)
-            {
-                FeasibleActions.insert(it->second);
-            }
-        } 
+    CEffectIndex::TakeActions(FeasibleActions, CandidateBits);
+    PreconditionTimer.Stop();
 
-        if (Unsatisfiable)
+    if (Unsatisfiable)
+    {
+        if (mStats)
         {
-            continue;
+            mStats->PrunedCount += static_cast<long long>(FeasibleActions.size()); // The node is a dead end, so all its candidates are rejected.
         }
 
-        for (const CAction* Action : FeasibleActions)
-        {
-            Explore(OpenMap, Nodes, CurrIndex, *Action, StartingState);
-        }
+        Scratch.ClosedMarks[NodeIndex] = false; // The dead end depends on the starting state, so leave the node to be reopened by Replan.
+        return;
     }
 
-    return false;
+    for (int ActionIndex : FeasibleActions)
+    {
+        Explore(Workspace, Scratch, NodeIndex, *Scratch.Actions[ActionIndex], StartingState);
+    }
 }
 ///////////////////////////////////////////////////////////////////////////////////////////////////
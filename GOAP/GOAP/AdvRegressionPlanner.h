@@ -4,6 +4,8 @@
 
 #include <vector>
 
+#include "BitUtility.h"
+#include "EffectIndex.h"
 #include "RegressionPlanner.h"
 
 
@@ -14,8 +16,28 @@ namespace GOAP
     {
         using Super = CRegressionPlanner;
     public:
-        // Formulate a plan from the input if possible. Return true if successful.
-        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth);
+        // Look up the effects in an index built from the same actions, or build one in the workspace per call with null.
+        // A shared index must outlive the searches kept in workspaces for Replan.
+        void SetEffectIndex(const CEffectIndex* Value) { mEffectIndex = Value; }
+
+    protected:
+        struct SEffectScratch : CPlannerWorkspace::SScratch // Buffers of effect lookups
+        {
+            CEffectIndex EffectIndex;                     // Effect index built per call if no shared one is set
+            const CEffectIndex* SearchIndex = nullptr;    // Index of the kept search, either the shared one or EffectIndex
+            std::vector<BMaskWord> CandidateBits;         // Bitset of the candidate actions of the node being expanded
+            std::vector<int> SortedCandidates;            // Candidates to explore, sorted by action indexes
+
+            void Clear() override;
+        };
+
+        // Select the effect index of the search, building one in the workspace if the shared one is missing or mismatched.
+        void PrepareSearch(const std::vector<const CAction*>& Actions, CPlannerWorkspace& Workspace) override;
+        // Create the child nodes of a node for the actions having any of its desired effects, unless a desired fact is unsatisfiable.
+        void ExpandNode(CPlannerWorkspace& Workspace, SRegressionScratch& Scratch, int NodeIndex, const CState& StartingState) override;
+
+    private:
+        const CEffectIndex* mEffectIndex = nullptr; // Optional effect index shared among calls
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////    
 }
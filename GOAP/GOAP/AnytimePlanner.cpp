@@ -0,0 +1,279 @@
+// Copyright 2026 Isaac Hsu
+
+#include <algorithm>
+#include <limits>
+#include <typeinfo>
+
+#include "Action.h"
+#include "AnytimePlanner.h"
+#include "Node.h"
+#include "Observer.h"
+#include "PlannerStats.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void CAnytimePlanner::SAnytimeScratch::Clear()
+{
+    ClosedMarks.clear();
+    InconsistentNodes.clear();
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+CAnytimePlanner::CAnytimePlanner(float InitialWeight, float WeightStep)
+    : CForwardPlanner(DetectDuplicates), mInitialWeight(std::max(InitialWeight, 1.f)), mWeightStep(WeightStep)
+{
+}
+
+bool CAnytimePlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CClock::time_point Deadline)
+{
+    CPlannerWorkspace Workspace;
+    return Plan(oSteps, StartingState, GoalState, Actions, MaxDepth, Deadline, Workspace);
+}
+
+bool CAnytimePlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CClock::time_point Deadline, CPlannerWorkspace& Workspace)
+{
+    if (mObserver)
+    {
+        mObserver->OnStart(typeid(*this).name(), StartingState, GoalState);
+    }
+
+    if (mStats)
+    {
+        mStats->Reset();
+    }
+
+    int Step = 0;
+    oSteps.clear();
+    MaxDepth = std::max(MaxDepth, 0);
+
+    Workspace.Clear();
+    SForwardScratch& ForwardScratch = Workspace.GetScratch<SForwardScratch>();
+    SAnytimeScratch& Scratch = Workspace.GetScratch<SAnytimeScratch>();
+    const CSuccessorGenerator& SuccessorGenerator = SelectSuccessorGenerator(ForwardScratch, Actions);
+    std::vector<SNode>& Nodes = Workspace.GetNodes();
+    Nodes.reserve(Actions.size() * MaxDepth);
+
+    SNode& RootNode = Nodes.emplace_back();
+    RootNode.ConstState = &StartingState;
+    RootNode.BaseHeuristicCost = GetBaseHeuristicCost(StartingState, GoalState);
+    RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalState);
+    ForwardScratch.ReachedMap.emplace(&StartingState, 0);
+    Scratch.ClosedMarks.push_back(false);
+
+    float Weight = mInitialWeight;
+    COpenList& OpenList = Workspace.GetOpenList(); // The open set in ARA*, keyed by weighted costs
+    std::vector<int>& InconsistentNodes = Scratch.InconsistentNodes;
+    int GoalIndex = -1; // The node of the best plan so far
+    float ReportedCost = std::numeric_limits<float>::infinity();
+
+    if (GoalState.IsSatisfiedBy(StartingState))
+    {
+        GoalIndex = 0;
+    }
+    else
+    {
+        OpenList.Push(GetWeightedCost(RootNode, Weight), 0);
+    }
+
+    for (;;)
+    {
+        const bool Finished = ImprovePath(GoalIndex, Step, Workspace, ForwardScratch, Scratch, SuccessorGenerator, GoalState, Actions, MaxDepth, Weight, Deadline);
+
+        if (Finished && GoalIndex >= 0 && Nodes[GoalIndex].GetActualCost() < ReportedCost)
+        {
+            ReportedCost = Nodes[GoalIndex].GetActualCost();
+            if (mSolutionCallback)
+            {
+                oSteps.clear();
+                BuildPlan(oSteps, Nodes, GoalIndex);
+                mSolutionCallback(oSteps, ReportedCost, Weight);
+            }
+        }
+
+        if (!Finished || Weight <= 1.f || (OpenList.IsEmpty() && InconsistentNodes.empty()))
+        {
+            break;
+        }
+
+        // Tighten the weight, open the cheaper paths to expanded states, and reorder the open list for the new weight.
+        Weight = mWeightStep > 0.f ? std::max(Weight - mWeightStep, 1.f) : 1.f;
+        for (int NodeIndex : InconsistentNodes)
+        {
+            OpenList.Push(0.f, NodeIndex);
+        }
+        InconsistentNodes.clear();
+
+        for (int NodeIndex = 0; NodeIndex < static_cast<int>(Nodes.size()); ++NodeIndex)
+        {
+            if (OpenList.Contains(NodeIndex))
+            {
+                OpenList.Push(GetWeightedCost(Nodes[NodeIndex], Weight), NodeIndex);
+            }
+        }
+    }
+
+    oSteps.clear();
+    if (GoalIndex < 0)
+    {
+        return false;
+    }
+
+    BuildPlan(oSteps, Nodes, GoalIndex);
+    return true;
+}
+
+bool CAnytimePlanner::ImprovePath(int& ioGoalIndex, int& ioStep, CPlannerWorkspace& Workspace, SForwardScratch& ForwardScratch, SAnytimeScratch& Scratch, const CSuccessorGenerator& SuccessorGenerator, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, float Weight, CClock::time_point Deadline)
+{
+    std::vector<SNode>& Nodes = Workspace.GetNodes();
+    COpenList& OpenList = Workspace.GetOpenList();
+    std::vector<bool>& ClosedMarks = Scratch.ClosedMarks;
+
+    while (!OpenList.IsEmpty())
+    {
+        if (ioGoalIndex >= 0 && Nodes[ioGoalIndex].GetActualCost() <= OpenList.GetTopCost())
+        {
+            return true;
+        }
+
+        if (CClock::now() >= Deadline)
+        {
+            return false;
+        }
+
+        if (mStats)
+        {
+            mStats->AddExpansion(OpenList.GetSize());
+        }
+
+        const int CurrIndex = OpenList.Pop();
+        ClosedMarks[CurrIndex] = true;
+
+        if (mObserver)
+        {
+            mObserver->OnExpand(++ioStep, static_cast<int>(Nodes.size()), [&] { return StringizePath(Nodes, CurrIndex); }, [&] { return Nodes[CurrIndex].ToString(); });
+        }
+
+        if (Nodes[CurrIndex].Depth >= MaxDepth)
+        {
+            continue;
+        }
+
+        CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
+        SuccessorGenerator.GetApplicableActions(ForwardScratch.ApplicableActions, *Nodes[CurrIndex].ConstState);
+        PreconditionTimer.Stop();
+
+        if (mStats)
+        {
+            mStats->PrunedCount += static_cast<long long>(Actions.size() - ForwardScratch.ApplicableActions.size()); // The generator rejects the inapplicable actions at once.
+        }
+
+        for (int ActionIndex : ForwardScratch.ApplicableActions)
+        {
+            if (!CheckListedAction(SuccessorGenerator, ActionIndex, *Actions[ActionIndex], *Nodes[CurrIndex].ConstState))
+            {
+                continue;
+            }
+
+            ExploreAnytime(ioGoalIndex, Workspace, ForwardScratch, Scratch, CurrIndex, *Actions[ActionIndex], GoalState, Weight);
+        }
+        ClosedMarks.resize(Nodes.size(), false);
+    }
+
+    return true;
+}
+
+void CAnytimePlanner::ExploreAnytime(int& ioGoalIndex, CPlannerWorkspace& Workspace, SForwardScratch& ForwardScratch, SAnytimeScratch& Scratch, int NodeIndex, const CAction& Action, const CState& GoalState, float Weight)
+{
+    std::vector<SNode>& Nodes = Workspace.GetNodes();
+    int ChildIndex = static_cast<int>(Nodes.size());
+    SNode& ChildNode = Nodes.emplace_back();
+    SNode& CurrNode = Nodes[NodeIndex];
+    ChildNode.Action = &Action;
+    CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+    ChildNode.MutableState = CurrNode.ConstState->CloneInto(Workspace.GetStateArena());
+    Action.GetEffect().Overwrite(*ChildNode.MutableState);
+    Action.Affect(*ChildNode.MutableState);
+    CloneTimer.Stop();
+    ChildNode.ConstState = ChildNode.MutableState;
+    ChildNode.Parent = NodeIndex;
+    ChildNode.Depth = CurrNode.Depth + 1;
+    ChildNode.PreviousCost = CurrNode.GetActualCost();
+    ChildNode.CurrentCost = Action.GetCost(*CurrNode.ConstState, *ChildNode.ConstState);
+
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    auto [itReached, Inserted] = ForwardScratch.ReachedMap.try_emplace(ChildNode.ConstState, ChildIndex);
+    if (Inserted)
+    {
+        CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
+        ChildNode.BaseHeuristicCost = GetBaseHeuristicCost(*ChildNode.ConstState, GoalState);
+        ChildNode.ExtraHeuristicCost = ChildNode.ConstState->GetExtraHeuristicCost(GoalState);
+    }
+    else
+    {
+        if (mStats)
+        {
+            mStats->DuplicateCount++;
+        }
+
+        const int ReachedIndex = itReached->second;
+        SNode& ReachedNode = Nodes[ReachedIndex];
+        const bool Expanded = ReachedIndex < static_cast<int>(Scratch.ClosedMarks.size()) && Scratch.ClosedMarks[ReachedIndex];
+        if (ReachedNode.GetActualCost() <= ChildNode.GetActualCost())
+        {
+            Nodes.pop_back(); // Discard the duplicate, because the state has been reached at no higher cost.
+            Workspace.GetStateArena().DestroyLast();
+            return;
+        }
+
+        if (Expanded)
+        {
+            // Keep the child for the cheaper path, because moving the expanded node would leave stale depths and costs in its subtree.
+            ChildNode.BaseHeuristicCost = ReachedNode.BaseHeuristicCost;
+            ChildNode.ExtraHeuristicCost = ReachedNode.ExtraHeuristicCost;
+            itReached->second = ChildIndex;
+            if (Weight > 1.f)
+            {
+                Scratch.InconsistentNodes.push_back(ChildIndex); // Inconsistent nodes wait for the next search, as in ARA*.
+                return;
+            }
+            // The final search is plain A*, which opens the cheaper path at once.
+        }
+        else
+        {
+            ReachedNode.Action = ChildNode.Action; // Move the reached node to the cheaper path, as it has no children yet.
+            ReachedNode.Parent = ChildNode.Parent;
+            ReachedNode.Depth = ChildNode.Depth;
+            ReachedNode.PreviousCost = ChildNode.PreviousCost;
+            ReachedNode.CurrentCost = ChildNode.CurrentCost;
+            ChildIndex = ReachedIndex;
+            Nodes.pop_back();
+            Workspace.GetStateArena().DestroyLast();
+        }
+    }
+
+    const SNode& Node = Nodes[ChildIndex];
+    CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime);
+    const bool Reached = GoalState.IsSatisfiedBy(*Node.ConstState);
+    GoalTestTimer.Stop();
+
+    if (Reached)
+    {
+        if (ioGoalIndex < 0 || Node.GetActualCost() < Nodes[ioGoalIndex].GetActualCost())
+        {
+            ioGoalIndex = ChildIndex; // Plans only get costlier past the goal, so goal nodes are never expanded.
+        }
+        return;
+    }
+
+    Workspace.GetOpenList().Push(GetWeightedCost(Node, Weight), ChildIndex);
+}
+
+float CAnytimePlanner::GetWeightedCost(const SNode& Node, float Weight)
+{
+    return Node.GetActualCost() + Weight * Node.GetHeuristicCost();
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
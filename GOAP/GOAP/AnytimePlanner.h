@@ -0,0 +1,54 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include "ForwardPlanner.h"
+
+
+namespace GOAP
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    class CAnytimePlanner : public CForwardPlanner // Anytime repairing A* (ARA*) over forward GOAP
+    {
+    public:
+        using CClock = std::chrono::steady_clock;
+        // Called with each improved plan, its cost, and the heuristic weight bounding its suboptimality.
+        using CSolutionCallback = std::function<void(const std::vector<const CAction*>& Steps, float Cost, float Weight)>;
+
+        // The heuristic weight starts from InitialWeight and decreases by WeightStep after each search until it reaches 1.
+        explicit CAnytimePlanner(float InitialWeight = 3.f, float WeightStep = 0.5f);
+
+        // Formulate a plan from the input and keep improving it until the deadline passes or the plan is optimal. Return true if any plan is found.
+        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CClock::time_point Deadline);
+        // Same as above but with the buffers of a given workspace, which keeps their capacity for later calls.
+        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CClock::time_point Deadline, CPlannerWorkspace& Workspace);
+        // Set a callback to receive improved plans as soon as they are found, or clear it with null.
+        void SetSolutionCallback(CSolutionCallback Value) { mSolutionCallback = std::move(Value); }
+
+    protected:
+        struct SAnytimeScratch : CPlannerWorkspace::SScratch // Buffers of ARA* besides those of forward searches
+        {
+            std::vector<bool> ClosedMarks;          // Marks of the expanded nodes, which are never expanded again
+            std::vector<int> InconsistentNodes;     // Nodes of cheaper paths to expanded states, to open in the next search
+
+            void Clear() override;
+        };
+
+        // Expand nodes in the order of weighted costs until no open node can lead to a cheaper plan under the weight. Return false if the deadline passes first.
+        bool ImprovePath(int& ioGoalIndex, int& ioStep, CPlannerWorkspace& Workspace, SForwardScratch& ForwardScratch, SAnytimeScratch& Scratch, const CSuccessorGenerator& SuccessorGenerator, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, float Weight, CClock::time_point Deadline);
+        // Create a search node for a given action applicable to a given node, or move a reached node to the new path if it is cheaper.
+        void ExploreAnytime(int& ioGoalIndex, CPlannerWorkspace& Workspace, SForwardScratch& ForwardScratch, SAnytimeScratch& Scratch, int NodeIndex, const CAction& Action, const CState& GoalState, float Weight);
+        // Weighted total cost ordering the open list
+        static float GetWeightedCost(const SNode& Node, float Weight);
+
+    protected:
+        float mInitialWeight;
+        float mWeightStep;
+        CSolutionCallback mSolutionCallback;
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -1,7 +1,6 @@
 // Copyright 2024 Isaac Hsu
 
 #include <cassert>
-#include <iostream>
 #include <map>
 #include <sstream>
 #include <typeinfo>
@@ -11,6 +10,8 @@
 #include "Node.h"
 #include "BackwardPlanner.h"
 #include "Hash.h"
+#include "Observer.h"
+#include "PlannerStats.h"
 
 
 using namespace GOAP;
@@ -53,10 +54,10 @@ std::string CBackwardPlanner::SNode::ToString() const
 
 bool CBackwardPlanner::SNode::CheckPostcondition(const CAction& Action) const
 {
-    for (auto& [Name, Constraint] : Action.GetPrecondition())
+    for (const auto& [Index, Constraint] : Action.GetPrecondition())
     {
-        std::optional<BProperty> Current = CurrentState->GetProperty(Name);
-        std::optional<BProperty> Target = DesiredState->GetProperty(Name);
+        std::optional<BProperty> Current = CurrentState->GetProperty(Index);
+        std::optional<BProperty> Target = DesiredState->GetProperty(Index);
         if (Target == Current)
         {
             continue; // Skip satisfied properties.
@@ -64,7 +65,7 @@ bool CBackwardPlanner::SNode::CheckPostcondition(const CAction& Action) const
 
         if (Target != Constraint)
         {
-            std::optional<BProperty> Effect = Action.GetEffect().GetProperty(Name);
+            std::optional<BProperty> Effect = Action.GetEffect().GetProperty(Index);
             if (Target != Effect)
             {
                 // This action is infeasible, because its precondition conflicts with a desired property and its effect can't satisfy that property.
@@ -78,12 +79,17 @@ bool CBackwardPlanner::SNode::CheckPostcondition(const CAction& Action) const
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool CBackwardPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
 {
-    std::cout << typeid(*this).name() << std::endl;
-    std::cout << "START: {" << StartingState.ToString() << "}" << std::endl;
-    std::cout << "GOAL : {" << GoalState.ToString() << "}" << std::endl;
+    if (mObserver)
+    {
+        mObserver->OnStart(typeid(*this).name(), StartingState, GoalState);
+    }
+
+    if (mStats)
+    {
+        mStats->Reset();
+    }
 
-    using FactPair = std::pair<std::string, BProperty>;
-    std::unordered_multimap<FactPair, const CAction*> EffectMap;
+    std::unordered_multimap<CState::SFact, const CAction*> EffectMap;
     for (const CAction* Action : Actions)
     {
         for (const auto& Pair : Action->GetEffect())
@@ -109,26 +115,35 @@ bool CBackwardPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& S
     RootNode.BaseHeuristicCost = static_cast<float>(GoalState.CountUnsatisfiedProperties(StartingState));
     RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalState);
 
-    std::multimap<float, int> OpenMap; // The open set in A*
-    OpenMap.emplace(RootNode.GetTotalCost(), 0);
+    COpenList OpenList; // The open set in A*
+    OpenList.Push(RootNode.GetTotalCost(), 0);
 
-    while (!OpenMap.empty())
+    while (!OpenList.IsEmpty())
     {
-        auto itCurr = OpenMap.begin();
-        const int CurrIndex = itCurr->second;
+        const int CurrIndex = OpenList.GetTop();
         SNode& CurrNode = Nodes[CurrIndex];
 
+        if (mStats)
+        {
+            mStats->AddExpansion(OpenList.GetSize());
+        }
+
+        CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime);
         bool Reached = CurrNode.IsSatisfied();
-        std::cout << "#" << ++Step << " #Nodes=" << Nodes.size();
-        std::cout << " |" << ((Reached || CurrIndex == 0) ? "" : "? ") << StringizePath(Nodes, CurrIndex) << "| ";
-        std::cout << CurrNode.ToString() << std::endl;
+        GoalTestTimer.Stop();
+        if (mObserver)
+        {
+            auto GetPath = [&] { return ((Reached || CurrIndex == 0) ? "" : "? ") + StringizePath(Nodes, CurrIndex); };
+            mObserver->OnExpand(++Step, static_cast<int>(Nodes.size()), GetPath, [&] { return CurrNode.ToString(); });
+        }
+
         if (Reached)
         {
             BuildPlan(oSteps, Nodes, CurrIndex);
             return true;
         }
 
-        OpenMap.erase(itCurr);
+        OpenList.Pop();
 
         if (CurrNode.Depth >= MaxDepth)
         {
@@ -154,16 +169,25 @@ bool CBackwardPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& S
 
         for (const CAction* Action : CandidateActions)
         {
-            Explore(OpenMap, Nodes, CurrIndex, *Action, StartingState);
+            Explore(OpenList, Nodes, CurrIndex, *Action, StartingState);
         }
     }
 
     return false;
 }
 
-void CBackwardPlanner::Explore(std::multimap<float, int>& oOpenMap, std::vector<SNode>& Nodes, int NodeIndex, const CAction& Action, const CState& StartingState)
+void CBackwardPlanner::Explore(COpenList& oOpenList, std::vector<SNode>& Nodes, int NodeIndex, const CAction& Action, const CState& StartingState)
 {
-    if (!Nodes[NodeIndex].CheckPostcondition(Action))
+    CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
+    const bool Applicable = Nodes[NodeIndex].CheckPostcondition(Action);
+    PreconditionTimer.Stop();
+
+    if (mStats)
+    {
+        mStats->AddCheck(Action, Applicable);
+    }
+
+    if (!Applicable)
     {
         return;
     }
@@ -172,20 +196,30 @@ void CBackwardPlanner::Explore(std::multimap<float, int>& oOpenMap, std::vector<
     SNode& ChildNode = Nodes.emplace_back();
     SNode& CurrNode = Nodes[NodeIndex];
     ChildNode.Action = &Action;
+    CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
     ChildNode.CurrentState = CurrNode.CurrentState->Clone();
     ChildNode.CurrentState->CopyProperties(*CurrNode.DesiredState, Action.GetEffect());     // Copy matching values into the current state.
     ChildNode.DesiredState = CurrNode.DesiredState->Clone();
     Action.GetPrecondition().Overwrite(*ChildNode.DesiredState);                            // Add the preconditions to the desired state as new constraints.
     ChildNode.CurrentState->InitializeProperties(StartingState, *ChildNode.DesiredState);   // Copy starting values into the current state for unset properties.
     Action.Affect(*ChildNode.DesiredState);
+    CloneTimer.Stop();
     ChildNode.Parent = NodeIndex;
     ChildNode.Depth = CurrNode.Depth + 1;
     ChildNode.PreviousCost = CurrNode.GetActualCost();
     ChildNode.CurrentCost = Action.GetCost(*CurrNode.DesiredState, *ChildNode.DesiredState);
+
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
     ChildNode.BaseHeuristicCost = static_cast<float>(ChildNode.DesiredState->CountUnsatisfiedProperties(*ChildNode.CurrentState));
     ChildNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(*ChildNode.DesiredState);
+    HeuristicTimer.Stop();
     float TotalCost = ChildNode.GetTotalCost();
-    oOpenMap.emplace(TotalCost, ChildIndex);
+    oOpenList.Push(TotalCost, ChildIndex);
 }
 
 void CBackwardPlanner::BuildPlan(std::vector<const CAction*>& oSteps, const std::vector<SNode>& Nodes, int NodeIndex)
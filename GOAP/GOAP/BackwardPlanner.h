@@ -4,11 +4,15 @@
 
 #include <vector>
 
+#include "OpenList.h"
+
 
 namespace GOAP
 {
     class CAction;
+    class CSearchObserver;
     class CState;
+    struct SPlannerStats;
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // Modified version of the original regressive GOAP with an extra check to avoid sequences of conflicting actions, namely SNode::CheckPostcondition.
     class CBackwardPlanner
@@ -40,14 +44,22 @@ namespace GOAP
     public:
         // Formulate a plan from the input if possible. Return true if successful.
         bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth);
+        // Attach an observer to trace the search, or detach it with null.
+        void SetObserver(CSearchObserver* Value) { mObserver = Value; }
+        // Collect the statistics of each search into a given instance, or stop collecting them with null.
+        void SetStats(SPlannerStats* Value) { mStats = Value; }
 
     private:
         // Create a search node for a given action from a given node if feasible.
-        void Explore(std::multimap<float, int>& oOpenMap, std::vector<SNode>& Nodes, int NodeIndex, const CAction& Action, const CState& StartingState);
+        void Explore(COpenList& oOpenList, std::vector<SNode>& Nodes, int NodeIndex, const CAction& Action, const CState& StartingState);
         // List the actions on the path from a given node.
         void BuildPlan(std::vector<const CAction*>& oSteps, const std::vector<SNode>& Nodes, int NodeIndex);
         // Return concatenated names of the actions on the path from a given node.
         std::string StringizePath(const std::vector<SNode>& Nodes, int NodeIndex) const;
+
+    private:
+        CSearchObserver* mObserver = nullptr; // Optional observer tracing the search
+        SPlannerStats* mStats = nullptr; // Optional statistics of the last search
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
 }
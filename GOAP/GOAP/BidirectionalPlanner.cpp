@@ -0,0 +1,378 @@
+// Copyright 2026 Isaac Hsu
+
+#include <algorithm>
+#include <typeinfo>
+
+#include "Action.h"
+#include "BidirectionalPlanner.h"
+#include "Hash.h"
+#include "Node.h"
+#include "Observer.h"
+#include "PlannerStats.h"
+#include "Workspace.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void CBidirectionalPlanner::SBidirectionalScratch::Clear()
+{
+    BackwardNodes.clear();
+    BackwardOpenList.Clear();
+    MeetingGroups.clear();
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool CBidirectionalPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
+{
+    CPlannerWorkspace Workspace;
+    return Plan(oSteps, StartingState, GoalState, Actions, MaxDepth, Workspace);
+}
+
+bool CBidirectionalPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace)
+{
+    if (mObserver)
+    {
+        mObserver->OnStart(typeid(*this).name(), StartingState, GoalState);
+    }
+
+    if (mStats)
+    {
+        mStats->Reset();
+    }
+
+    int Step = 0;
+    oSteps.clear();
+    MaxDepth = std::max(MaxDepth, 0);
+
+    Workspace.Clear();
+    SBidirectionalScratch& Scratch = Workspace.GetScratch<SBidirectionalScratch>();
+    std::vector<SNode>& ForwardNodes = Workspace.GetNodes();        // The tree of concrete states from the starting state
+    std::vector<SNode>& BackwardNodes = Scratch.BackwardNodes;      // The tree of desired states from the goal state
+    COpenList& ForwardOpenList = Workspace.GetOpenList();
+    COpenList& BackwardOpenList = Scratch.BackwardOpenList;
+
+    SNode& ForwardRoot = ForwardNodes.emplace_back();
+    ForwardRoot.ConstState = &StartingState;
+    ForwardRoot.BaseHeuristicCost = static_cast<float>(GoalState.CountUnsatisfiedProperties(StartingState));
+    ForwardRoot.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalState);
+    ForwardOpenList.Push(ForwardRoot.GetTotalCost(), 0);
+
+    SNode& BackwardRoot = BackwardNodes.emplace_back();
+    BackwardRoot.ConstState = &GoalState;
+    BackwardRoot.BaseHeuristicCost = ForwardRoot.BaseHeuristicCost;
+    BackwardRoot.ExtraHeuristicCost = ForwardRoot.ExtraHeuristicCost;
+    BackwardOpenList.Push(BackwardRoot.GetTotalCost(), 0);
+
+    SMeeting Meeting;
+    FindMeeting(Meeting, Workspace, Scratch, 0, true, MaxDepth);
+    FindMeeting(Meeting, Workspace, Scratch, 0, false, MaxDepth); // Is the goal satisfied already?
+
+    // Once either frontier is exhausted, every plan within the max depth has met the root of the other tree, so the search is complete.
+    while (!ForwardOpenList.IsEmpty() && !BackwardOpenList.IsEmpty())
+    {
+        // Every meeting found later passes through an open node on each side, so stop once no open node costs less than the best meeting.
+        if (Meeting.Cost <= std::max(ForwardOpenList.GetTopCost(), BackwardOpenList.GetTopCost()))
+        {
+            break;
+        }
+
+        bool Forward = true;
+        switch (mBalance)
+        {
+        case EFrontierBalance::Alternate:
+            Forward = Step % 2 == 0;
+            break;
+        case EFrontierBalance::SmallerFrontier:
+            Forward = ForwardOpenList.GetSize() <= BackwardOpenList.GetSize();
+            break;
+        case EFrontierBalance::CheaperFrontier:
+            Forward = ForwardOpenList.GetTopCost() <= BackwardOpenList.GetTopCost();
+            break;
+        }
+
+        if (mStats)
+        {
+            mStats->AddExpansion(ForwardOpenList.GetSize() + BackwardOpenList.GetSize());
+        }
+
+        std::vector<SNode>& Nodes = Forward ? ForwardNodes : BackwardNodes;
+        const int CurrIndex = (Forward ? ForwardOpenList : BackwardOpenList).Pop();
+        ++Step;
+
+        if (mObserver)
+        {
+            const int NodeCount = static_cast<int>(ForwardNodes.size() + BackwardNodes.size());
+            mObserver->OnExpand(Step, NodeCount, [&] { return StringizePath(Nodes, CurrIndex, Forward); }, [&] { return Nodes[CurrIndex].ToString(); });
+        }
+
+        if (Nodes[CurrIndex].Depth >= MaxDepth)
+        {
+            continue;
+        }
+
+        for (const CAction* Action : Actions)
+        {
+            const int ChildIndex = Forward ? ExploreForward(Workspace, CurrIndex, *Action, GoalState) : ExploreBackward(Workspace, Scratch, CurrIndex, *Action, StartingState);
+            if (ChildIndex >= 0)
+            {
+                FindMeeting(Meeting, Workspace, Scratch, ChildIndex, Forward, MaxDepth);
+            }
+        }
+    }
+
+    if (Meeting.ForwardIndex < 0)
+    {
+        return false;
+    }
+
+    BuildPlan(oSteps, Workspace, Scratch, Meeting);
+    return true;
+}
+
+bool CBidirectionalPlanner::CheckAction(const CAction& Action, const CState& State, bool Forward)
+{
+    CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
+    const bool Applicable = Forward ? Action.CheckPrecondition(State) : Action.CheckPostcondition(State);
+    PreconditionTimer.Stop();
+
+    if (mStats)
+    {
+        mStats->AddCheck(Action, Applicable);
+    }
+
+    return Applicable;
+}
+
+int CBidirectionalPlanner::ExploreForward(CPlannerWorkspace& Workspace, int NodeIndex, const CAction& Action, const CState& GoalState)
+{
+    std::vector<SNode>& Nodes = Workspace.GetNodes();
+    if (!CheckAction(Action, *Nodes[NodeIndex].ConstState, true))
+    {
+        return -1;
+    }
+
+    int ChildIndex = static_cast<int>(Nodes.size());
+    SNode& ChildNode = Nodes.emplace_back();
+    SNode& CurrNode = Nodes[NodeIndex];
+    ChildNode.Action = &Action;
+    CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+    ChildNode.MutableState = CurrNode.ConstState->CloneInto(Workspace.GetStateArena());
+    Action.GetEffect().Overwrite(*ChildNode.MutableState);
+    Action.Affect(*ChildNode.MutableState);
+    CloneTimer.Stop();
+    ChildNode.ConstState = ChildNode.MutableState;
+    ChildNode.Parent = NodeIndex;
+    ChildNode.Depth = CurrNode.Depth + 1;
+    ChildNode.PreviousCost = CurrNode.GetActualCost();
+    ChildNode.CurrentCost = Action.GetCost(*CurrNode.ConstState, *ChildNode.ConstState);
+
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
+    ChildNode.BaseHeuristicCost = static_cast<float>(GoalState.CountUnsatisfiedProperties(*ChildNode.ConstState));
+    ChildNode.ExtraHeuristicCost = ChildNode.ConstState->GetExtraHeuristicCost(GoalState);
+    HeuristicTimer.Stop();
+    Workspace.GetOpenList().Push(ChildNode.GetTotalCost(), ChildIndex);
+    return ChildIndex;
+}
+
+int CBidirectionalPlanner::ExploreBackward(CPlannerWorkspace& Workspace, SBidirectionalScratch& Scratch, int NodeIndex, const CAction& Action, const CState& StartingState)
+{
+    std::vector<SNode>& Nodes = Scratch.BackwardNodes;
+    if (!CheckAction(Action, *Nodes[NodeIndex].ConstState, false))
+    {
+        return -1;
+    }
+
+    int ChildIndex = static_cast<int>(Nodes.size());
+    SNode& ChildNode = Nodes.emplace_back();
+    SNode& CurrNode = Nodes[NodeIndex];
+    ChildNode.Action = &Action;
+    CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+    ChildNode.MutableState = CurrNode.ConstState->CloneInto(Workspace.GetStateArena());
+    ChildNode.MutableState->RemoveMatch(Action.GetEffect());        // Remove satisfied properties in the desired state.
+    Action.GetPrecondition().Overwrite(*ChildNode.MutableState);    // Add the preconditions to the desired state as new constraints.
+    Action.Affect(*ChildNode.MutableState);
+    CloneTimer.Stop();
+    ChildNode.ConstState = ChildNode.MutableState;
+    ChildNode.Parent = NodeIndex;
+    ChildNode.Depth = CurrNode.Depth + 1;
+    ChildNode.PreviousCost = CurrNode.GetActualCost();
+    ChildNode.CurrentCost = Action.GetCost(*CurrNode.ConstState, *ChildNode.ConstState);
+
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
+    ChildNode.BaseHeuristicCost = static_cast<float>(ChildNode.ConstState->CountUnsatisfiedProperties(StartingState));
+    ChildNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(*ChildNode.ConstState);
+    HeuristicTimer.Stop();
+    Scratch.BackwardOpenList.Push(ChildNode.GetTotalCost(), ChildIndex);
+    return ChildIndex;
+}
+
+void CBidirectionalPlanner::FindMeeting(SMeeting& ioMeeting, const CPlannerWorkspace& Workspace, SBidirectionalScratch& Scratch, int NodeIndex, bool Forward, int MaxDepth) const
+{
+    CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime); // Meeting the opposite frontier is the goal test of both searches.
+
+    // Nodes are grouped by the facts constrained by regressive nodes. In each group, a forward node can only satisfy
+    // the regressive nodes whose values hash the same as its values of the facts, which spares comparing all pairs.
+    // Every forward node is hashed into every group, so the groups are capped, and a regressive node may join a group
+    // of a subset of its facts, down to the group of no facts, which checks it against all the forward nodes.
+    std::vector<SMeetingGroup>& Groups = Scratch.MeetingGroups;
+    const std::vector<SNode>& ForwardNodes = Workspace.GetNodes();
+
+    if (Forward)
+    {
+        const CState& State = *ForwardNodes[NodeIndex].ConstState;
+        for (SMeetingGroup& Group : Groups)
+        {
+            const size_t Hash = HashFacts(State, Group.Facts);
+            Group.ForwardNodes.emplace(Hash, NodeIndex);
+
+            auto [itFirst, itLast] = Group.BackwardNodes.equal_range(Hash);
+            for (auto it = itFirst; it != itLast; it++)
+            {
+                CheckMeeting(ioMeeting, Workspace, Scratch, NodeIndex, it->second, MaxDepth);
+            }
+        }
+
+        return;
+    }
+
+    const CState& DesiredState = *Scratch.BackwardNodes[NodeIndex].ConstState;
+    std::vector<int>& Facts = Scratch.MeetingFacts;
+    Facts.clear();
+    for (const auto& [Index, Value] : DesiredState)
+    {
+        Facts.push_back(Index);
+    }
+
+    auto itGroup = Groups.end(); // The group of the largest subset of the facts, which hashes the node most selectively
+    for (auto it = Groups.begin(); it != Groups.end(); it++)
+    {
+        if ((itGroup == Groups.end() || it->Facts.size() > itGroup->Facts.size()) && std::includes(Facts.begin(), Facts.end(), it->Facts.begin(), it->Facts.end()))
+        {
+            itGroup = it;
+        }
+    }
+
+    const bool Exact = itGroup != Groups.end() && itGroup->Facts.size() == Facts.size();
+    if (!Exact && (static_cast<int>(Groups.size()) < MaxMeetingGroups || itGroup == Groups.end()))
+    {
+        SMeetingGroup& Group = Groups.emplace_back();
+        if (static_cast<int>(Groups.size()) <= MaxMeetingGroups)
+        {
+            Group.Facts = Facts;
+        }
+        // Otherwise the group of no facts is the last resort, past the cap.
+
+        for (int ForwardIndex = 0; ForwardIndex < static_cast<int>(ForwardNodes.size()); ++ForwardIndex) // Index the forward nodes for the new group.
+        {
+            Group.ForwardNodes.emplace(HashFacts(*ForwardNodes[ForwardIndex].ConstState, Group.Facts), ForwardIndex);
+        }
+
+        itGroup = Groups.end() - 1;
+    }
+
+    const size_t Hash = HashFacts(DesiredState, itGroup->Facts);
+    itGroup->BackwardNodes.emplace(Hash, NodeIndex);
+
+    auto [itFirst, itLast] = itGroup->ForwardNodes.equal_range(Hash);
+    for (auto it = itFirst; it != itLast; it++)
+    {
+        CheckMeeting(ioMeeting, Workspace, Scratch, it->second, NodeIndex, MaxDepth);
+    }
+}
+
+void CBidirectionalPlanner::CheckMeeting(SMeeting& ioMeeting, const CPlannerWorkspace& Workspace, const SBidirectionalScratch& Scratch, int ForwardIndex, int BackwardIndex, int MaxDepth) const
+{
+    const SNode& ForwardNode = Workspace.GetNodes()[ForwardIndex];
+    const SNode& BackwardNode = Scratch.BackwardNodes[BackwardIndex];
+    const float Cost = ForwardNode.GetActualCost() + BackwardNode.GetActualCost();
+
+    if (Cost < ioMeeting.Cost && ForwardNode.Depth + BackwardNode.Depth <= MaxDepth && BackwardNode.ConstState->IsSatisfiedBy(*ForwardNode.ConstState))
+    {
+        ioMeeting.ForwardIndex = ForwardIndex;
+        ioMeeting.BackwardIndex = BackwardIndex;
+        ioMeeting.Cost = Cost;
+    }
+}
+
+size_t CBidirectionalPlanner::HashFacts(const CState& State, const std::vector<int>& Facts)
+{
+    size_t Return = 0;
+
+    for (int Index : Facts)
+    {
+        size_t FactHash = std::hash<CState::SFact>{}(CState::SFact(Index, State.GetProperty(Index).value_or(0)));
+        Return ^= FactHash + 0x9e3779b9 + (Return << 6) + (Return >> 2);
+    }
+
+    return Return;
+}
+
+void CBidirectionalPlanner::BuildPlan(std::vector<const CAction*>& oSteps, const CPlannerWorkspace& Workspace, const SBidirectionalScratch& Scratch, const SMeeting& Meeting)
+{
+    const std::vector<SNode>& ForwardNodes = Workspace.GetNodes();
+    for (int NodeIndex = Meeting.ForwardIndex; NodeIndex >= 0; NodeIndex = ForwardNodes[NodeIndex].Parent)
+    {
+        if (ForwardNodes[NodeIndex].Action)
+        {
+            oSteps.push_back(ForwardNodes[NodeIndex].Action);
+        }
+    }
+
+    std::reverse(oSteps.begin(), oSteps.end());
+
+    const std::vector<SNode>& BackwardNodes = Scratch.BackwardNodes;
+    for (int NodeIndex = Meeting.BackwardIndex; NodeIndex >= 0; NodeIndex = BackwardNodes[NodeIndex].Parent)
+    {
+        if (BackwardNodes[NodeIndex].Action)
+        {
+            oSteps.push_back(BackwardNodes[NodeIndex].Action);
+        }
+    }
+}
+
+std::string CBidirectionalPlanner::StringizePath(const std::vector<SNode>& Nodes, int NodeIndex, bool Forward) const
+{
+    std::vector<std::string> ActionNames;
+    while (NodeIndex >= 0)
+    {
+        if (Nodes[NodeIndex].Action)
+        {
+            ActionNames.push_back(Nodes[NodeIndex].Action->GetName());
+        }
+
+        NodeIndex = Nodes[NodeIndex].Parent;
+    }
+
+    if (Forward)
+    {
+        std::reverse(ActionNames.begin(), ActionNames.end());
+    }
+
+    std::string Path = Forward ? "" : "? "; // Regressive paths are marked like those of the regressive planner.
+    bool Successive = false;
+    for (const std::string& Name : ActionNames)
+    {
+        if (Successive)
+        {
+            Path += ' ';
+        }
+        else
+        {
+            Successive = true;
+        }
+
+        Path += Name;
+    }
+
+    return Path;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,96 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Node.h"
+#include "OpenList.h"
+#include "Workspace.h"
+
+
+namespace GOAP
+{
+    class CAction;
+    class CSearchObserver;
+    class CState;
+    struct SPlannerStats;
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    enum class EFrontierBalance : unsigned char // How a bidirectional planner picks the frontier to expand next
+    {
+        Alternate,          // Take turns between the forward and regressive frontiers.
+        SmallerFrontier,    // Expand the frontier with fewer open nodes.
+        CheaperFrontier,    // Expand the frontier whose best open node has the lower total cost.
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    class CBidirectionalPlanner // Forward and regressive GOAP meeting in the middle
+    {
+    public:
+        explicit CBidirectionalPlanner(EFrontierBalance Balance = EFrontierBalance::SmallerFrontier) : mBalance(Balance) {}
+
+        // Formulate a plan from the input if possible. Return true if successful.
+        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth);
+        // Same as above but with the buffers of a given workspace, which keeps their capacity for later calls.
+        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace);
+        // Attach an observer to trace the search, or detach it with null.
+        void SetObserver(CSearchObserver* Value) { mObserver = Value; }
+        // Collect the statistics of each search into a given instance, or stop collecting them with null.
+        void SetStats(SPlannerStats* Value) { mStats = Value; }
+
+        EFrontierBalance GetBalance() const { return mBalance; }
+        void SetBalance(EFrontierBalance Value) { mBalance = Value; }
+
+    protected:
+        struct SMeeting // A forward node whose state satisfies the desired state of a regressive node
+        {
+            int ForwardIndex = -1;
+            int BackwardIndex = -1;
+            float Cost = std::numeric_limits<float>::infinity(); // Cost of the plan through both nodes
+        };
+
+        static constexpr int MaxMeetingGroups = 16; // Number of groups of regressive nodes, beyond which nodes join the groups of subsets of their facts
+
+        struct SMeetingGroup // Nodes indexed by their values of the facts constrained by some regressive nodes
+        {
+            std::vector<int> Facts;                             // Facts constrained by all the regressive nodes of this group
+            std::unordered_multimap<size_t, int> ForwardNodes;  // Forward nodes by the hashes of their values of the facts
+            std::unordered_multimap<size_t, int> BackwardNodes; // Regressive nodes by the hashes of their values of the facts
+        };
+
+        struct SBidirectionalScratch : CPlannerWorkspace::SScratch // Buffers of the regressive half and the meetings, besides the forward half in the workspace
+        {
+            std::vector<SNode> BackwardNodes;           // The regressive search tree
+            COpenList BackwardOpenList;                 // The regressive open set
+            std::vector<SMeetingGroup> MeetingGroups;   // Index to find the meetings
+            std::vector<int> MeetingFacts;              // Facts constrained by the regressive node being indexed
+
+            void Clear() override;
+        };
+
+        // Check if an action can be taken in a state or lead to a desired state, and record the check in the statistics if any.
+        bool CheckAction(const CAction& Action, const CState& State, bool Forward);
+        // Create a forward search node for a given action from a given node if feasible. Return its index, or -1 if infeasible.
+        int ExploreForward(CPlannerWorkspace& Workspace, int NodeIndex, const CAction& Action, const CState& GoalState);
+        // Create a regressive search node for a given action from a given node if feasible. Return its index, or -1 if infeasible.
+        int ExploreBackward(CPlannerWorkspace& Workspace, SBidirectionalScratch& Scratch, int NodeIndex, const CAction& Action, const CState& StartingState);
+        // Add a new node to the meeting index, and keep its cheapest meeting with the nodes of the opposite frontier within the max depth.
+        void FindMeeting(SMeeting& ioMeeting, const CPlannerWorkspace& Workspace, SBidirectionalScratch& Scratch, int NodeIndex, bool Forward, int MaxDepth) const;
+        // Keep a meeting of a forward node and a regressive node if it is valid and cheaper than the best one.
+        void CheckMeeting(SMeeting& ioMeeting, const CPlannerWorkspace& Workspace, const SBidirectionalScratch& Scratch, int ForwardIndex, int BackwardIndex, int MaxDepth) const;
+        // Hash the values of given facts in a state.
+        static size_t HashFacts(const CState& State, const std::vector<int>& Facts);
+        // List the actions on the forward path to the meeting and then on the regressive path from it.
+        void BuildPlan(std::vector<const CAction*>& oSteps, const CPlannerWorkspace& Workspace, const SBidirectionalScratch& Scratch, const SMeeting& Meeting);
+        // Return concatenated names of the actions on the path of a given node in the execution order.
+        std::string StringizePath(const std::vector<SNode>& Nodes, int NodeIndex, bool Forward) const;
+
+    protected:
+        EFrontierBalance mBalance;
+        CSearchObserver* mObserver = nullptr; // Optional observer tracing the search
+        SPlannerStats* mStats = nullptr; // Optional statistics of the last search
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,54 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+namespace GOAP
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    using BMaskWord = uint64_t; // A word of bitmasks
+    constexpr int MaskWordBits = 64;
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Return the number of set bits in a word.
+    inline int CountBits(BMaskWord Word)
+    {
+#if defined(_MSC_VER) && defined(_M_X64)
+        return static_cast<int>(__popcnt64(Word));
+#elif defined(__GNUC__)
+        return __builtin_popcountll(Word);
+#else
+        int Count = 0;
+        for (; Word; Word &= Word - 1)
+        {
+            Count++;
+        }
+        return Count;
+#endif
+    }
+
+    // Return the position of the lowest set bit in a non-zero word.
+    inline int FindLowestBit(BMaskWord Word)
+    {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long Position;
+        _BitScanForward64(&Position, Word);
+        return static_cast<int>(Position);
+#elif defined(__GNUC__)
+        return __builtin_ctzll(Word);
+#else
+        int Position = 0;
+        for (; !(Word & 1); Word >>= 1)
+        {
+            Position++;
+        }
+        return Position;
+#endif
+    }
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,13 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+
+namespace GOAP
+{
+    enum EPlannerFlag : unsigned
+    {
+        DetectDuplicates    = 1 << 0, // Keep the reached states and skip paths that reach a state at no lower cost (forward search only).
+        DeltaStates         = 1 << 1, // Store no states in the search nodes but rebuild them from the effects on their paths (forward search from a plain CState only).
+    };
+}
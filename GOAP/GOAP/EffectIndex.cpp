@@ -0,0 +1,84 @@
+// Copyright 2026 Isaac Hsu
+
+#include <algorithm>
+#include <numeric>
+
+#include "Action.h"
+#include "EffectIndex.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void CEffectIndex::Build(const std::vector<const CAction*>& Actions)
+{
+    mActions.assign(Actions.begin(), Actions.end());
+    mActionCount = static_cast<int>(Actions.size());
+    mWordCount = (mActionCount + MaskWordBits - 1) / MaskWordBits;
+    mEntries.clear();
+    mActionBits.clear();
+    mEffects.clear();
+
+    for (int ActionIndex = 0; ActionIndex < mActionCount; ++ActionIndex)
+    {
+        for (const CState::SFact& Effect : Actions[ActionIndex]->GetEffect())
+        {
+            mEffects.emplace_back(Effect, ActionIndex);
+        }
+    }
+
+    std::sort(mEffects.begin(), mEffects.end());
+    mFactEntries.assign(mEffects.empty() ? 1 : mEffects.back().first.first + 2, 0);
+
+    for (size_t i = 0; i < mEffects.size(); i++)
+    {
+        const auto& [Effect, ActionIndex] = mEffects[i];
+        if (i == 0 || mEffects[i - 1].first != Effect)
+        {
+            mEntries.push_back({ Effect.second, static_cast<int>(mActionBits.size()) });
+            mActionBits.resize(mActionBits.size() + mWordCount, 0);
+            mFactEntries[Effect.first + 1]++;
+        }
+
+        mActionBits[mEntries.back().FirstWord + ActionIndex / MaskWordBits] |= BMaskWord(1) << (ActionIndex % MaskWordBits);
+    }
+
+    std::partial_sum(mFactEntries.begin(), mFactEntries.end(), mFactEntries.begin());
+}
+
+bool CEffectIndex::AddActions(std::vector<BMaskWord>& ioActionBits, const CState::SFact& Effect) const
+{
+    if (Effect.first < 0 || Effect.first + 1 >= static_cast<int>(mFactEntries.size()))
+    {
+        return false;
+    }
+
+    for (int EntryIndex = mFactEntries[Effect.first]; EntryIndex < mFactEntries[Effect.first + 1]; EntryIndex++)
+    {
+        if (mEntries[EntryIndex].Value == Effect.second)
+        {
+            const BMaskWord* Bits = &mActionBits[mEntries[EntryIndex].FirstWord];
+            for (int WordIndex = 0; WordIndex < mWordCount; WordIndex++)
+            {
+                ioActionBits[WordIndex] |= Bits[WordIndex];
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CEffectIndex::TakeActions(std::vector<int>& oActionIndexes, std::vector<BMaskWord>& ioActionBits)
+{
+    oActionIndexes.clear();
+
+    for (size_t WordIndex = 0; WordIndex < ioActionBits.size(); WordIndex++)
+    {
+        for (BMaskWord Word = ioActionBits[WordIndex]; Word; Word &= Word - 1)
+        {
+            oActionIndexes.push_back(static_cast<int>(WordIndex) * MaskWordBits + FindLowestBit(Word));
+        }
+        ioActionBits[WordIndex] = 0;
+    }
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
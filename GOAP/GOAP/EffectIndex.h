@@ -0,0 +1,51 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "BitUtility.h"
+#include "State.h"
+
+
+namespace GOAP
+{
+    class CAction;
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Lookup table from effects to the bitsets of the actions having them. Build it once for a set of actions and share it among planners.
+    class CEffectIndex
+    {
+    public:
+        // Index the effects of actions, reusing the capacity of the previous index.
+        void Build(const std::vector<const CAction*>& Actions);
+        // Return the number of actions indexed, which are identified by their positions in the list passed to Build.
+        int GetActionCount() const { return mActionCount; }
+        // Is this index built from the same action instances in the same order? Actions modified in place after Build aren't detected.
+        bool IsBuiltFrom(const std::vector<const CAction*>& Actions) const { return mActions == Actions; }
+        // Return the number of words in a bitset of the indexed actions.
+        int GetWordCount() const { return mWordCount; }
+        // Set the bits of the actions having a given effect in a bitset of GetWordCount words. Return false if no actions have it.
+        bool AddActions(std::vector<BMaskWord>& ioActionBits, const CState::SFact& Effect) const;
+        // List the indexes of the actions in a bitset in ascending order and clear the bitset.
+        static void TakeActions(std::vector<int>& oActionIndexes, std::vector<BMaskWord>& ioActionBits);
+
+    private:
+        using SEffectEntry = std::pair<CState::SFact, int>; // An effect and the index of the action having it
+
+        struct SEntry
+        {
+            BProperty Value = 0;    // Value of the effect
+            int FirstWord = 0;      // First word of the bitset of the actions having the effect in mActionBits
+        };
+
+        std::vector<int> mFactEntries;          // First entry of each fact index in mEntries, followed by the end of the last fact
+        std::vector<SEntry> mEntries;           // Distinct effects grouped by fact indexes
+        std::vector<BMaskWord> mActionBits;     // Bitsets of the actions having the effects
+        std::vector<SEffectEntry> mEffects;     // Effects of all actions sorted for grouping, used while building
+        std::vector<const CAction*> mActions;   // Actions passed to Build, which fingerprint the action list
+        int mActionCount = 0;
+        int mWordCount = 0;
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,55 @@
+// Copyright 2026 Isaac Hsu
+
+#include <mutex>
+
+#include "Fact.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+CFactRegistry& CFactRegistry::GetInstance()
+{
+    static CFactRegistry Instance;
+    return Instance;
+}
+
+int CFactRegistry::Intern(const std::string& Name)
+{
+    {
+        std::shared_lock Lock(mMutex);
+        auto it = mIndexMap.find(Name);
+        if (it != mIndexMap.end())
+        {
+            return it->second;
+        }
+    }
+
+    std::unique_lock Lock(mMutex);
+    auto [it, Inserted] = mIndexMap.try_emplace(Name, static_cast<int>(mNames.size()));
+    if (Inserted)
+    {
+        mNames.push_back(Name);
+    }
+
+    return it->second;
+}
+
+int CFactRegistry::Find(const std::string& Name) const
+{
+    std::shared_lock Lock(mMutex);
+    auto it = mIndexMap.find(Name);
+    return it != mIndexMap.end() ? it->second : InvalidIndex;
+}
+
+const std::string& CFactRegistry::GetName(int Index) const
+{
+    std::shared_lock Lock(mMutex);
+    return mNames[Index];
+}
+
+int CFactRegistry::GetCount() const
+{
+    std::shared_lock Lock(mMutex);
+    return static_cast<int>(mNames.size());
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,38 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+
+namespace GOAP
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    class CFactRegistry // Process-wide registry interning fact names into dense indexes shared by all states
+    {
+    public:
+        static constexpr int InvalidIndex = -1;
+
+        static CFactRegistry& GetInstance();
+
+        // Return the index of a fact, registering the name if it's new.
+        int Intern(const std::string& Name);
+        // Return the index of a registered fact, or InvalidIndex if the name is unknown.
+        int Find(const std::string& Name) const;
+        // Return the name of a registered fact.
+        const std::string& GetName(int Index) const;
+        // Return the number of registered facts.
+        int GetCount() const;
+
+    private:
+        CFactRegistry() = default;
+
+        std::unordered_map<std::string, int> mIndexMap;
+        std::deque<std::string> mNames; // Deque keeps references to names valid while facts are being registered.
+        mutable std::shared_mutex mMutex;
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -1,90 +1,403 @@
 // Copyright 2024 Isaac Hsu
 
-#include <iostream>
-#include <map>
+#include <algorithm>
 #include <typeinfo>
 
 #include "Action.h"
 #include "ForwardPlanner.h"
 #include "Node.h"
+#include "Observer.h"
+#include "PlannerStats.h"
+#include "RelaxedHeuristic.h"
 
 
 using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void CForwardPlanner::SForwardScratch::Clear()
+{
+    ReachedMap.clear();
+    ApplicableActions.clear();
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void CForwardPlanner::SDeltaScratch::Clear()
+{
+    ReachedHashes.clear();
+    for (SCachedState& Entry : StateCache)
+    {
+        Entry.NodeIndex = -1;
+    }
+}
+
+void CForwardPlanner::SDeltaScratch::MaterializeState(CState& oState, const std::vector<SNode>& Nodes, int NodeIndex, const CState& StartingState)
+{
+    const CState* Base = &StartingState;
+    Path.clear();
+
+    while (Nodes[NodeIndex].Parent >= 0)
+    {
+        auto itCached = std::find_if(StateCache.begin(), StateCache.end(), [NodeIndex](const SCachedState& Entry) { return Entry.NodeIndex == NodeIndex; });
+        if (itCached != StateCache.end())
+        {
+            Base = &itCached->State;
+            break;
+        }
+
+        Path.push_back(NodeIndex);
+        NodeIndex = Nodes[NodeIndex].Parent;
+    }
+
+    if (&oState != Base)
+    {
+        oState = *Base; // Copy assignment reuses the capacity of the target.
+    }
+
+    for (auto it = Path.rbegin(); it != Path.rend(); it++)
+    {
+        const CAction& Action = *Nodes[*it].Action;
+        Action.GetEffect().Overwrite(oState);
+        Action.Affect(oState);
+    }
+}
+
+const CState& CForwardPlanner::SDeltaScratch::CacheState(const std::vector<SNode>& Nodes, int NodeIndex, const CState& StartingState)
+{
+    if (StateCache.empty())
+    {
+        StateCache.resize(StateCacheSize);
+    }
+
+    for (const SCachedState& Entry : StateCache)
+    {
+        if (Entry.NodeIndex == NodeIndex)
+        {
+            return Entry.State;
+        }
+    }
 
+    SCachedState& Slot = StateCache[NextCacheSlot];
+    NextCacheSlot = (NextCacheSlot + 1) % StateCacheSize;
+    MaterializeState(Slot.State, Nodes, NodeIndex, StartingState); // The slot may hold an ancestor, which serves as the base in place.
+    Slot.NodeIndex = NodeIndex;
+    return Slot.State;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
 bool CForwardPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
 {
-    std::cout << typeid(*this).name() << std::endl;
-    std::cout << "START: {" << StartingState.ToString() << "}" << std::endl;
-    std::cout << "GOAL : {" << GoalState.ToString() << "}" << std::endl;
+    CPlannerWorkspace Workspace;
+    return Plan(oSteps, StartingState, GoalState, Actions, MaxDepth, Workspace);
+}
+
+bool CForwardPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace)
+{
+    if (mObserver)
+    {
+        mObserver->OnStart(typeid(*this).name(), StartingState, GoalState);
+    }
+
+    if (mStats)
+    {
+        mStats->Reset();
+    }
 
     int Step = 0;
     oSteps.clear();
     MaxDepth = std::max(MaxDepth, 0);
 
-    std::vector<SNode> Nodes;
+    Workspace.Clear();
+    SForwardScratch& Scratch = Workspace.GetScratch<SForwardScratch>();
+    const CSuccessorGenerator& SuccessorGenerator = SelectSuccessorGenerator(Scratch, Actions);
+    std::vector<SNode>& Nodes = Workspace.GetNodes();
     Nodes.reserve(Actions.size() * MaxDepth);
 
     SNode& RootNode = Nodes.emplace_back();
     RootNode.ConstState = &StartingState;
-    RootNode.BaseHeuristicCost = static_cast<float>(GoalState.CountUnsatisfiedProperties(StartingState));
+    RootNode.BaseHeuristicCost = GetBaseHeuristicCost(StartingState, GoalState);
     RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalState);
 
-    std::multimap<float, int> OpenMap; // The open set in A*
-    OpenMap.emplace(RootNode.GetTotalCost(), 0);
+    COpenList& OpenList = Workspace.GetOpenList(); // The open set in A*
+    OpenList.Push(RootNode.GetTotalCost(), 0);
 
-    while (!OpenMap.empty())
+    // In the delta mode, nodes store no states, and the expanded states are rebuilt from their paths.
+    // Custom state types may hold members that effects cannot rebuild, so they always use full states.
+    const bool UseDeltas = (mFlags & DeltaStates) && typeid(StartingState) == typeid(CState);
+    SDeltaScratch* DeltaScratch = UseDeltas ? &Workspace.GetScratch<SDeltaScratch>() : nullptr;
+
+    CReachedStateMap& ReachedMap = Scratch.ReachedMap; // The closed set in A*, which also tracks the open nodes to find cheaper paths to them
+    CReachedStateMap* ReachedMapPtr = nullptr;
+    if ((mFlags & DetectDuplicates) && UseDeltas)
+    {
+        DeltaScratch->ReachedHashes.reserve(Actions.size() * MaxDepth);
+        DeltaScratch->ReachedHashes.emplace(StartingState.GetHash(), 0);
+    }
+    else if (mFlags & DetectDuplicates)
+    {
+        ReachedMap.reserve(Actions.size() * MaxDepth);
+        ReachedMap.emplace(&StartingState, 0);
+        ReachedMapPtr = &ReachedMap;
+    }
+
+    while (!OpenList.IsEmpty())
     {
-        auto itCurr = OpenMap.begin();
-        const int CurrIndex = itCurr->second;
+        const int CurrIndex = OpenList.GetTop();
         SNode& CurrNode = Nodes[CurrIndex];
+        const CState& CurrState = UseDeltas ? DeltaScratch->CacheState(Nodes, CurrIndex, StartingState) : *CurrNode.ConstState;
+
+        if (mStats)
+        {
+            mStats->AddExpansion(OpenList.GetSize());
+        }
+
+        if (mObserver)
+        {
+            auto GetNode = [&]
+            {
+                SNode Node = CurrNode;
+                Node.ConstState = &CurrState;
+                return Node.ToString();
+            };
+            mObserver->OnExpand(++Step, static_cast<int>(Nodes.size()), [&] { return StringizePath(Nodes, CurrIndex); }, GetNode);
+        }
 
-        std::cout << "#" << ++Step << " #Nodes=" << Nodes.size() << " |" << StringizePath(Nodes, CurrIndex) << "| " << CurrNode.ToString() << std::endl;
+        CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime);
+        const bool Reached = GoalState.IsSatisfiedBy(CurrState);
+        GoalTestTimer.Stop();
 
-        if (GoalState.IsSatisfiedBy(*CurrNode.ConstState))
+        if (Reached)
         {
             BuildPlan(oSteps, Nodes, CurrIndex);
             return true;
         }
 
-        OpenMap.erase(itCurr);
+        OpenList.Pop();
 
         if (CurrNode.Depth >= MaxDepth)
         {
             continue;
         }
 
-        for (const CAction* Action : Actions)
+        CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
+        SuccessorGenerator.GetApplicableActions(Scratch.ApplicableActions, CurrState);
+        PreconditionTimer.Stop();
+
+        if (mStats)
+        {
+            mStats->PrunedCount += static_cast<long long>(Actions.size() - Scratch.ApplicableActions.size()); // The generator rejects the inapplicable actions at once.
+        }
+
+        for (int ActionIndex : Scratch.ApplicableActions)
         {
-            Explore(OpenMap, Nodes, CurrIndex, *Action, GoalState);
+            const CAction* Action = Actions[ActionIndex];
+            if (!CheckListedAction(SuccessorGenerator, ActionIndex, *Action, CurrState))
+            {
+                continue;
+            }
+
+            if (UseDeltas)
+            {
+                ExploreDelta(Workspace, *DeltaScratch, CurrIndex, CurrState, *Action, StartingState, GoalState);
+            }
+            else
+            {
+                Explore(OpenList, Nodes, Workspace.GetStateArena(), ReachedMapPtr, CurrIndex, *Action, GoalState);
+            }
         }
     }
 
     return false;
 }
 
-void CForwardPlanner::Explore(std::multimap<float, int>& oOpenMap, std::vector<SNode>& Nodes, int NodeIndex, const CAction& Action, const CState& GoalState)
+void CForwardPlanner::Explore(COpenList& oOpenList, std::vector<SNode>& Nodes, CStateArena& oStateArena, CReachedStateMap* ioReachedMap, int NodeIndex, const CAction& Action, const CState& GoalState)
 {
-    if (!Action.CheckPrecondition(*Nodes[NodeIndex].ConstState))
-    {
-        return;
-    }
-
     int ChildIndex = static_cast<int>(Nodes.size());
     SNode& ChildNode = Nodes.emplace_back();
     SNode& CurrNode = Nodes[NodeIndex];
     ChildNode.Action = &Action;
-    ChildNode.MutableState = CurrNode.ConstState->Clone();
+    CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+    ChildNode.MutableState = CurrNode.ConstState->CloneInto(oStateArena);
     Action.GetEffect().Overwrite(*ChildNode.MutableState);
     Action.Affect(*ChildNode.MutableState);
-    ChildNode.ConstState = ChildNode.MutableState.get();
+    CloneTimer.Stop();
+    ChildNode.ConstState = ChildNode.MutableState;
     ChildNode.Parent = NodeIndex;
     ChildNode.Depth = CurrNode.Depth + 1;
     ChildNode.PreviousCost = CurrNode.GetActualCost();
     ChildNode.CurrentCost = Action.GetCost(*CurrNode.ConstState, *ChildNode.ConstState);
-    ChildNode.BaseHeuristicCost = static_cast<float>(GoalState.CountUnsatisfiedProperties(*ChildNode.ConstState));
+
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    if (ioReachedMap)
+    {
+        auto [itReached, Inserted] = ioReachedMap->try_emplace(ChildNode.ConstState, ChildIndex);
+        if (!Inserted)
+        {
+            if (mStats)
+            {
+                mStats->DuplicateCount++;
+            }
+
+            if (Nodes[itReached->second].GetActualCost() <= ChildNode.GetActualCost())
+            {
+                Nodes.pop_back(); // Discard the duplicate, because the state has been reached at no higher cost.
+                oStateArena.DestroyLast();
+                return;
+            }
+
+            const int ReachedIndex = itReached->second;
+            if (oOpenList.Contains(ReachedIndex))
+            {
+                SNode& ReachedNode = Nodes[ReachedIndex]; // Redirect the open node to the cheaper path and decrease its key.
+                ReachedNode.Action = ChildNode.Action;
+                ReachedNode.Parent = ChildNode.Parent;
+                ReachedNode.Depth = ChildNode.Depth;
+                ReachedNode.PreviousCost = ChildNode.PreviousCost;
+                ReachedNode.CurrentCost = ChildNode.CurrentCost;
+                Nodes.pop_back();
+                oStateArena.DestroyLast();
+                oOpenList.Push(ReachedNode.GetTotalCost(), ReachedIndex);
+                return;
+            }
+
+            itReached->second = ChildIndex; // Reopen the closed state with the cheaper path.
+        }
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
+    ChildNode.BaseHeuristicCost = GetBaseHeuristicCost(*ChildNode.ConstState, GoalState);
     ChildNode.ExtraHeuristicCost = ChildNode.ConstState->GetExtraHeuristicCost(GoalState);
+    HeuristicTimer.Stop();
     float TotalCost = ChildNode.GetTotalCost();
-    oOpenMap.emplace(TotalCost, ChildIndex);
+    oOpenList.Push(TotalCost, ChildIndex);
+}
+
+void CForwardPlanner::ExploreDelta(CPlannerWorkspace& Workspace, SDeltaScratch& Scratch, int NodeIndex, const CState& CurrState, const CAction& Action, const CState& StartingState, const CState& GoalState)
+{
+    CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+    CState& ChildState = Scratch.ChildState; // Evaluate the successor in a reused buffer, and keep only the action in the node.
+    ChildState = CurrState;
+    Action.GetEffect().Overwrite(ChildState);
+    Action.Affect(ChildState);
+    CloneTimer.Stop();
+
+    std::vector<SNode>& Nodes = Workspace.GetNodes();
+    COpenList& OpenList = Workspace.GetOpenList();
+    int ChildIndex = static_cast<int>(Nodes.size());
+    SNode& ChildNode = Nodes.emplace_back();
+    SNode& CurrNode = Nodes[NodeIndex];
+    ChildNode.Action = &Action;
+    ChildNode.Parent = NodeIndex;
+    ChildNode.Depth = CurrNode.Depth + 1;
+    ChildNode.PreviousCost = CurrNode.GetActualCost();
+    ChildNode.CurrentCost = Action.GetCost(CurrState, ChildState);
+
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    if (mFlags & DetectDuplicates)
+    {
+        CReachedHashMap& ReachedHashes = Scratch.ReachedHashes;
+        auto [itFirst, itLast] = ReachedHashes.equal_range(ChildState.GetHash());
+        auto itReached = itLast;
+        for (auto it = itFirst; it != itLast; it++)
+        {
+            Scratch.MaterializeState(Scratch.ProbeState, Nodes, it->second, StartingState);
+            if (Scratch.ProbeState.IsIdentical(ChildState))
+            {
+                itReached = it;
+                break;
+            }
+        }
+
+        if (itReached == itLast)
+        {
+            ReachedHashes.emplace_hint(itLast, ChildState.GetHash(), ChildIndex);
+        }
+        else
+        {
+            if (mStats)
+            {
+                mStats->DuplicateCount++;
+            }
+
+            if (Nodes[itReached->second].GetActualCost() <= ChildNode.GetActualCost())
+            {
+                Nodes.pop_back(); // Discard the duplicate, because the state has been reached at no higher cost.
+                return;
+            }
+
+            const int ReachedIndex = itReached->second;
+            if (OpenList.Contains(ReachedIndex))
+            {
+                SNode& ReachedNode = Nodes[ReachedIndex]; // Redirect the open node to the cheaper path, which leads to the same state.
+                ReachedNode.Action = ChildNode.Action;
+                ReachedNode.Parent = ChildNode.Parent;
+                ReachedNode.Depth = ChildNode.Depth;
+                ReachedNode.PreviousCost = ChildNode.PreviousCost;
+                ReachedNode.CurrentCost = ChildNode.CurrentCost;
+                Nodes.pop_back();
+                OpenList.Push(ReachedNode.GetTotalCost(), ReachedIndex);
+                return;
+            }
+
+            itReached->second = ChildIndex; // Reopen the closed state with the cheaper path.
+        }
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
+    ChildNode.BaseHeuristicCost = GetBaseHeuristicCost(ChildState, GoalState);
+    ChildNode.ExtraHeuristicCost = ChildState.GetExtraHeuristicCost(GoalState);
+    HeuristicTimer.Stop();
+    float TotalCost = ChildNode.GetTotalCost();
+    OpenList.Push(TotalCost, ChildIndex);
+}
+
+const CSuccessorGenerator& CForwardPlanner::SelectSuccessorGenerator(SForwardScratch& Scratch, const std::vector<const CAction*>& Actions) const
+{
+    if (mSuccessorGenerator && mSuccessorGenerator->IsBuiltFrom(Actions))
+    {
+        return *mSuccessorGenerator;
+    }
+
+    Scratch.SuccessorGenerator.Build(Actions); // Fall back on a per-call generator if the shared one is missing or mismatched.
+    return Scratch.SuccessorGenerator;
+}
+
+bool CForwardPlanner::CheckPrecondition(const CAction& Action, const CState& State)
+{
+    CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
+    const bool Applicable = Action.CheckPrecondition(State);
+    PreconditionTimer.Stop();
+
+    if (mStats)
+    {
+        mStats->AddCheck(Action, Applicable);
+    }
+
+    return Applicable;
+}
+
+bool CForwardPlanner::CheckListedAction(const CSuccessorGenerator& Generator, int ActionIndex, const CAction& Action, const CState& State)
+{
+    if (Generator.NeedsCheck(ActionIndex))
+    {
+        return CheckPrecondition(Action, State);
+    }
+
+    if (mStats)
+    {
+        mStats->AddCheck(Action, true); // The generator has checked the preconditions of the plain action.
+    }
+
+    return true;
+}
+
+float CForwardPlanner::GetBaseHeuristicCost(const CState& State, const CState& GoalState) const
+{
+    return mHeuristic ? mHeuristic->Evaluate(State, GoalState) : static_cast<float>(GoalState.CountUnsatisfiedProperties(State));
 }
 
 void CForwardPlanner::BuildPlan(std::vector<const CAction*>& oSteps, const std::vector<SNode>& Nodes, int NodeIndex)
@@ -2,30 +2,104 @@
 
 #pragma once
 
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "Common.h"
+#include "OpenList.h"
+#include "State.h"
+#include "SuccessorGenerator.h"
+#include "Workspace.h"
+
 
 namespace GOAP
 {
     class CAction;
-    class CState;
+    class CRelaxedHeuristic;
+    class CSearchObserver;
     struct SNode;
+    struct SPlannerStats;
     ///////////////////////////////////////////////////////////////////////////////////////////////
     class CForwardPlanner // Forward GOAP
     {
+    protected:
+        using CReachedStateMap = std::unordered_map<const CState*, int, SStateHash, SStateEqual>; // Mapping of reached states to their cheapest nodes
+        using CReachedHashMap = std::unordered_multimap<size_t, int>; // Mapping of the hashes of reached states to their cheapest nodes in the delta mode
+
+        struct SForwardScratch : CPlannerWorkspace::SScratch // Buffers of forward searches
+        {
+            CReachedStateMap ReachedMap;            // The closed set for duplicate detection
+            CSuccessorGenerator SuccessorGenerator; // Decision tree built per call if no shared one is set
+            std::vector<int> ApplicableActions;     // Indexes of the actions applicable to the node being expanded
+
+            void Clear() override;
+        };
+
+        struct SDeltaScratch : CPlannerWorkspace::SScratch // Buffers of the delta mode, where nodes keep only their actions as deltas
+        {
+            static constexpr int StateCacheSize = 16; // Number of recently expanded states kept
+
+            struct SCachedState
+            {
+                int NodeIndex = -1;
+                CState State;
+            };
+
+            CReachedHashMap ReachedHashes;          // The closed set for duplicate detection
+            std::vector<SCachedState> StateCache;   // Ring buffer of recently expanded states
+            int NextCacheSlot = 0;                  // Slot of the state cache to overwrite next
+            CState ChildState;                      // Successor state evaluated before it is reduced to a delta
+            CState ProbeState;                      // Reached state materialized to confirm a hash match
+            std::vector<int> Path;                  // Nodes whose effects are replayed during materialization
+
+            void Clear() override;
+            // Rebuild the state of a node by replaying the effects on its path from the closest cached ancestor.
+            void MaterializeState(CState& oState, const std::vector<SNode>& Nodes, int NodeIndex, const CState& StartingState);
+            // Materialize the state of a node into the cache. The reference stays valid until StateCacheSize other nodes are cached.
+            const CState& CacheState(const std::vector<SNode>& Nodes, int NodeIndex, const CState& StartingState);
+        };
+
     public:
+        explicit CForwardPlanner(unsigned Flags = 0) : mFlags(Flags) {}
+
         // Formulate a plan from the input if possible. Return true if successful.
         bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth);
+        // Same as above but with the buffers of a given workspace, which keeps their capacity for later calls.
+        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace);
+        // Attach an observer to trace the search, or detach it with null.
+        void SetObserver(CSearchObserver* Value) { mObserver = Value; }
+        // Collect the statistics of each search into a given instance, or stop collecting them with null.
+        void SetStats(SPlannerStats* Value) { mStats = Value; }
+        // Estimate the base heuristic costs with a relaxed heuristic built from the same actions, or count unsatisfied properties with null.
+        void SetHeuristic(CRelaxedHeuristic* Value) { mHeuristic = Value; }
+        // Find the applicable actions with a successor generator built from the same actions, or build one in the workspace per call with null.
+        void SetSuccessorGenerator(const CSuccessorGenerator* Value) { mSuccessorGenerator = Value; }
 
     protected:
-        // Create a search node for a given action from a given node if feasible.
-        void Explore(std::multimap<float, int>& oOpenMap, std::vector<SNode>& Nodes, int NodeIndex, const CAction& Action, const CState& GoalState);
+        // Return the shared successor generator if it matches the actions, or build one in the scratch and return it.
+        const CSuccessorGenerator& SelectSuccessorGenerator(SForwardScratch& Scratch, const std::vector<const CAction*>& Actions) const;
+        // Check if an action can be taken in a state, and record the check in the statistics if any.
+        bool CheckPrecondition(const CAction& Action, const CState& State);
+        // Same as above but for an action listed by a successor generator, which is checked again only if it's of a derived class.
+        bool CheckListedAction(const CSuccessorGenerator& Generator, int ActionIndex, const CAction& Action, const CState& State);
+        // Return the base heuristic cost of a state by the selected heuristic.
+        float GetBaseHeuristicCost(const CState& State, const CState& GoalState) const;
+        // Create a search node for a given action applicable to a given node unless it's a duplicate. The reached state map is optional.
+        void Explore(COpenList& oOpenList, std::vector<SNode>& Nodes, CStateArena& oStateArena, CReachedStateMap* ioReachedMap, int NodeIndex, const CAction& Action, const CState& GoalState);
+        // Same as above but in the delta mode, where the new node keeps only its action as the delta from its parent.
+        void ExploreDelta(CPlannerWorkspace& Workspace, SDeltaScratch& Scratch, int NodeIndex, const CState& CurrState, const CAction& Action, const CState& StartingState, const CState& GoalState);
         // List the actions on the path to a given node.
         void BuildPlan(std::vector<const CAction*>& oSteps, const std::vector<SNode>& Nodes, int NodeIndex);
         // Return concatenated names of the actions on the path to a given node.
         std::string StringizePath(const std::vector<SNode>& Nodes, int NodeIndex) const;
+
+    protected:
+        unsigned mFlags = 0;
+        CSearchObserver* mObserver = nullptr; // Optional observer tracing the search
+        SPlannerStats* mStats = nullptr; // Optional statistics of the last search
+        CRelaxedHeuristic* mHeuristic = nullptr; // Optional heuristic replacing the count of unsatisfied properties
+        const CSuccessorGenerator* mSuccessorGenerator = nullptr; // Optional successor generator shared among calls
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
 }
@@ -5,7 +5,9 @@
 #include "Action.h"
 #include "AdvRegressionPlanner.h"
 #include "BackwardPlanner.h"
+#include "BidirectionalPlanner.h"
 #include "ForwardPlanner.h"
+#include "Observer.h"
 #include "RegressionPlanner.h"
 
 
@@ -14,30 +16,30 @@ namespace GOAP
 {
     bool CheckInput(const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions)
     {
-        std::unordered_set<std::string> UsedFacts;
+        std::unordered_set<int> UsedFacts;
         UsedFacts.reserve(GoalState.GetPropertyCount());
 
-        for (auto& [Name, Value] : GoalState)
+        for (const auto& [Index, Value] : GoalState)
         {
-            UsedFacts.insert(Name);
+            UsedFacts.insert(Index);
         }
 
         for (const CAction* Action : Actions)
         {
-            for (auto& [Name, Value] : Action->GetPrecondition())
+            for (const auto& [Index, Value] : Action->GetPrecondition())
             {
-                UsedFacts.insert(Name);
+                UsedFacts.insert(Index);
             }
 
-            for (auto& [Name, Value] : Action->GetEffect())
+            for (const auto& [Index, Value] : Action->GetEffect())
             {
-                UsedFacts.insert(Name);
+                UsedFacts.insert(Index);
             }
         }
 
-        for (const std::string& Name : UsedFacts)
+        for (int Index : UsedFacts)
         {
-            if (!StartingState.GetProperty(Name)) // Check if all used starting values have been set.
+            if (!StartingState.HasProperty(Index)) // Check if all used starting values have been set.
             {
                 return false;
             }
@@ -46,18 +48,19 @@ namespace GOAP
         return true;
     }
 
-    bool ForwardSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
+    bool ForwardSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, unsigned Flags, CSearchObserver* Observer)
     {
         if (!CheckInput(StartingState, GoalState, Actions))
         {
             return false;
         }
 
-        CForwardPlanner Planner;
+        CForwardPlanner Planner(Flags);
+        Planner.SetObserver(Observer);
         return Planner.Plan(oSteps, StartingState, GoalState, Actions, MaxDepth);
     }
 
-    bool BackwardSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
+    bool BackwardSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CSearchObserver* Observer)
     {
         if (!CheckInput(StartingState, GoalState, Actions))
         {
@@ -65,10 +68,11 @@ namespace GOAP
         }
 
         CBackwardPlanner Planner;
+        Planner.SetObserver(Observer);
         return Planner.Plan(oSteps, StartingState, GoalState, Actions, MaxDepth);
     }
 
-    bool RegressiveSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
+    bool RegressiveSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CSearchObserver* Observer)
     {
         if (!CheckInput(StartingState, GoalState, Actions))
         {
@@ -76,10 +80,11 @@ namespace GOAP
         }
 
         CRegressionPlanner Planner;
+        Planner.SetObserver(Observer);
         return Planner.Plan(oSteps, StartingState, GoalState, Actions, MaxDepth);
     }
 
-    bool AdvRegressiveSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
+    bool AdvRegressiveSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CSearchObserver* Observer)
     {
         if (!CheckInput(StartingState, GoalState, Actions))
         {
@@ -87,6 +92,19 @@ namespace GOAP
         }
 
         CAdvRegressionPlanner Planner;
+        Planner.SetObserver(Observer);
+        return Planner.Plan(oSteps, StartingState, GoalState, Actions, MaxDepth);
+    }
+
+    bool BidirectionalSearch(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CSearchObserver* Observer)
+    {
+        if (!CheckInput(StartingState, GoalState, Actions))
+        {
+            return false;
+        }
+
+        CBidirectionalPlanner Planner;
+        Planner.SetObserver(Observer);
         return Planner.Plan(oSteps, StartingState, GoalState, Actions, MaxDepth);
     }
 }
@@ -0,0 +1,188 @@
+// Copyright 2026 Isaac Hsu
+
+#include <algorithm>
+#include <limits>
+#include <typeinfo>
+
+#include "Action.h"
+#include "IDAStarPlanner.h"
+#include "Node.h"
+#include "Observer.h"
+#include "PlannerStats.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool CIDAStarPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
+{
+    CPlannerWorkspace Workspace;
+    return Plan(oSteps, StartingState, GoalState, Actions, MaxDepth, Workspace);
+}
+
+bool CIDAStarPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace)
+{
+    if (mObserver)
+    {
+        mObserver->OnStart(typeid(*this).name(), StartingState, GoalState);
+    }
+
+    if (mStats)
+    {
+        mStats->Reset();
+    }
+
+    int Step = 0;
+    oSteps.clear();
+    MaxDepth = std::max(MaxDepth, 0);
+
+    Workspace.Clear();
+    SIDAStarScratch& Scratch = Workspace.GetScratch<SIDAStarScratch>();
+    std::vector<SNode>& Nodes = Workspace.GetNodes(); // The current path, whose nodes are parents of the next ones
+    Nodes.reserve(MaxDepth + 1);
+
+    SNode& RootNode = Nodes.emplace_back();
+    RootNode.ConstState = &StartingState;
+    RootNode.BaseHeuristicCost = GetBaseHeuristicCost(StartingState, GoalState);
+    RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalState);
+
+    // Custom state types may hold members that can't be copied into the table through CState, so they search without it.
+    const bool UseTable = mTableSize > 0 && typeid(StartingState) == typeid(CState);
+    if (UseTable)
+    {
+        Scratch.Table.resize(mTableSize); // Stale entries are told apart by their stamps.
+    }
+
+    float Bound = RootNode.GetTotalCost();
+    if (Bound == std::numeric_limits<float>::infinity())
+    {
+        return false; // The goal is unreachable even on the relaxed problem.
+    }
+
+    for (;;)
+    {
+        ++Scratch.Stamp;
+        float NextBound = std::numeric_limits<float>::infinity();
+        if (Search(NextBound, Step, Workspace, Scratch, Bound, GoalState, Actions, MaxDepth, UseTable))
+        {
+            BuildPlan(oSteps, Nodes, static_cast<int>(Nodes.size()) - 1);
+            return true;
+        }
+
+        if (NextBound == std::numeric_limits<float>::infinity())
+        {
+            return false; // No node was cut off by the bound, so the whole tree within the max depth has been searched.
+        }
+
+        Bound = NextBound;
+    }
+}
+
+bool CIDAStarPlanner::Search(float& ioNextBound, int& ioStep, CPlannerWorkspace& Workspace, SIDAStarScratch& Scratch, float Bound, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, bool UseTable)
+{
+    std::vector<SNode>& Nodes = Workspace.GetNodes();
+    const int CurrIndex = static_cast<int>(Nodes.size()) - 1;
+
+    const float TotalCost = Nodes[CurrIndex].GetTotalCost();
+    if (TotalCost > Bound)
+    {
+        ioNextBound = std::min(ioNextBound, TotalCost);
+        return false;
+    }
+
+    if (mObserver)
+    {
+        mObserver->OnExpand(++ioStep, static_cast<int>(Nodes.size()), [&] { return StringizePath(Nodes, CurrIndex); }, [&] { return Nodes[CurrIndex].ToString(); });
+    }
+
+    if (mStats)
+    {
+        mStats->AddExpansion(static_cast<int>(Nodes.size())); // The path stands in for the open set.
+    }
+
+    CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime);
+    const bool Reached = GoalState.IsSatisfiedBy(*Nodes[CurrIndex].ConstState);
+    GoalTestTimer.Stop();
+
+    if (Reached)
+    {
+        return true;
+    }
+
+    if (Nodes[CurrIndex].Depth >= MaxDepth)
+    {
+        return false;
+    }
+
+    if (UseTable && !RecordTransposition(Scratch, Nodes[CurrIndex]))
+    {
+        if (mStats)
+        {
+            mStats->DuplicateCount++;
+        }
+
+        return false;
+    }
+
+    for (const CAction* Action : Actions)
+    {
+        if (!CheckPrecondition(*Action, *Nodes[CurrIndex].ConstState))
+        {
+            continue;
+        }
+
+        SNode& ChildNode = Nodes.emplace_back();
+        SNode& CurrNode = Nodes[CurrIndex];
+        ChildNode.Action = Action;
+        CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+        ChildNode.MutableState = CurrNode.ConstState->CloneInto(Workspace.GetStateArena());
+        Action->GetEffect().Overwrite(*ChildNode.MutableState);
+        Action->Affect(*ChildNode.MutableState);
+        CloneTimer.Stop();
+        ChildNode.ConstState = ChildNode.MutableState;
+        ChildNode.Parent = CurrIndex;
+        ChildNode.Depth = CurrNode.Depth + 1;
+        ChildNode.PreviousCost = CurrNode.GetActualCost();
+        ChildNode.CurrentCost = Action->GetCost(*CurrNode.ConstState, *ChildNode.ConstState);
+
+        if (mStats)
+        {
+            mStats->AddGeneration(ChildNode.Depth);
+        }
+
+        CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
+        ChildNode.BaseHeuristicCost = GetBaseHeuristicCost(*ChildNode.ConstState, GoalState);
+        ChildNode.ExtraHeuristicCost = ChildNode.ConstState->GetExtraHeuristicCost(GoalState);
+        HeuristicTimer.Stop();
+
+        if (Search(ioNextBound, ioStep, Workspace, Scratch, Bound, GoalState, Actions, MaxDepth, UseTable))
+        {
+            return true;
+        }
+
+        Nodes.pop_back(); // The arena releases states in the reverse order of creation, like the path does.
+        Workspace.GetStateArena().DestroyLast();
+    }
+
+    return false;
+}
+
+bool CIDAStarPlanner::RecordTransposition(SIDAStarScratch& Scratch, const SNode& Node)
+{
+    const CState& State = *Node.ConstState;
+    const size_t Hash = State.GetHash();
+    STransposition& Entry = Scratch.Table[Hash % Scratch.Table.size()];
+
+    // The earlier search of the same state had no less cost budget and depth left, so it has covered this one.
+    if (Entry.Stamp == Scratch.Stamp && Entry.Hash == Hash && Entry.Cost <= Node.GetActualCost() && Entry.Depth <= Node.Depth && Entry.State.IsIdentical(State))
+    {
+        return false;
+    }
+
+    Entry.Hash = Hash; // Always replace the entry, because recent states are the likeliest to recur.
+    Entry.Stamp = Scratch.Stamp;
+    Entry.Depth = Node.Depth;
+    Entry.Cost = Node.GetActualCost();
+    Entry.State = State; // Copy assignment reuses the capacity of the entry.
+    return true;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
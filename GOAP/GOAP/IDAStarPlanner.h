@@ -0,0 +1,58 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "ForwardPlanner.h"
+
+
+namespace GOAP
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Memory-bounded forward GOAP by iterative deepening A* (IDA*).
+    // The search keeps only the current path and a fixed-size transposition table, so it needs at most
+    // MaxDepth + 1 nodes and states plus TableSize table entries however hard the goal is.
+    class CIDAStarPlanner : public CForwardPlanner
+    {
+    public:
+        // A table size of 0 disables the transposition table, leaving only the path in memory.
+        explicit CIDAStarPlanner(int TableSize = 4096) : mTableSize(std::max(TableSize, 0)) {}
+
+        // Formulate a plan from the input if possible. Return true if successful.
+        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth);
+        // Same as above but with the buffers of a given workspace, which keeps their capacity for later calls.
+        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace);
+
+        int GetTableSize() const { return mTableSize; }
+
+    protected:
+        struct STransposition // A state searched in an iteration
+        {
+            size_t Hash = 0;
+            int Stamp = 0;      // Stamp of the iteration that searched the state
+            int Depth = 0;      // Depth of the state in that iteration
+            float Cost = 0.f;   // Actual cost of the state in that iteration
+            CState State;
+        };
+
+        struct SIDAStarScratch : CPlannerWorkspace::SScratch // Buffers of IDA* besides the path
+        {
+            std::vector<STransposition> Table;  // Fixed-size table of searched states, indexed by their hashes
+            int Stamp = 0;                      // Stamp of the current iteration, which outdates the entries of earlier ones
+
+            void Clear() override {}            // Entries of earlier searches are outdated by their stamps.
+        };
+
+        // Search depth-first from the last node of the path within a cost bound. Return true if a plan is found,
+        // or lower the next bound to the cheapest total cost beyond the bound.
+        bool Search(float& ioNextBound, int& ioStep, CPlannerWorkspace& Workspace, SIDAStarScratch& Scratch, float Bound, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, bool UseTable);
+        // Record a node in the transposition table. Return false if its state has been searched in this iteration at no higher cost and depth.
+        bool RecordTransposition(SIDAStarScratch& Scratch, const SNode& Node);
+
+    protected:
+        int mTableSize;
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -2,7 +2,6 @@
 
 #pragma once
 
-#include <memory>
 #include <string>
 
 
@@ -16,8 +15,9 @@ namespace GOAP
         // Action taken from the parent node to this node
         const CAction* Action = nullptr;
         // ConstState and MutableState point to the same state except that the mutable counterparts of const-only states (the starting and goal states) are null.
+        // Mutable states are owned by the state arena of the search.
         const CState* ConstState = nullptr;
-        std::unique_ptr<CState> MutableState;
+        CState* MutableState = nullptr;
 
         int Parent = -1;                // Index of the parent node
         int Depth = 0;                  // Depth of this node in the search tree
@@ -0,0 +1,220 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+
+namespace GOAP
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // An indexed d-ary min-heap of node indexes, used as the open set in A*.
+    // Entries with equal costs are ordered by node indexes so that nodes created earlier are popped earlier, like std::multimap did.
+    template <int Arity>
+    class CIndexedHeap
+    {
+        static_assert(Arity >= 2, "A heap needs at least 2 children per entry.");
+    public:
+        struct SEntry
+        {
+            float Cost = 0;
+            int NodeIndex = -1;
+        };
+
+        bool IsEmpty() const { return mEntries.empty(); }
+        int GetSize() const { return static_cast<int>(mEntries.size()); }
+        bool Contains(int NodeIndex) const { return NodeIndex < static_cast<int>(mPositions.size()) && mPositions[NodeIndex] != InvalidPosition; }
+
+        int GetTop() const { return mEntries.front().NodeIndex; }
+        float GetTopCost() const { return mEntries.front().Cost; }
+
+        // Remove all entries but keep the allocated memory
+        void Clear();
+        void Reserve(int Size);
+        // Add a node, or change its cost if it is in the heap already (decrease-key)
+        void Push(float Cost, int NodeIndex);
+        // Remove the node with the lowest cost and return its index
+        int Pop();
+        // Remove a node if it is in the heap
+        bool Remove(int NodeIndex);
+
+        // Get a copy of the entries ordered as they would be popped. Mainly for debugging.
+        std::vector<SEntry> GetSortedEntries() const;
+
+    private:
+        static constexpr int InvalidPosition = -1;
+
+        static bool IsBefore(const SEntry& Left, const SEntry& Right)
+        {
+            return Left.Cost < Right.Cost || (Left.Cost == Right.Cost && Left.NodeIndex < Right.NodeIndex);
+        }
+
+        void Place(int Position, const SEntry& Entry);
+        void SiftUp(int Position);
+        void SiftDown(int Position);
+
+        std::vector<SEntry> mEntries;   // The heap itself
+        std::vector<int> mPositions;    // The position of each node index in mEntries, or InvalidPosition
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    using COpenList = CIndexedHeap<4>; // The open set used by planners
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <int Arity>
+    void CIndexedHeap<Arity>::Clear()
+    {
+        for (const SEntry& Entry : mEntries)
+        {
+            mPositions[Entry.NodeIndex] = InvalidPosition;
+        }
+        mEntries.clear();
+    }
+
+    template <int Arity>
+    void CIndexedHeap<Arity>::Reserve(int Size)
+    {
+        mEntries.reserve(Size);
+        mPositions.reserve(Size);
+    }
+
+    template <int Arity>
+    void CIndexedHeap<Arity>::Push(float Cost, int NodeIndex)
+    {
+        if (NodeIndex >= static_cast<int>(mPositions.size()))
+        {
+            mPositions.resize(NodeIndex + 1, InvalidPosition);
+        }
+
+        int Position = mPositions[NodeIndex];
+        if (Position == InvalidPosition)
+        {
+            Position = static_cast<int>(mEntries.size());
+            mEntries.push_back({ Cost, NodeIndex });
+            mPositions[NodeIndex] = Position;
+            SiftUp(Position);
+        }
+        else
+        {
+            const float OldCost = mEntries[Position].Cost;
+            mEntries[Position].Cost = Cost;
+            if (Cost < OldCost)
+            {
+                SiftUp(Position);
+            }
+            else
+            {
+                SiftDown(Position);
+            }
+        }
+    }
+
+    template <int Arity>
+    int CIndexedHeap<Arity>::Pop()
+    {
+        const int NodeIndex = mEntries.front().NodeIndex;
+        Remove(NodeIndex);
+        return NodeIndex;
+    }
+
+    template <int Arity>
+    bool CIndexedHeap<Arity>::Remove(int NodeIndex)
+    {
+        if (!Contains(NodeIndex))
+        {
+            return false;
+        }
+
+        const int Position = mPositions[NodeIndex];
+        mPositions[NodeIndex] = InvalidPosition;
+
+        const SEntry Last = mEntries.back();
+        mEntries.pop_back();
+        if (Position < static_cast<int>(mEntries.size()))
+        {
+            const bool Up = IsBefore(Last, mEntries[Position]);
+            Place(Position, Last);
+            if (Up)
+            {
+                SiftUp(Position);
+            }
+            else
+            {
+                SiftDown(Position);
+            }
+        }
+
+        return true;
+    }
+
+    template <int Arity>
+    std::vector<typename CIndexedHeap<Arity>::SEntry> CIndexedHeap<Arity>::GetSortedEntries() const
+    {
+        std::vector<SEntry> Entries = mEntries;
+        std::sort(Entries.begin(), Entries.end(), IsBefore);
+        return Entries;
+    }
+
+    template <int Arity>
+    void CIndexedHeap<Arity>::Place(int Position, const SEntry& Entry)
+    {
+        mEntries[Position] = Entry;
+        mPositions[Entry.NodeIndex] = Position;
+    }
+
+    template <int Arity>
+    void CIndexedHeap<Arity>::SiftUp(int Position)
+    {
+        const SEntry Entry = mEntries[Position];
+
+        while (Position > 0)
+        {
+            const int ParentPosition = (Position - 1) / Arity;
+            if (!IsBefore(Entry, mEntries[ParentPosition]))
+            {
+                break;
+            }
+
+            Place(Position, mEntries[ParentPosition]);
+            Position = ParentPosition;
+        }
+
+        Place(Position, Entry);
+    }
+
+    template <int Arity>
+    void CIndexedHeap<Arity>::SiftDown(int Position)
+    {
+        const SEntry Entry = mEntries[Position];
+        const int Size = static_cast<int>(mEntries.size());
+
+        for (;;)
+        {
+            const int FirstChild = Position * Arity + 1;
+            if (FirstChild >= Size)
+            {
+                break;
+            }
+
+            const int LastChild = std::min(FirstChild + Arity, Size);
+            int BestChild = FirstChild;
+            for (int Child = FirstChild + 1; Child < LastChild; ++Child)
+            {
+                if (IsBefore(mEntries[Child], mEntries[BestChild]))
+                {
+                    BestChild = Child;
+                }
+            }
+
+            if (!IsBefore(mEntries[BestChild], Entry))
+            {
+                break;
+            }
+
+            Place(Position, mEntries[BestChild]);
+            Position = BestChild;
+        }
+
+        Place(Position, Entry);
+    }
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,197 @@
+// Copyright 2026 Isaac Hsu
+
+#include <algorithm>
+#include <typeinfo>
+
+#include "Action.h"
+#include "PlanCache.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool CPlanCache::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, uint64_t ActionSetVersion, const CPlanner& Planner)
+{
+    UpdateMask(Actions, ActionSetVersion);
+    if (!CheckInput(StartingState, GoalState))
+    {
+        oSteps.clear();
+        return false; // Like the interface functions, refuse the input before any cached plan can bypass the check.
+    }
+
+    std::unique_ptr<CState> StartingKey = MakeStartingKey(StartingState, GoalState);
+
+    size_t Hash = StartingKey->GetHash();
+    Hash ^= GoalState.GetHash() + 0x9e3779b9 + (Hash << 6) + (Hash >> 2);
+    Hash ^= std::hash<uint64_t>{}(ActionSetVersion) + 0x9e3779b9 + (Hash << 6) + (Hash >> 2);
+    Hash ^= std::hash<int>{}(MaxDepth) + 0x9e3779b9 + (Hash << 6) + (Hash >> 2);
+
+    auto [itFirst, itLast] = mIndex.equal_range(Hash);
+    for (auto it = itFirst; it != itLast; it++)
+    {
+        SEntry& Entry = *it->second;
+        if (Entry.ActionSetVersion != ActionSetVersion || Entry.MaxDepth != MaxDepth
+            || typeid(*Entry.StartingKey) != typeid(*StartingKey) || !Entry.StartingKey->IsIdentical(*StartingKey)
+            || typeid(*Entry.GoalKey) != typeid(GoalState) || !Entry.GoalKey->IsIdentical(GoalState))
+        {
+            continue;
+        }
+
+        if (!Validate(Entry.Steps, StartingState, GoalState))
+        {
+            mRejectionCount++;
+            Erase(it->second);
+            break;
+        }
+
+        mHitCount++;
+        mEntries.splice(mEntries.begin(), mEntries, it->second); // Mark the entry as the most recently used.
+        oSteps = Entry.Steps;
+        return true;
+    }
+
+    mMissCount++;
+    if (!Planner(oSteps, StartingState, GoalState, Actions, MaxDepth))
+    {
+        return false;
+    }
+
+    if (GetSize() >= mCapacity)
+    {
+        Erase(std::prev(mEntries.end())); // Evict the least recently used entry.
+    }
+
+    SEntry& Entry = mEntries.emplace_front();
+    Entry.Hash = Hash;
+    Entry.ActionSetVersion = ActionSetVersion;
+    Entry.MaxDepth = MaxDepth;
+    Entry.StartingKey = std::move(StartingKey);
+    Entry.GoalKey = GoalState.Clone();
+    Entry.Steps = oSteps;
+    mIndex.emplace(Hash, mEntries.begin());
+    return true;
+}
+
+void CPlanCache::Clear()
+{
+    mEntries.clear();
+    mIndex.clear();
+    mHasMask = false;
+    mHitCount = 0;
+    mMissCount = 0;
+    mRejectionCount = 0;
+}
+
+void CPlanCache::UpdateMask(const std::vector<const CAction*>& Actions, uint64_t ActionSetVersion)
+{
+    if (mHasMask && mMaskVersion == ActionSetVersion)
+    {
+        return;
+    }
+
+    mReadFacts.clear();
+    mUsedFacts.clear();
+    mReadsAllFacts = false;
+    for (const CAction* Action : Actions)
+    {
+        if (typeid(*Action) != typeid(CAction))
+        {
+            mReadsAllFacts = true; // Its overrides may read facts beyond the precondition.
+        }
+
+        for (const CState::SFact& Fact : Action->GetPrecondition())
+        {
+            if (Fact.first >= static_cast<int>(mReadFacts.size()))
+            {
+                mReadFacts.resize(Fact.first + 1);
+            }
+
+            mReadFacts[Fact.first] = true;
+            mUsedFacts.push_back(Fact.first);
+        }
+
+        for (const CState::SFact& Fact : Action->GetEffect())
+        {
+            mUsedFacts.push_back(Fact.first);
+        }
+    }
+
+    std::sort(mUsedFacts.begin(), mUsedFacts.end());
+    mUsedFacts.erase(std::unique(mUsedFacts.begin(), mUsedFacts.end()), mUsedFacts.end());
+    mMaskVersion = ActionSetVersion;
+    mHasMask = true;
+}
+
+bool CPlanCache::CheckInput(const CState& StartingState, const CState& GoalState) const
+{
+    for (int Index : mUsedFacts)
+    {
+        if (!StartingState.HasProperty(Index))
+        {
+            return false;
+        }
+    }
+
+    for (const CState::SFact& Fact : GoalState)
+    {
+        if (!StartingState.HasProperty(Fact.first))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::unique_ptr<CState> CPlanCache::MakeStartingKey(const CState& StartingState, const CState& GoalState) const
+{
+    if (mReadsAllFacts || typeid(StartingState) != typeid(CState))
+    {
+        return StartingState.Clone(); // Custom members or overrides may matter, so keep the whole state.
+    }
+
+    auto Key = std::make_unique<CState>();
+    for (const CState::SFact& Fact : StartingState)
+    {
+        bool Read = (Fact.first < static_cast<int>(mReadFacts.size()) && mReadFacts[Fact.first]) || GoalState.HasProperty(Fact.first);
+        if (Read)
+        {
+            Key->SetProperty(Fact.first, Fact.second);
+        }
+    }
+
+    return Key;
+}
+
+bool CPlanCache::Validate(const std::vector<const CAction*>& Steps, const CState& StartingState, const CState& GoalState) const
+{
+    std::unique_ptr<CState> State = StartingState.Clone();
+
+    for (const CAction* Action : Steps)
+    {
+        if (!Action->CheckPrecondition(*State))
+        {
+            return false;
+        }
+
+        Action->GetEffect().Overwrite(*State);
+        Action->Affect(*State);
+    }
+
+    return GoalState.IsSatisfiedBy(*State);
+}
+
+void CPlanCache::Erase(CEntryList::iterator itEntry)
+{
+    auto [itFirst, itLast] = mIndex.equal_range(itEntry->Hash);
+    for (auto it = itFirst; it != itLast; it++)
+    {
+        if (it->second == itEntry)
+        {
+            mIndex.erase(it);
+            break;
+        }
+    }
+
+    mEntries.erase(itEntry);
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
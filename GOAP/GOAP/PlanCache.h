@@ -0,0 +1,81 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "State.h"
+
+
+namespace GOAP
+{
+    class CAction;
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // LRU cache of plans in front of planners.
+    // Plans are keyed by the facts of the starting state that the actions or the goal read, the goal, the maximum depth, and an action-set version.
+    // Custom state types, and all states if any action is of a CAction subclass, are keyed by whole clones with their own GetHash and
+    // IsIdentical, since overrides such as CheckPrecondition, Affect or GetCustomCost may read any fact.
+    // Cached plans are replayed through CheckPrecondition and checked against the goal before they are returned.
+    // A cache is not thread-safe. Hold one per thread, or serialize the calls to it.
+    class CPlanCache
+    {
+    public:
+        using CPlanner = std::function<bool(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)>;
+
+        explicit CPlanCache(int Capacity) : mCapacity(Capacity > 0 ? Capacity : 1) {}
+
+        // Return a cached plan if it is still valid, or formulate a plan with a given planner and cache it if successful.
+        // Return false at once if the starting state lacks any fact used by the goal or the actions.
+        // Change the action-set version whenever the actions or their properties change.
+        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, uint64_t ActionSetVersion, const CPlanner& Planner);
+        // Remove all cached plans and reset the counters.
+        void Clear();
+
+        int GetSize() const { return static_cast<int>(mEntries.size()); }
+        int GetCapacity() const { return mCapacity; }
+        int GetHitCount() const { return mHitCount; }
+        int GetMissCount() const { return mMissCount; }
+        int GetRejectionCount() const { return mRejectionCount; } // Number of cached plans found invalid by the re-validation
+
+    private:
+        struct SEntry
+        {
+            size_t Hash = 0;
+            uint64_t ActionSetVersion = 0;
+            int MaxDepth = 0;
+            std::unique_ptr<CState> StartingKey;    // Relevant facts of the starting state, or a clone of a custom state
+            std::unique_ptr<CState> GoalKey;        // Clone of the goal
+            std::vector<const CAction*> Steps;
+        };
+
+        using CEntryList = std::list<SEntry>;
+
+        // Collect the facts read or used by the actions unless they are of the version collected last.
+        void UpdateMask(const std::vector<const CAction*>& Actions, uint64_t ActionSetVersion);
+        // Does the starting state set all the facts used by the goal and the actions, as the interface functions require?
+        bool CheckInput(const CState& StartingState, const CState& GoalState) const;
+        // Build the key of the starting state for the given goal and the actions of the mask.
+        std::unique_ptr<CState> MakeStartingKey(const CState& StartingState, const CState& GoalState) const;
+        // Do the steps lead from the starting state to the goal?
+        bool Validate(const std::vector<const CAction*>& Steps, const CState& StartingState, const CState& GoalState) const;
+        void Erase(CEntryList::iterator itEntry);
+
+        int mCapacity;
+        CEntryList mEntries;                                            // Cached plans from the most to the least recently used
+        std::unordered_multimap<size_t, CEntryList::iterator> mIndex;   // Mapping of key hashes to entries
+        std::vector<bool> mReadFacts;                                   // Facts read by the preconditions of the actions of mMaskVersion
+        std::vector<int> mUsedFacts;                                    // Facts of the preconditions and effects of the actions of mMaskVersion
+        bool mReadsAllFacts = false;                                    // Whether the actions of mMaskVersion may read any fact
+        uint64_t mMaskVersion = 0;
+        bool mHasMask = false;
+        int mHitCount = 0;
+        int mMissCount = 0;
+        int mRejectionCount = 0;
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -1,71 +1,209 @@
 // Copyright 2024 Isaac Hsu
 
-#include <iostream>
+#include <algorithm>
+#include <numeric>
 #include <typeinfo>
 
 #include "Action.h"
 #include "Node.h"
+#include "Observer.h"
+#include "PlannerStats.h"
 #include "RegressionPlanner.h"
+#include "RelaxedHeuristic.h"
+#include "Workspace.h"
 
 
 using namespace GOAP;
 ///////////////////////////////////////////////////////////////////////////////////////////////////
+void CRegressionPlanner::SRegressionScratch::Clear()
+{
+    Actions.clear();
+    ClosedMarks.clear();
+    for (std::vector<int>& NodeIndexes : FactNodes)
+    {
+        NodeIndexes.clear();
+    }
+    StaleNodes.clear();
+    MaxDepth = -1;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
 bool CRegressionPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
 {
-    std::cout << typeid(*this).name() << std::endl;
-    std::cout << "START: {" << StartingState.ToString() << "}" << std::endl;
-    std::cout << "GOAL : {" << GoalState.ToString() << "}" << std::endl;
+    CPlannerWorkspace Workspace;
+    return Plan(oSteps, StartingState, GoalState, Actions, MaxDepth, Workspace);
+}
+
+bool CRegressionPlanner::Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace)
+{
+    if (mObserver)
+    {
+        mObserver->OnStart(typeid(*this).name(), StartingState, GoalState);
+    }
+
+    if (mStats)
+    {
+        mStats->Reset();
+    }
 
-    int Step = 0;
     oSteps.clear();
     MaxDepth = std::max(MaxDepth, 0);
 
-    std::vector<SNode> Nodes;
+    Workspace.Clear();
+    SRegressionScratch& Scratch = Workspace.GetScratch<SRegressionScratch>();
+    Scratch.Actions.assign(Actions.begin(), Actions.end());
+    Scratch.MaxDepth = MaxDepth;
+    std::vector<SNode>& Nodes = Workspace.GetNodes();
     Nodes.reserve(Actions.size() * MaxDepth);
+    PrepareSearch(Actions, Workspace);
+
+    if (mHeuristic)
+    {
+        mHeuristic->Prepare(StartingState); // The starting state is fixed, so the costs of facts are computed once for all nodes.
+    }
 
     SNode& RootNode = Nodes.emplace_back();
     RootNode.ConstState = &GoalState;
-    RootNode.BaseHeuristicCost = static_cast<float>(GoalState.CountUnsatisfiedProperties(StartingState));
+    RootNode.BaseHeuristicCost = GetBaseHeuristicCost(GoalState, StartingState);
     RootNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(GoalState);
+    Scratch.ClosedMarks.push_back(false);
+    IndexNode(Scratch, GoalState, 0);
+
+    Workspace.GetOpenList().Push(RootNode.GetTotalCost(), 0);
+    return Search(oSteps, StartingState, Workspace, Scratch);
+}
+
+bool CRegressionPlanner::Replan(std::vector<const CAction*>& oSteps, const CState& StartingState, const std::vector<int>& ChangedFacts, CPlannerWorkspace& Workspace)
+{
+    oSteps.clear();
 
-    std::multimap<float, int> OpenMap; // The open set in A*
-    OpenMap.emplace(RootNode.GetTotalCost(), 0);
+    SRegressionScratch& Scratch = Workspace.GetScratch<SRegressionScratch>();
+    std::vector<SNode>& Nodes = Workspace.GetNodes();
+    if (Scratch.MaxDepth < 0 || Nodes.empty())
+    {
+        return false;
+    }
 
-    while (!OpenMap.empty())
+    if (mObserver)
     {
-        auto itCurr = OpenMap.begin();
-        const int CurrIndex = itCurr->second;
+        mObserver->OnStart(typeid(*this).name(), StartingState, *Nodes[0].ConstState);
+    }
+
+    if (mStats)
+    {
+        mStats->Reset();
+    }
+
+    // Costs are accumulated from the goal and don't depend on the starting state, so only the heuristic costs and goal tests of
+    // the nodes constraining the changed facts are stale. Custom and relaxed heuristics may read anything, so they repair all nodes.
+    const bool RepairAll = typeid(StartingState) != typeid(CState) || mHeuristic;
+    if (mHeuristic)
+    {
+        mHeuristic->Prepare(StartingState);
+    }
+
+    std::vector<int>& StaleNodes = Scratch.StaleNodes;
+    if (RepairAll)
+    {
+        StaleNodes.resize(Nodes.size());
+        std::iota(StaleNodes.begin(), StaleNodes.end(), 0);
+    }
+    else
+    {
+        StaleNodes.clear();
+        for (int Fact : ChangedFacts)
+        {
+            if (Fact >= 0 && Fact < static_cast<int>(Scratch.FactNodes.size()))
+            {
+                StaleNodes.insert(StaleNodes.end(), Scratch.FactNodes[Fact].begin(), Scratch.FactNodes[Fact].end());
+            }
+        }
+
+        std::sort(StaleNodes.begin(), StaleNodes.end()); // Repair each node once, in the order of creation.
+        StaleNodes.erase(std::unique(StaleNodes.begin(), StaleNodes.end()), StaleNodes.end());
+    }
+
+    COpenList& OpenList = Workspace.GetOpenList();
+
+    for (int NodeIndex : StaleNodes)
+    {
+        SNode& Node = Nodes[NodeIndex];
+        Node.BaseHeuristicCost = GetBaseHeuristicCost(*Node.ConstState, StartingState);
+        Node.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(*Node.ConstState);
+
+        if (!Scratch.ClosedMarks[NodeIndex] || Node.ConstState->IsSatisfiedBy(StartingState))
+        {
+            OpenList.Push(Node.GetTotalCost(), NodeIndex); // Update the key, or reopen a closed node as a plan candidate.
+        }
+        else
+        {
+            OpenList.Remove(NodeIndex); // Withdraw a reopened node that is no longer a plan candidate.
+        }
+    }
+
+    return Search(oSteps, StartingState, Workspace, Scratch);
+}
+
+bool CRegressionPlanner::Search(std::vector<const CAction*>& oSteps, const CState& StartingState, CPlannerWorkspace& Workspace, SRegressionScratch& Scratch)
+{
+    int Step = 0;
+    std::vector<SNode>& Nodes = Workspace.GetNodes();
+    std::vector<bool>& ClosedMarks = Scratch.ClosedMarks;
+    COpenList& OpenList = Workspace.GetOpenList(); // The open set in A*
+
+    while (!OpenList.IsEmpty())
+    {
+        const int CurrIndex = OpenList.GetTop();
         SNode& CurrNode = Nodes[CurrIndex];
 
+        if (mStats)
+        {
+            mStats->AddExpansion(OpenList.GetSize());
+        }
+
+        CStatsTimer GoalTestTimer(mStats, &SPlannerStats::GoalTestTime);
         bool Reached = CurrNode.ConstState->IsSatisfiedBy(StartingState);
-        std::cout << "#" << ++Step << " #Nodes=" << Nodes.size();
-        std::cout << " |" << ((Reached || CurrIndex == 0) ? "" : "? ") << StringizePath(Nodes, CurrIndex) << "| ";
-        std::cout << CurrNode.ToString() << std::endl;
+        GoalTestTimer.Stop();
+        if (mObserver)
+        {
+            auto GetPath = [&] { return ((Reached || CurrIndex == 0) ? "" : "? ") + StringizePath(Nodes, CurrIndex); };
+            mObserver->OnExpand(++Step, static_cast<int>(Nodes.size()), GetPath, [&] { return CurrNode.ToString(); });
+        }
+
         if (Reached)
         {
             BuildPlan(oSteps, Nodes, CurrIndex);
             return true;
         }
 
-        OpenMap.erase(itCurr);
+        OpenList.Pop();
+
+        const bool Reopened = ClosedMarks[CurrIndex]; // Reopened nodes have been expanded already.
+        ClosedMarks[CurrIndex] = true;
 
-        if (CurrNode.Depth >= MaxDepth)
+        if (Reopened || CurrNode.Depth >= Scratch.MaxDepth)
         {
             continue;
         }
 
-        for (const CAction* Action : Actions)
-        {
-            Explore(OpenMap, Nodes, CurrIndex, *Action, StartingState);
-        }
+        ExpandNode(Workspace, Scratch, CurrIndex, StartingState);
+        ClosedMarks.resize(Nodes.size(), false);
     }
 
     return false;
 }
 
-void CRegressionPlanner::Explore(std::multimap<float, int>& oOpenMap, std::vector<SNode>& Nodes, int NodeIndex, const CAction& Action, const CState& StartingState)
+void CRegressionPlanner::ExpandNode(CPlannerWorkspace& Workspace, SRegressionScratch& Scratch, int NodeIndex, const CState& StartingState)
+{
+    for (const CAction* Action : Scratch.Actions)
+    {
+        Explore(Workspace, Scratch, NodeIndex, *Action, StartingState);
+    }
+}
+
+void CRegressionPlanner::Explore(CPlannerWorkspace& Workspace, SRegressionScratch& Scratch, int NodeIndex, const CAction& Action, const CState& StartingState)
 {
-    if (!Action.CheckPostcondition(*Nodes[NodeIndex].ConstState))
+    std::vector<SNode>& Nodes = Workspace.GetNodes();
+    if (!CheckPostcondition(Action, *Nodes[NodeIndex].ConstState))
     {
         return;
     }
@@ -74,19 +212,62 @@ void CRegressionPlanner::Explore(std::multimap<float, int>& oOpenMap, std::vecto
     SNode& ChildNode = Nodes.emplace_back();
     SNode& CurrNode = Nodes[NodeIndex];
     ChildNode.Action = &Action;
-    ChildNode.MutableState = CurrNode.ConstState->Clone();
+    CStatsTimer CloneTimer(mStats, &SPlannerStats::CloneTime);
+    ChildNode.MutableState = CurrNode.ConstState->CloneInto(Workspace.GetStateArena());
     ChildNode.MutableState->RemoveMatch(Action.GetEffect());        // Remove satisfied properties in the desired state.
     Action.GetPrecondition().Overwrite(*ChildNode.MutableState);    // Add the preconditions to the desired state as new constraints.
     Action.Affect(*ChildNode.MutableState);
-    ChildNode.ConstState = ChildNode.MutableState.get();
+    CloneTimer.Stop();
+    ChildNode.ConstState = ChildNode.MutableState;
     ChildNode.Parent = NodeIndex;
     ChildNode.Depth = CurrNode.Depth + 1;
     ChildNode.PreviousCost = CurrNode.GetActualCost();
     ChildNode.CurrentCost = Action.GetCost(*CurrNode.ConstState, *ChildNode.ConstState);
-    ChildNode.BaseHeuristicCost = static_cast<float>(ChildNode.ConstState->CountUnsatisfiedProperties(StartingState));
+    IndexNode(Scratch, *ChildNode.ConstState, ChildIndex);
+
+    if (mStats)
+    {
+        mStats->AddGeneration(ChildNode.Depth);
+    }
+
+    CStatsTimer HeuristicTimer(mStats, &SPlannerStats::HeuristicTime);
+    ChildNode.BaseHeuristicCost = GetBaseHeuristicCost(*ChildNode.ConstState, StartingState);
     ChildNode.ExtraHeuristicCost = StartingState.GetExtraHeuristicCost(*ChildNode.ConstState);
+    HeuristicTimer.Stop();
     float TotalCost = ChildNode.GetTotalCost();
-    oOpenMap.emplace(TotalCost, ChildIndex);
+    Workspace.GetOpenList().Push(TotalCost, ChildIndex);
+}
+
+void CRegressionPlanner::IndexNode(SRegressionScratch& Scratch, const CState& DesiredState, int NodeIndex)
+{
+    for (const auto& DesiredFact : DesiredState)
+    {
+        if (DesiredFact.first >= static_cast<int>(Scratch.FactNodes.size()))
+        {
+            Scratch.FactNodes.resize(DesiredFact.first + 1);
+        }
+
+        Scratch.FactNodes[DesiredFact.first].push_back(NodeIndex);
+    }
+}
+
+bool CRegressionPlanner::CheckPostcondition(const CAction& Action, const CState& DesiredState)
+{
+    CStatsTimer PreconditionTimer(mStats, &SPlannerStats::PreconditionTime);
+    const bool Applicable = Action.CheckPostcondition(DesiredState);
+    PreconditionTimer.Stop();
+
+    if (mStats)
+    {
+        mStats->AddCheck(Action, Applicable);
+    }
+
+    return Applicable;
+}
+
+float CRegressionPlanner::GetBaseHeuristicCost(const CState& DesiredState, const CState& StartingState) const
+{
+    return mHeuristic ? mHeuristic->EvaluatePrepared(DesiredState) : static_cast<float>(DesiredState.CountUnsatisfiedProperties(StartingState));
 }
 
 void CRegressionPlanner::BuildPlan(std::vector<const CAction*>& oSteps, const std::vector<SNode>& Nodes, int NodeIndex)
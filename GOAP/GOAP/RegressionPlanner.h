@@ -2,29 +2,76 @@
 
 #pragma once
 
-#include <map>
 #include <vector>
 
+#include "OpenList.h"
+#include "Workspace.h"
+
 
 namespace GOAP
 {
     class CAction;
+    class CRelaxedHeuristic;
+    class CSearchObserver;
     class CState;
+    class CStateArena;
     struct SNode;
+    struct SPlannerStats;
     ///////////////////////////////////////////////////////////////////////////////////////////////
     class CRegressionPlanner // Improved regressive GOAP
     {
     public:
+        virtual ~CRegressionPlanner() {}
+
         // Formulate a plan from the input if possible. Return true if successful.
         bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth);
+        // Same as above but with the buffers of a given workspace, which keeps their capacity for later calls.
+        bool Plan(std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth, CPlannerWorkspace& Workspace);
+        // Repair the search kept in a workspace by the last Plan call after the given facts of the starting state changed, and resume it.
+        // The goal state and actions of that call must still be alive. Return false if the workspace holds no regressive search.
+        bool Replan(std::vector<const CAction*>& oSteps, const CState& StartingState, const std::vector<int>& ChangedFacts, CPlannerWorkspace& Workspace);
+        // Attach an observer to trace the search, or detach it with null.
+        void SetObserver(CSearchObserver* Value) { mObserver = Value; }
+        // Collect the statistics of each search into a given instance, or stop collecting them with null.
+        void SetStats(SPlannerStats* Value) { mStats = Value; }
+        // Estimate the base heuristic costs with a relaxed heuristic built from the same actions, or count unsatisfied properties with null.
+        void SetHeuristic(CRelaxedHeuristic* Value) { mHeuristic = Value; }
 
     protected:
+        struct SRegressionScratch : CPlannerWorkspace::SScratch // Buffers of regressive searches, which are kept after a search for replanning
+        {
+            std::vector<const CAction*> Actions;        // Actions of the search
+            std::vector<bool> ClosedMarks;              // Marks of the nodes popped from the open list
+            std::vector<std::vector<int>> FactNodes;    // Nodes constraining each fact index, so that Replan repairs only those of the changed facts
+            std::vector<int> StaleNodes;                // Nodes to repair in Replan
+            int MaxDepth = -1;                          // Maximum depth of the search, or -1 if no search is kept
+
+            void Clear() override;
+        };
+
+        // Check if an action can lead to a desired state, and record the check in the statistics if any.
+        bool CheckPostcondition(const CAction& Action, const CState& DesiredState);
+        // Return the base heuristic cost of a desired state by the selected heuristic, which has been prepared for the starting state.
+        float GetBaseHeuristicCost(const CState& DesiredState, const CState& StartingState) const;
+        // Prepare the buffers of a subclass in a cleared workspace before a search on given actions starts.
+        virtual void PrepareSearch(const std::vector<const CAction*>& Actions, CPlannerWorkspace& Workspace) {}
+        // Create the child nodes of a node popped from the open list, by trying all actions of the search.
+        virtual void ExpandNode(CPlannerWorkspace& Workspace, SRegressionScratch& Scratch, int NodeIndex, const CState& StartingState);
+        // Run A* on the open list of a workspace until a node satisfied by the starting state is found.
+        bool Search(std::vector<const CAction*>& oSteps, const CState& StartingState, CPlannerWorkspace& Workspace, SRegressionScratch& Scratch);
         // Create a search node for a given action from a given node if feasible.
-        void Explore(std::multimap<float, int>& oOpenMap, std::vector<SNode>& Nodes, int NodeIndex, const CAction& Action, const CState& StartingState);
+        void Explore(CPlannerWorkspace& Workspace, SRegressionScratch& Scratch, int NodeIndex, const CAction& Action, const CState& StartingState);
+        // Record a node under the facts its desired state constrains.
+        void IndexNode(SRegressionScratch& Scratch, const CState& DesiredState, int NodeIndex);
         // List the actions on the path from a given node.
         void BuildPlan(std::vector<const CAction*>& oSteps, const std::vector<SNode>& Nodes, int NodeIndex);
         // Return concatenated names of the actions on the path from a given node.
         std::string StringizePath(const std::vector<SNode>& Nodes, int NodeIndex) const;
+
+    protected:
+        CSearchObserver* mObserver = nullptr; // Optional observer tracing the search
+        SPlannerStats* mStats = nullptr; // Optional statistics of the last search
+        CRelaxedHeuristic* mHeuristic = nullptr; // Optional heuristic replacing the count of unsatisfied properties
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
 }
@@ -0,0 +1,282 @@
+// Copyright 2026 Isaac Hsu
+
+#include <algorithm>
+#include <functional>
+
+#include "Action.h"
+#include "RelaxedHeuristic.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+CRelaxedHeuristic::CRelaxedHeuristic(const std::vector<const CAction*>& Actions, ERelaxedHeuristic Type) : mType(Type)
+{
+    auto InternFact = [this](const CState::SFact& Fact)
+    {
+        auto [itFact, Inserted] = mFactIds.try_emplace(Fact, static_cast<int>(mFacts.size()));
+        if (Inserted)
+        {
+            mFacts.push_back(Fact);
+        }
+        return itFact->second;
+    };
+
+    mActionCosts.reserve(Actions.size());
+    mFirstPreconditions.reserve(Actions.size() + 1);
+    mFirstEffects.reserve(Actions.size() + 1);
+
+    for (const CAction* Action : Actions)
+    {
+        mActionCosts.push_back(Action->GetBaseCost());
+
+        mFirstPreconditions.push_back(static_cast<int>(mPreconditions.size()));
+        for (const CState::SFact& Fact : Action->GetPrecondition())
+        {
+            mPreconditions.push_back(InternFact(Fact));
+        }
+
+        mFirstEffects.push_back(static_cast<int>(mEffects.size()));
+        for (const CState::SFact& Fact : Action->GetEffect())
+        {
+            mEffects.push_back(InternFact(Fact));
+        }
+    }
+
+    mFirstPreconditions.push_back(static_cast<int>(mPreconditions.size()));
+    mFirstEffects.push_back(static_cast<int>(mEffects.size()));
+
+    // Invert the preconditions into the consumers of each fact by counting sort.
+    const int FactCount = static_cast<int>(mFacts.size());
+    mFirstConsumers.assign(FactCount + 1, 0);
+    for (int FactId : mPreconditions)
+    {
+        ++mFirstConsumers[FactId + 1];
+    }
+
+    for (int FactId = 0; FactId < FactCount; ++FactId)
+    {
+        mFirstConsumers[FactId + 1] += mFirstConsumers[FactId];
+    }
+
+    mConsumers.resize(mPreconditions.size());
+    std::vector<int> NextSlots(mFirstConsumers.begin(), mFirstConsumers.end() - 1);
+    for (int ActionIndex = 0; ActionIndex < static_cast<int>(Actions.size()); ++ActionIndex)
+    {
+        for (int i = mFirstPreconditions[ActionIndex]; i < mFirstPreconditions[ActionIndex + 1]; ++i)
+        {
+            mConsumers[NextSlots[mPreconditions[i]]++] = ActionIndex;
+        }
+    }
+
+    mFactMarks.assign(FactCount, false);
+    mActionMarks.assign(Actions.size(), false);
+}
+
+float CRelaxedHeuristic::Evaluate(const CState& State, const CState& DesiredState)
+{
+    Propagate(State, &DesiredState);
+    return Combine(State, DesiredState);
+}
+
+void CRelaxedHeuristic::Prepare(const CState& StartingState)
+{
+    mPreparedState = StartingState;
+    Propagate(mPreparedState, nullptr);
+}
+
+float CRelaxedHeuristic::EvaluatePrepared(const CState& DesiredState)
+{
+    return Combine(mPreparedState, DesiredState);
+}
+
+void CRelaxedHeuristic::Propagate(const CState& State, const CState* DesiredState)
+{
+    const int FactCount = static_cast<int>(mFacts.size());
+    const int ActionCount = static_cast<int>(mActionCosts.size());
+    const auto IsBefore = std::greater<std::pair<float, int>>(); // Makes the heap a min-heap.
+
+    mFactCosts.assign(FactCount, Unreachable);
+    mSupporters.assign(FactCount, -1);
+    mQueue.clear();
+
+    for (int FactId = 0; FactId < FactCount; ++FactId)
+    {
+        if (State.GetProperty(mFacts[FactId].first) == mFacts[FactId].second)
+        {
+            mFactCosts[FactId] = 0.f;
+            mQueue.emplace_back(0.f, FactId);
+        }
+    }
+
+    mActionReadyCosts.assign(ActionCount, 0.f);
+    mUnmetCounts.resize(ActionCount);
+    for (int ActionIndex = 0; ActionIndex < ActionCount; ++ActionIndex)
+    {
+        mUnmetCounts[ActionIndex] = mFirstPreconditions[ActionIndex + 1] - mFirstPreconditions[ActionIndex];
+        if (mUnmetCounts[ActionIndex] > 0)
+        {
+            continue;
+        }
+
+        for (int i = mFirstEffects[ActionIndex]; i < mFirstEffects[ActionIndex + 1]; ++i) // Actions without preconditions are applicable at once.
+        {
+            const int EffectId = mEffects[i];
+            if (mActionCosts[ActionIndex] < mFactCosts[EffectId])
+            {
+                mFactCosts[EffectId] = mActionCosts[ActionIndex];
+                mSupporters[EffectId] = ActionIndex;
+                mQueue.emplace_back(mActionCosts[ActionIndex], EffectId);
+            }
+        }
+    }
+
+    std::make_heap(mQueue.begin(), mQueue.end(), IsBefore);
+
+    // Count the desired facts that actions can add, which are settled when they leave the queue.
+    int PendingCount = 0;
+    if (DesiredState)
+    {
+        for (const CState::SFact& Fact : *DesiredState)
+        {
+            const int FactId = FindFact(Fact);
+            if (FactId >= 0)
+            {
+                mFactMarks[FactId] = true;
+                ++PendingCount;
+            }
+        }
+    }
+
+    while (!mQueue.empty() && (!DesiredState || PendingCount > 0))
+    {
+        std::pop_heap(mQueue.begin(), mQueue.end(), IsBefore);
+        const auto [Cost, FactId] = mQueue.back();
+        mQueue.pop_back();
+
+        if (Cost > mFactCosts[FactId])
+        {
+            continue; // Skip the stale entry of a fact reached cheaper.
+        }
+
+        if (mFactMarks[FactId])
+        {
+            mFactMarks[FactId] = false;
+            --PendingCount;
+        }
+
+        for (int i = mFirstConsumers[FactId]; i < mFirstConsumers[FactId + 1]; ++i)
+        {
+            const int ActionIndex = mConsumers[i];
+            float& ReadyCost = mActionReadyCosts[ActionIndex];
+            ReadyCost = mType == ERelaxedHeuristic::Max ? std::max(ReadyCost, Cost) : ReadyCost + Cost;
+            if (--mUnmetCounts[ActionIndex] > 0)
+            {
+                continue;
+            }
+
+            const float EffectCost = ReadyCost + mActionCosts[ActionIndex];
+            for (int j = mFirstEffects[ActionIndex]; j < mFirstEffects[ActionIndex + 1]; ++j)
+            {
+                const int EffectId = mEffects[j];
+                if (EffectCost < mFactCosts[EffectId])
+                {
+                    mFactCosts[EffectId] = EffectCost;
+                    mSupporters[EffectId] = ActionIndex;
+                    mQueue.emplace_back(EffectCost, EffectId);
+                    std::push_heap(mQueue.begin(), mQueue.end(), IsBefore);
+                }
+            }
+        }
+    }
+
+    if (DesiredState && PendingCount > 0)
+    {
+        for (const CState::SFact& Fact : *DesiredState) // Reset the marks of unreachable facts.
+        {
+            const int FactId = FindFact(Fact);
+            if (FactId >= 0)
+            {
+                mFactMarks[FactId] = false;
+            }
+        }
+    }
+}
+
+float CRelaxedHeuristic::Combine(const CState& State, const CState& DesiredState)
+{
+    float Return = 0.f;
+    mPendingFacts.clear();
+
+    for (const CState::SFact& Fact : DesiredState)
+    {
+        const int FactId = FindFact(Fact);
+        const float Cost = FactId >= 0 ? mFactCosts[FactId] : (State.GetProperty(Fact.first) == Fact.second ? 0.f : Unreachable);
+        if (Cost == Unreachable)
+        {
+            return Unreachable;
+        }
+
+        switch (mType)
+        {
+        case ERelaxedHeuristic::Max:
+            Return = std::max(Return, Cost);
+            break;
+        case ERelaxedHeuristic::Add:
+            Return += Cost;
+            break;
+        case ERelaxedHeuristic::FF:
+            if (FactId >= 0 && mSupporters[FactId] >= 0)
+            {
+                mPendingFacts.push_back(FactId); // Facts holding in the state need no actions.
+            }
+            break;
+        }
+    }
+
+    // Extract a relaxed plan by following the supporters back from the desired facts, and count each action once.
+    while (!mPendingFacts.empty())
+    {
+        const int FactId = mPendingFacts.back();
+        mPendingFacts.pop_back();
+
+        const int ActionIndex = mSupporters[FactId];
+        if (mFactMarks[FactId] || ActionIndex < 0)
+        {
+            continue;
+        }
+
+        mFactMarks[FactId] = true;
+        if (mActionMarks[ActionIndex])
+        {
+            continue;
+        }
+
+        mActionMarks[ActionIndex] = true;
+        mMarkedActions.push_back(ActionIndex);
+        Return += mActionCosts[ActionIndex];
+
+        for (int i = mFirstPreconditions[ActionIndex]; i < mFirstPreconditions[ActionIndex + 1]; ++i)
+        {
+            mPendingFacts.push_back(mPreconditions[i]);
+        }
+    }
+
+    for (int ActionIndex : mMarkedActions)
+    {
+        mActionMarks[ActionIndex] = false;
+        for (int i = mFirstEffects[ActionIndex]; i < mFirstEffects[ActionIndex + 1]; ++i)
+        {
+            mFactMarks[mEffects[i]] = false;
+        }
+    }
+    mMarkedActions.clear();
+
+    return Return;
+}
+
+int CRelaxedHeuristic::FindFact(const CState::SFact& Fact) const
+{
+    auto itFact = mFactIds.find(Fact);
+    return itFact != mFactIds.end() ? itFact->second : -1;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,79 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Hash.h"
+#include "State.h"
+
+
+namespace GOAP
+{
+    class CAction;
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    enum class ERelaxedHeuristic : unsigned char // Heuristics on the relaxed problem where actions add facts but never remove them
+    {
+        Max,    // Cost of the costliest desired fact (h_max), which is admissible
+        Add,    // Sum of the costs of the desired facts (h_add), which counts shared subplans repeatedly
+        FF,     // Cost of a relaxed plan extracted along the cheapest supporters of h_add (h_FF)
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Relaxed planning graph built once from an action set to estimate costs for planners.
+    // Costs are the base costs of actions, and custom costs and conditions are ignored.
+    // The evaluation reuses internal buffers, so each thread needs its own instance.
+    class CRelaxedHeuristic
+    {
+    public:
+        CRelaxedHeuristic(const std::vector<const CAction*>& Actions, ERelaxedHeuristic Type);
+
+        ERelaxedHeuristic GetType() const { return mType; }
+
+        // Estimated cost from a state to satisfy a desired state, for forward searches. Return infinity if it's unreachable even when relaxed.
+        // Each call propagates from scratch rather than from the costs of the parent node. Effects overwrite values, so a child state
+        // drops the facts its parent held, and the costs derived from them may rise, which only a full propagation finds. To bound
+        // each call, the propagation stops once the desired facts are settled, which also leaves the costs of the other facts partial.
+        float Evaluate(const CState& State, const CState& DesiredState);
+        // Compute the costs of all facts from a state once, for regressive searches whose starting state stays the same.
+        void Prepare(const CState& StartingState);
+        // Estimated cost from the prepared state to satisfy a desired state, combining the prepared costs only.
+        float EvaluatePrepared(const CState& DesiredState);
+
+    private:
+        static constexpr float Unreachable = std::numeric_limits<float>::infinity();
+
+        // Propagate the costs of facts from a state through the actions in the order of costs.
+        // Stop once the facts of the desired state are settled, or propagate to all facts without one.
+        void Propagate(const CState& State, const CState* DesiredState);
+        // Combine the propagated costs of the facts of a desired state by the heuristic type.
+        float Combine(const CState& State, const CState& DesiredState);
+        // Return the ID of a fact, or -1 if no actions use it.
+        int FindFact(const CState::SFact& Fact) const;
+
+        ERelaxedHeuristic mType;
+        std::unordered_map<CState::SFact, int> mFactIds;    // Dense IDs of the facts in preconditions and effects
+        std::vector<CState::SFact> mFacts;                  // Facts by their IDs
+        std::vector<float> mActionCosts;                    // Base costs of the actions
+        std::vector<int> mFirstPreconditions;               // Offsets of the preconditions of each action in mPreconditions
+        std::vector<int> mPreconditions;                    // Fact IDs of the preconditions of all actions
+        std::vector<int> mFirstEffects;                     // Offsets of the effects of each action in mEffects
+        std::vector<int> mEffects;                          // Fact IDs of the effects of all actions
+        std::vector<int> mFirstConsumers;                   // Offsets of the actions requiring each fact in mConsumers
+        std::vector<int> mConsumers;                        // Action indexes by the facts they require
+
+        CState mPreparedState;                              // The state whose costs have been prepared
+        std::vector<float> mFactCosts;                      // Relaxed costs of the facts from the propagated state
+        std::vector<int> mSupporters;                       // Cheapest action adding each fact, or -1 if it holds in the state
+        std::vector<int> mUnmetCounts;                      // Number of unsettled preconditions of each action
+        std::vector<float> mActionReadyCosts;               // Combined costs of the settled preconditions of each action
+        std::vector<std::pair<float, int>> mQueue;          // Min-heap of facts by their costs
+        std::vector<int> mPendingFacts;                     // Facts to support during the relaxed plan extraction
+        std::vector<bool> mFactMarks;                       // Facts supported in the relaxed plan
+        std::vector<bool> mActionMarks;                     // Actions in the relaxed plan
+        std::vector<int> mMarkedActions;                    // Actions in the relaxed plan, to reset the marks
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
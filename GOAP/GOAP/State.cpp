@@ -1,18 +1,121 @@
 // Copyright 2024 Isaac Hsu
 
-#include <map>
+#include <algorithm>
+#include <typeinfo>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GOAP_SSE2
+#endif
+
+#include "Fact.h"
+#include "Hash.h"
 #include "State.h"
+#include "StateArena.h"
 
 
 using namespace GOAP;
 ///////////////////////////////////////////////////////////////////////////////////////////////////
+// Kernels processing a word of properties, i.e. MaskWordBits values at once. AVX2 is only used if the library is compiled for it,
+// e.g. with msbuild /p:EnableAVX2=true, and SSE2 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Return a bitmask of the lanes in which the two value arrays are equal.
+static BMaskWord CompareLanes(const BProperty* Left, const BProperty* Right)
+{
+    BMaskWord Equal = 0;
+
+#if defined(__AVX2__)
+    for (int Lane = 0; Lane < MaskWordBits; Lane += 8)
+    {
+        __m256i L = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Left + Lane));
+        __m256i R = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Right + Lane));
+        int Bits = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(L, R)));
+        Equal |= BMaskWord(Bits) << Lane;
+    }
+#elif defined(GOAP_SSE2)
+    for (int Lane = 0; Lane < MaskWordBits; Lane += 4)
+    {
+        __m128i L = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Left + Lane));
+        __m128i R = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Right + Lane));
+        int Bits = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(L, R)));
+        Equal |= BMaskWord(Bits) << Lane;
+    }
+#else
+    for (int Lane = 0; Lane < MaskWordBits; ++Lane)
+    {
+        Equal |= BMaskWord(Left[Lane] == Right[Lane]) << Lane;
+    }
+#endif
+
+    return Equal;
+}
+
+// Copy the source values into the target in the lanes selected by a bitmask.
+static void BlendLanes(BProperty* Target, const BProperty* Source, BMaskWord Selected)
+{
+#if defined(__AVX2__)
+    const __m256i LaneBits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    for (int Lane = 0; Lane < MaskWordBits; Lane += 8, Selected >>= 8)
+    {
+        if (Selected & 0xFF)
+        {
+            __m256i Mask = _mm256_and_si256(_mm256_set1_epi32(static_cast<int>(Selected & 0xFF)), LaneBits);
+            Mask = _mm256_cmpeq_epi32(Mask, LaneBits);
+            __m256i* T = reinterpret_cast<__m256i*>(Target + Lane);
+            __m256i S = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Source + Lane));
+            _mm256_storeu_si256(T, _mm256_blendv_epi8(_mm256_loadu_si256(T), S, Mask));
+        }
+    }
+#elif defined(GOAP_SSE2)
+    const __m128i LaneBits = _mm_setr_epi32(1, 2, 4, 8);
+    for (int Lane = 0; Lane < MaskWordBits; Lane += 4, Selected >>= 4)
+    {
+        if (Selected & 0xF)
+        {
+            __m128i Mask = _mm_and_si128(_mm_set1_epi32(static_cast<int>(Selected & 0xF)), LaneBits);
+            Mask = _mm_cmpeq_epi32(Mask, LaneBits);
+            __m128i* T = reinterpret_cast<__m128i*>(Target + Lane);
+            __m128i S = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source + Lane));
+            _mm_storeu_si128(T, _mm_or_si128(_mm_and_si128(Mask, S), _mm_andnot_si128(Mask, _mm_loadu_si128(T))));
+        }
+    }
+#else
+    for (; Selected; Selected &= Selected - 1)
+    {
+        int Lane = FindLowestBit(Selected);
+        Target[Lane] = Source[Lane];
+    }
+#endif
+}
+
+// Reset the values to 0 in the lanes selected by a bitmask.
+static void ClearLanes(BProperty* Target, BMaskWord Selected)
+{
+    for (; Selected; Selected &= Selected - 1)
+    {
+        Target[FindLowestBit(Selected)] = 0;
+    }
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+CState* CState::CloneInto(CStateArena& Arena) const
+{
+    if (typeid(*this) == typeid(CState))
+    {
+        return Arena.Create<CState>(*this, &Arena);
+    }
+
+    return Arena.Adopt(Clone()); // Subclasses without their own overrides are still cloned with their dynamic types.
+}
+
 std::string CState::ToString() const
 {
+    const CFactRegistry& Registry = CFactRegistry::GetInstance();
     std::string Return;
     bool Successive = false;
 
-    for (const auto& [Name, Value] : mPropertyMap)
+    for (const auto& [Index, Value] : *this)
     {
         if (Successive)
         {
@@ -23,7 +126,7 @@ std::string CState::ToString() const
             Successive = true;
         }
 
-        Return += Name;
+        Return += Registry.GetName(Index);
         Return += "=";
         Return += std::to_string(Value);
     }
@@ -33,10 +136,11 @@ std::string CState::ToString() const
 
 std::string CState::Stringize(const CState& Another) const
 {
+    const CFactRegistry& Registry = CFactRegistry::GetInstance();
     std::string Return;
     bool Successive = false;
 
-    for (const auto& [Name, Value] : mPropertyMap)
+    for (const auto& [Index, Value] : *this)
     {
         if (Successive)
         {
@@ -47,10 +151,10 @@ std::string CState::Stringize(const CState& Another) const
             Successive = true;
         }
 
-        Return += Name;
+        Return += Registry.GetName(Index);
         Return += "=";
 
-        std::optional<BProperty> Other = Another.GetProperty(Name);
+        std::optional<BProperty> Other = Another.GetProperty(Index);
         if (Other)
         {
             Return += "(";
@@ -68,28 +172,102 @@ std::string CState::Stringize(const CState& Another) const
     return Return;
 }
 
+size_t CState::GetHash() const
+{
+    size_t Return = 0;
+
+    for (const SFact& Fact : *this)
+    {
+        size_t FactHash = std::hash<SFact>{}(Fact);
+        Return ^= FactHash + 0x9e3779b9 + (Return << 6) + (Return >> 2);
+    }
+
+    return Return;
+}
+
+bool CState::IsIdentical(const CState& Another) const
+{
+    const int WordCount = std::max(GetWordCount(), Another.GetWordCount());
+    for (int WordIndex = 0; WordIndex < WordCount; ++WordIndex)
+    {
+        if (GetWord(WordIndex) != Another.GetWord(WordIndex))
+        {
+            return false;
+        }
+    }
+
+    // The masks are equal, and unset values are 0, so the values can be compared as flat arrays within the shorter capacity.
+    const int Capacity = std::min(GetCapacity(), Another.GetCapacity());
+    return std::equal(mValues.begin(), mValues.begin() + Capacity, Another.mValues.begin());
+}
+
+int CState::GetPropertyCount() const
+{
+    int Count = 0;
+
+    for (BMaskWord Word : mMask)
+    {
+        Count += CountBits(Word);
+    }
+
+    return Count;
+}
+
 std::optional<BProperty> CState::GetProperty(const std::string& Name) const
 {
-    auto it = mPropertyMap.find(Name);
-    if (it == mPropertyMap.end())
+    return GetProperty(CFactRegistry::GetInstance().Find(Name));
+}
+
+std::optional<BProperty> CState::GetProperty(int Index) const
+{
+    if (Index < 0 || !HasProperty(Index))
     {
         return {};
     }
 
-    return it->second;
+    return mValues[Index];
 }
 
 void CState::SetProperty(const std::string& Name, BProperty Value)
 {
-    mPropertyMap.emplace(Name, Value);
+    SetProperty(CFactRegistry::GetInstance().Intern(Name), Value);
+}
+
+void CState::SetProperty(int Index, BProperty Value)
+{
+    if (HasProperty(Index))
+    {
+        return; // Keep the existing value like unordered_map::emplace did.
+    }
+
+    Reserve(Index + 1);
+    mValues[Index] = Value;
+    mMask[Index / MaskWordBits] |= BMaskWord(1) << (Index % MaskWordBits);
+}
+
+bool CState::IsEmpty() const
+{
+    return std::all_of(mMask.begin(), mMask.end(), [](BMaskWord Word) { return Word == 0; });
 }
 
 bool CState::IsSatisfiedBy(const CState& Another) const
 {
-    for (auto& [Name, Target] : mPropertyMap)
+    for (int WordIndex = 0; WordIndex < GetWordCount(); ++WordIndex)
     {
-        std::optional<BProperty> Other = Another.GetProperty(Name);
-        if (Other != Target)
+        const BMaskWord Targets = mMask[WordIndex];
+        if (!Targets)
+        {
+            continue;
+        }
+
+        const BMaskWord OtherWord = Another.GetWord(WordIndex);
+        if (Targets & ~OtherWord)
+        {
+            return false; // Some properties are unset in the other state.
+        }
+
+        const int Offset = WordIndex * MaskWordBits;
+        if (Targets & ~CompareLanes(&mValues[Offset], &Another.mValues[Offset]))
         {
             return false;
         }
@@ -102,13 +280,19 @@ int CState::CountUnsatisfiedProperties(const CState& Another) const
 {
     int Count = 0;
 
-    for (auto& [Name, Target] : mPropertyMap)
+    for (int WordIndex = 0; WordIndex < GetWordCount(); ++WordIndex)
     {
-        std::optional<BProperty> Other = Another.GetProperty(Name);
-        if (Other != Target)
+        const BMaskWord Targets = mMask[WordIndex];
+        const BMaskWord OtherWord = Another.GetWord(WordIndex);
+        if (!(Targets & OtherWord))
         {
-            Count++;
+            Count += CountBits(Targets); // Properties unset in the other state are unsatisfied.
+            continue;
         }
+
+        const int Offset = WordIndex * MaskWordBits;
+        const BMaskWord Satisfied = OtherWord & CompareLanes(&mValues[Offset], &Another.mValues[Offset]);
+        Count += CountBits(Targets & ~Satisfied);
     }
 
     return Count;
@@ -116,47 +300,89 @@ int CState::CountUnsatisfiedProperties(const CState& Another) const
 
 void CState::Overwrite(CState& Another) const
 {
-    for (const auto& [Name, Value] : mPropertyMap)
+    Another.Reserve(GetCapacity());
+
+    for (int WordIndex = 0; WordIndex < GetWordCount(); ++WordIndex)
     {
-        Another.mPropertyMap[Name] = Value;
+        const int Offset = WordIndex * MaskWordBits;
+        BlendLanes(&Another.mValues[Offset], &mValues[Offset], mMask[WordIndex]);
+        Another.mMask[WordIndex] |= mMask[WordIndex];
     }
 }
 
 void CState::CopyProperties(const CState& Source, const CState& Filter)
 {
-    for (auto& [Name, Target] : Filter)
+    const int WordCount = std::min(Source.GetWordCount(), Filter.GetWordCount());
+    Reserve(WordCount * MaskWordBits);
+
+    for (int WordIndex = 0; WordIndex < WordCount; ++WordIndex)
     {
-        if (std::optional<BProperty> Value = Source.GetProperty(Name))
-        {
-            mPropertyMap[Name] = *Value;
-        }
+        const int Offset = WordIndex * MaskWordBits;
+        const BMaskWord Copied = Source.mMask[WordIndex] & Filter.mMask[WordIndex];
+        BlendLanes(&mValues[Offset], &Source.mValues[Offset], Copied);
+        mMask[WordIndex] |= Copied;
     }
 }
 
 void CState::InitializeProperties(const CState& Source, const CState& Filter)
 {
-    for (auto [Name, Target] : Filter)
+    const int WordCount = std::min(Source.GetWordCount(), Filter.GetWordCount());
+    Reserve(WordCount * MaskWordBits);
+
+    for (int WordIndex = 0; WordIndex < WordCount; ++WordIndex)
+    {
+        const int Offset = WordIndex * MaskWordBits;
+        const BMaskWord Copied = Source.mMask[WordIndex] & Filter.mMask[WordIndex] & ~mMask[WordIndex]; // Skip the properties already set.
+        BlendLanes(&mValues[Offset], &Source.mValues[Offset], Copied);
+        mMask[WordIndex] |= Copied;
+    }
+}
+
+void CState::RemoveMatch(const CState& Another)
+{
+    const int WordCount = std::min(GetWordCount(), Another.GetWordCount());
+
+    for (int WordIndex = 0; WordIndex < WordCount; ++WordIndex)
     {
-        if (std::optional<BProperty> Value = Source.GetProperty(Name))
+        const BMaskWord Shared = mMask[WordIndex] & Another.mMask[WordIndex];
+        if (!Shared)
         {
-            mPropertyMap.emplace(Name, *Value); // unordered_map::emplace doesn't replace existing elements.
+            continue;
         }
+
+        const int Offset = WordIndex * MaskWordBits;
+        const BMaskWord Removed = Shared & CompareLanes(&mValues[Offset], &Another.mValues[Offset]);
+        ClearLanes(&mValues[Offset], Removed);
+        mMask[WordIndex] &= ~Removed;
     }
 }
 
-void CState::RemoveMatch(const CState& Another)
+void CState::Reserve(int Capacity)
 {
-    for (auto it = mPropertyMap.begin(); it != mPropertyMap.end();)
+    const int WordCount = (Capacity + MaskWordBits - 1) / MaskWordBits;
+    if (WordCount > GetWordCount())
     {
-        std::optional<BProperty> Other = Another.GetProperty(it->first);
-        if (Other == it->second)
+        mMask.resize(WordCount, 0);
+        mValues.resize(WordCount * MaskWordBits, 0);
+    }
+}
+
+int CState::FindNextProperty(int Index) const
+{
+    for (int WordIndex = Index / MaskWordBits; WordIndex < GetWordCount(); ++WordIndex)
+    {
+        BMaskWord Word = mMask[WordIndex];
+        if (WordIndex == Index / MaskWordBits)
         {
-            it = mPropertyMap.erase(it);
+            Word &= ~BMaskWord(0) << (Index % MaskWordBits); // Skip the bits before the index.
         }
-        else
+
+        if (Word)
         {
-            ++it;
+            return WordIndex * MaskWordBits + FindLowestBit(Word);
         }
     }
+
+    return GetCapacity();
 }
-///////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
+///////////////////////////////////////////////////////////////////////////////////////////////////
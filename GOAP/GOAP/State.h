@@ -2,10 +2,16 @@
 
 #pragma once
 
+#include <iterator>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
-#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "BitUtility.h"
+#include "StateArena.h"
 
 
 namespace GOAP
@@ -15,24 +21,62 @@ namespace GOAP
     ///////////////////////////////////////////////////////////////////////////////////////////////    
     class CState // World state storing Boolean and enumeration properties    
     {
+    public:
+        using SFact = std::pair<int, BProperty>; // A fact index registered in CFactRegistry and its value
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        class CIterator // Iterator over the set properties in the order of fact indexes
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = SFact;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = SFact;
+
+            CIterator(const CState& State, int Index) : mState(&State), mIndex(Index) {}
+
+            SFact operator * () const { return { mIndex, mState->mValues[mIndex] }; }
+            CIterator& operator ++ () { mIndex = mState->FindNextProperty(mIndex + 1); return *this; }
+            CIterator operator ++ (int) { CIterator Copy = *this; ++*this; return Copy; }
+            bool operator == (const CIterator& Another) const { return mIndex == Another.mIndex; }
+            bool operator != (const CIterator& Another) const { return mIndex != Another.mIndex; }
+
+        private:
+            const CState* mState;
+            int mIndex;
+        };
+        ///////////////////////////////////////////////////////////////////////////////////////////
     public:     
+        CState() = default;
+        CState(const CState& Another) = default;
+        // Copy another state with its storage allocated from a given memory resource, such as a state arena.
+        CState(const CState& Another, std::pmr::memory_resource* Resource) : mValues(Another.mValues, Resource), mMask(Another.mMask, Resource) {}
+        CState& operator = (const CState& Another) = default;
         virtual ~CState() {}
         virtual std::unique_ptr<CState> Clone() const { return std::make_unique<CState>(*this); }
+        // Clone this state into an arena. Subclasses override it with Arena.Create<CSubclass>(*this, &Arena) and a constructor passing the arena
+        // on to the copy constructor of CState with a memory resource, or their Clone results are adopted.
+        virtual CState* CloneInto(CStateArena& Arena) const;
         virtual std::string ToString() const; // For debugging
         virtual std::string Stringize(const CState& Another) const; // For debugging
         virtual float GetExtraHeuristicCost(const CState& Another) const { return 0.f; } // Custom heuristic cost
+        // Hash value used for duplicate detection. Override it along with IsIdentical if custom members distinguish states.
+        virtual size_t GetHash() const;
+        // Do this state and another represent the same search state?
+        virtual bool IsIdentical(const CState& Another) const;
 
-        auto begin()        { return mPropertyMap.begin(); }
-        auto begin() const  { return mPropertyMap.begin(); }
-        auto end()          { return mPropertyMap.end(); }
-        auto end() const    { return mPropertyMap.end(); }
+        CIterator begin() const { return CIterator(*this, FindNextProperty(0)); }
+        CIterator end() const   { return CIterator(*this, GetCapacity()); }
 
-        int GetPropertyCount() const { return static_cast<int>(mPropertyMap.size()); }
+        int GetPropertyCount() const;
         std::optional<BProperty> GetProperty(const std::string& Name) const;
+        std::optional<BProperty> GetProperty(int Index) const;
         void SetProperty(const std::string& Name, BProperty Value);
+        void SetProperty(int Index, BProperty Value);
+        bool HasProperty(int Index) const { return Index < GetCapacity() && ((mMask[Index / MaskWordBits] >> (Index % MaskWordBits)) & 1); }
 
         // Are there no properties set in this state?
-        bool IsEmpty() const { return mPropertyMap.empty(); }
+        bool IsEmpty() const;
         // Do all properties in this state match another?
         bool IsSatisfiedBy(const CState& Another) const;
         // How many properties in this state differ from those in another?
@@ -47,7 +91,29 @@ namespace GOAP
         void RemoveMatch(const CState& Another);
 
     private:
-        std::unordered_map<std::string, BProperty> mPropertyMap;
+        // How many facts can be stored without reallocation?
+        int GetCapacity() const { return static_cast<int>(mValues.size()); }
+        int GetWordCount() const { return static_cast<int>(mMask.size()); }
+        BMaskWord GetWord(int WordIndex) const { return WordIndex < GetWordCount() ? mMask[WordIndex] : 0; }
+        // Grow the storage to hold a given number of facts.
+        void Reserve(int Capacity);
+        // Return the index of the first set property starting from a given index, or the capacity if none.
+        int FindNextProperty(int Index) const;
+
+        // Both arrays are indexed by fact indexes, and unset values are kept 0 so that states can be compared as flat arrays.
+        // Copies take the default memory resource, while assignments keep the resource of the assigned state.
+        std::pmr::vector<BProperty> mValues; // Property values, sized in multiples of MaskWordBits
+        std::pmr::vector<BMaskWord> mMask;   // Bitmask of set properties
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct SStateHash // Hash functor for state pointers
+    {
+        size_t operator () (const CState* State) const { return State->GetHash(); }
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    struct SStateEqual // Equality functor for state pointers
+    {
+        bool operator () (const CState* Left, const CState* Right) const { return Left->IsIdentical(*Right); }
     };
     ///////////////////////////////////////////////////////////////////////////////////////////////
 }
\ No newline at end of file
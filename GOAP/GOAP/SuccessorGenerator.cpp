@@ -0,0 +1,154 @@
+// Copyright 2026 Isaac Hsu
+
+#include <algorithm>
+#include <typeinfo>
+
+#include "Action.h"
+#include "SuccessorGenerator.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void CSuccessorGenerator::Build(const std::vector<const CAction*>& Actions)
+{
+    mNodes.clear();
+    mBranches.clear();
+    mActionIndexes.clear();
+    mCheckMarks.clear();
+    mPreconditions.clear();
+    mEntries.clear();
+    mActions.assign(Actions.begin(), Actions.end());
+
+    for (int ActionIndex = 0; ActionIndex < static_cast<int>(Actions.size()); ++ActionIndex)
+    {
+        const CAction& Action = *Actions[ActionIndex];
+        const bool Plain = typeid(Action) == typeid(CAction); // Only the preconditions of plain actions are known to be all that is checked.
+        mCheckMarks.push_back(!Plain);
+        if (Plain && Action.GetEffect().IsEmpty())
+        {
+            continue; // CAction::CheckPrecondition rejects ineffective actions in any state.
+        }
+
+        SEntry& Entry = mEntries.emplace_back();
+        Entry.ActionIndex = ActionIndex;
+        Entry.Cursor = static_cast<int>(mPreconditions.size());
+
+        if (Plain)
+        {
+            mPreconditions.insert(mPreconditions.end(), Action.GetPrecondition().begin(), Action.GetPrecondition().end());
+        }
+
+        Entry.End = static_cast<int>(mPreconditions.size());
+    }
+
+    BuildNode(0, static_cast<int>(mEntries.size()));
+}
+
+void CSuccessorGenerator::GetApplicableActions(std::vector<int>& oActionIndexes, const CState& State) const
+{
+    oActionIndexes.clear();
+    if (!mNodes.empty())
+    {
+        CollectActions(oActionIndexes, State, 0);
+    }
+
+    std::sort(oActionIndexes.begin(), oActionIndexes.end()); // Keep the order of the action list for the search.
+}
+
+int CSuccessorGenerator::BuildNode(int First, int Last)
+{
+    const int NodeIndex = static_cast<int>(mNodes.size());
+    mNodes.emplace_back();
+
+    // Order the entries as the actions satisfied here, then the actions requiring the next fact by its values, and then the rest.
+    auto itFirst = mEntries.begin() + First;
+    auto itLast = mEntries.begin() + Last;
+    auto itRemaining = std::stable_partition(itFirst, itLast, [](const SEntry& Entry) { return Entry.Cursor == Entry.End; });
+
+    mNodes[NodeIndex].FirstAction = static_cast<int>(mActionIndexes.size());
+    mNodes[NodeIndex].ActionCount = static_cast<int>(itRemaining - itFirst);
+    for (auto it = itFirst; it != itRemaining; it++)
+    {
+        mActionIndexes.push_back(it->ActionIndex);
+    }
+
+    if (itRemaining == itLast)
+    {
+        return NodeIndex;
+    }
+
+    auto GetNextFact = [this](const SEntry& Entry) { return mPreconditions[Entry.Cursor].first; };
+    const int Fact = GetNextFact(*std::min_element(itRemaining, itLast, [&](const SEntry& Left, const SEntry& Right) { return GetNextFact(Left) < GetNextFact(Right); }));
+    auto itDontCare = std::stable_partition(itRemaining, itLast, [&](const SEntry& Entry) { return GetNextFact(Entry) == Fact; });
+    std::stable_sort(itRemaining, itDontCare, [this](const SEntry& Left, const SEntry& Right) { return mPreconditions[Left.Cursor].second < mPreconditions[Right.Cursor].second; });
+
+    // Reserve the branches first to keep them contiguous while the children append theirs.
+    int BranchCount = 0;
+    for (auto it = itRemaining; it != itDontCare; it++)
+    {
+        if (it == itRemaining || mPreconditions[it->Cursor].second != mPreconditions[(it - 1)->Cursor].second)
+        {
+            ++BranchCount;
+        }
+    }
+
+    const int FirstBranch = static_cast<int>(mBranches.size());
+    mBranches.resize(FirstBranch + BranchCount);
+    mNodes[NodeIndex].Fact = Fact;
+    mNodes[NodeIndex].FirstBranch = FirstBranch;
+    mNodes[NodeIndex].BranchCount = BranchCount;
+
+    const int RemainingFirst = static_cast<int>(itRemaining - mEntries.begin());
+    const int DontCareFirst = static_cast<int>(itDontCare - mEntries.begin());
+    int BranchIndex = FirstBranch;
+
+    for (int GroupFirst = RemainingFirst; GroupFirst < DontCareFirst; ++BranchIndex)
+    {
+        const BProperty Value = mPreconditions[mEntries[GroupFirst].Cursor].second;
+        int GroupLast = GroupFirst;
+        while (GroupLast < DontCareFirst && mPreconditions[mEntries[GroupLast].Cursor].second == Value)
+        {
+            ++mEntries[GroupLast++].Cursor; // The fact is tested by this node.
+        }
+
+        const int Child = BuildNode(GroupFirst, GroupLast);
+        mBranches[BranchIndex] = { Value, Child };
+        GroupFirst = GroupLast;
+    }
+
+    if (DontCareFirst < Last)
+    {
+        const int Child = BuildNode(DontCareFirst, Last);
+        mNodes[NodeIndex].DontCareChild = Child;
+    }
+
+    return NodeIndex;
+}
+
+void CSuccessorGenerator::CollectActions(std::vector<int>& oActionIndexes, const CState& State, int NodeIndex) const
+{
+    const STreeNode& Node = mNodes[NodeIndex];
+    oActionIndexes.insert(oActionIndexes.end(), mActionIndexes.begin() + Node.FirstAction, mActionIndexes.begin() + Node.FirstAction + Node.ActionCount);
+
+    if (Node.Fact < 0)
+    {
+        return;
+    }
+
+    if (std::optional<BProperty> Value = State.GetProperty(Node.Fact))
+    {
+        auto itFirst = mBranches.begin() + Node.FirstBranch;
+        auto itLast = itFirst + Node.BranchCount;
+        auto itBranch = std::lower_bound(itFirst, itLast, *Value, [](const SBranch& Branch, BProperty Value) { return Branch.Value < Value; });
+        if (itBranch != itLast && itBranch->Value == *Value)
+        {
+            CollectActions(oActionIndexes, State, itBranch->Child);
+        }
+    }
+
+    if (Node.DontCareChild >= 0)
+    {
+        CollectActions(oActionIndexes, State, Node.DontCareChild);
+    }
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,70 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <vector>
+
+#include "State.h"
+
+
+namespace GOAP
+{
+    class CAction;
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Decision tree over the preconditions of actions, compiled to find the actions applicable to a state without checking every action.
+    // Each tree node tests the value of one fact, and an action is kept in the node where its last precondition has been tested.
+    // Actions of derived classes may override CheckPrecondition, so they are always listed as candidates to check.
+    // Build one for a set of actions and share it among planners, since queries don't modify it.
+    class CSuccessorGenerator
+    {
+    public:
+        // Compile the tree from the preconditions of actions, reusing the capacity of the previous tree.
+        void Build(const std::vector<const CAction*>& Actions);
+        // List the indexes of the actions whose preconditions are satisfied by a state in ascending order.
+        void GetApplicableActions(std::vector<int>& oActionIndexes, const CState& State) const;
+        // Return the number of actions compiled, which are identified by their positions in the list passed to Build.
+        int GetActionCount() const { return static_cast<int>(mActions.size()); }
+        // Is this tree compiled from the same action instances in the same order? Actions modified in place after Build aren't detected.
+        bool IsBuiltFrom(const std::vector<const CAction*>& Actions) const { return mActions == Actions; }
+        // Does a listed action still need its CheckPrecondition called? Only the actions of derived classes do.
+        bool NeedsCheck(int ActionIndex) const { return mCheckMarks[ActionIndex]; }
+
+    private:
+        struct STreeNode
+        {
+            int Fact = -1;              // Index of the fact tested by this node, or -1 if no actions need more tests
+            int FirstBranch = 0;        // First branch of this node in mBranches
+            int BranchCount = 0;        // Number of branches, which are sorted by values
+            int DontCareChild = -1;     // Child for the actions that don't require the fact, or -1 if none
+            int FirstAction = 0;        // First action satisfied at this node in mActionIndexes
+            int ActionCount = 0;        // Number of actions satisfied at this node
+        };
+
+        struct SBranch
+        {
+            BProperty Value = 0;        // Value of the fact tested by the parent node
+            int Child = -1;             // Child for the actions requiring the value
+        };
+
+        struct SEntry
+        {
+            int ActionIndex = 0;
+            int Cursor = 0;             // Next precondition of the action in mPreconditions to test
+            int End = 0;                // End of the preconditions of the action in mPreconditions
+        };
+
+        // Build a tree node for the entries in a given range and return its index.
+        int BuildNode(int First, int Last);
+        // Append the actions satisfied by a state at a given node and its descendants.
+        void CollectActions(std::vector<int>& oActionIndexes, const CState& State, int NodeIndex) const;
+
+        std::vector<STreeNode> mNodes;              // Tree nodes with the root at index 0
+        std::vector<SBranch> mBranches;             // Branches of the tree nodes
+        std::vector<int> mActionIndexes;            // Actions satisfied at the tree nodes
+        std::vector<bool> mCheckMarks;              // Marks of the actions of derived classes, which are listed unchecked
+        std::vector<CState::SFact> mPreconditions;  // Preconditions of all actions in the order of fact indexes, used while building
+        std::vector<SEntry> mEntries;               // Actions being sorted into the tree, used while building
+        std::vector<const CAction*> mActions;       // Actions passed to Build, which fingerprint the action list
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,73 @@
+// Copyright 2026 Isaac Hsu
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "Node.h"
+#include "OpenList.h"
+#include "StateArena.h"
+
+
+namespace GOAP
+{
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Reusable buffers of planners. Hold one per thread and pass it to successive Plan calls so that the buffers keep their capacity.
+    // The workspace holds the search tree, its states and the open list used by all planners. Each kind of planners declares the rest
+    // of its buffers as a scratch struct, which the workspace creates on its first use and keeps for later calls.
+    class CPlannerWorkspace
+    {
+    public:
+        struct SScratch // Base of the buffers specific to a kind of planners
+        {
+            virtual ~SScratch() {}
+            // Reset the buffers without freeing their capacity.
+            virtual void Clear() = 0;
+        };
+
+        // Release the search nodes and their states, and reset all buffers without freeing their capacity.
+        void Clear();
+
+        std::vector<SNode>& GetNodes() { return mNodes; }
+        const std::vector<SNode>& GetNodes() const { return mNodes; }
+        CStateArena& GetStateArena() { return mStateArena; }
+        COpenList& GetOpenList() { return mOpenList; }
+        // Return the scratch struct of a given type, which is created on the first call.
+        template <typename TScratch>
+        TScratch& GetScratch();
+
+    private:
+        // Return the index of a given scratch type in mScratches, which is assigned on the first call.
+        template <typename TScratch>
+        static int GetScratchIndex() { static const int Index = AssignScratchIndex(); return Index; }
+        static int AssignScratchIndex();
+
+        std::vector<SNode> mNodes;                          // The search tree
+        CStateArena mStateArena;                            // Storage of the states of the search nodes
+        COpenList mOpenList;                                // The open set in A*
+        std::vector<std::unique_ptr<SScratch>> mScratches;  // Scratch structs indexed by their types, or null if not used yet
+    };
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename TScratch>
+    TScratch& CPlannerWorkspace::GetScratch()
+    {
+        static_assert(std::is_base_of_v<SScratch, TScratch>, "Scratch structs must derive from CPlannerWorkspace::SScratch.");
+
+        const int Index = GetScratchIndex<TScratch>();
+        if (Index >= static_cast<int>(mScratches.size()))
+        {
+            mScratches.resize(Index + 1);
+        }
+
+        std::unique_ptr<SScratch>& Scratch = mScratches[Index];
+        if (!Scratch)
+        {
+            Scratch = std::make_unique<TScratch>();
+        }
+
+        return static_cast<TScratch&>(*Scratch);
+    }
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,172 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This example checks the memory-bounded IDA* planner against an exhaustive search on random
+// domains, with the transposition table disabled and with a few table sizes.
+//
+// Every plan found should be valid and as cheap as the cheapest one within the maximum depth, and
+// a plan should be found whenever one exists. The table only saves repeated expansions, so smaller
+// tables expand more nodes, while the nodes kept never exceed the maximum depth plus the root.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "GOAP/Action.h"
+#include "GOAP/IDAStarPlanner.h"
+#include "GOAP/Observer.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class CExpansionCounter : public CSearchObserver // Observer counting expansions and the nodes kept without building any text
+{
+public:
+    void OnExpand(int Step, int NodeCount, const CTextGetter& GetPath, const CTextGetter& GetNode) override
+    {
+        mCount++;
+        mMaxNodeCount = std::max(mMaxNodeCount, NodeCount);
+    }
+
+    long long mCount = 0;
+    int mMaxNodeCount = 0;
+};
+
+constexpr int DomainCount = 300;
+constexpr int FactCount = 8;
+constexpr int ActionCount = 7;
+constexpr int MaxDepth = 5;
+constexpr float NoPlan = std::numeric_limits<float>::infinity();
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool IsValidPlan(const std::vector<const CAction*>& Steps, const CState& StartingState, const CState& GoalState)
+{
+    CState State = StartingState;
+    for (const CAction* Step : Steps)
+    {
+        if (!Step->CheckPrecondition(State))
+        {
+            return false;
+        }
+        Step->GetEffect().Overwrite(State);
+    }
+    return GoalState.IsSatisfiedBy(State);
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+float GetPlanCost(const std::vector<const CAction*>& Steps)
+{
+    float Cost = 0.f;
+    for (const CAction* Step : Steps)
+    {
+        Cost += Step->GetBaseCost();
+    }
+    return Cost;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Try all action sequences up to a given depth, and return the cost of the cheapest plan or NoPlan.
+float FindCheapestCost(const CState& State, const CState& GoalState, const std::vector<const CAction*>& Actions, int Depth)
+{
+    if (GoalState.IsSatisfiedBy(State))
+    {
+        return 0.f;
+    }
+
+    float Cheapest = NoPlan;
+    for (int i = 0; Depth > 0 && i < static_cast<int>(Actions.size()); ++i)
+    {
+        const CAction* Action = Actions[i];
+        if (Action->CheckPrecondition(State))
+        {
+            CState NextState = State;
+            Action->GetEffect().Overwrite(NextState);
+            Cheapest = std::min(Cheapest, Action->GetBaseCost() + FindCheapestCost(NextState, GoalState, Actions, Depth - 1));
+        }
+    }
+    return Cheapest;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void RunIDAStar(int TableSize)
+{
+    std::mt19937 Random(9);
+    std::vector<std::string> FactNames;
+    for (int i = 0; i < FactCount; ++i)
+    {
+        FactNames.push_back("F" + std::to_string(i));
+    }
+
+    int FoundPlans = 0;
+    int Agreements = 0;
+    int InvalidPlans = 0;
+    int OptimalPlans = 0;
+    CExpansionCounter Counter;
+    for (int DomainIndex = 0; DomainIndex < DomainCount; ++DomainIndex)
+    {
+        std::vector<CAction> Actions;
+        for (int i = 0; i < ActionCount; ++i)
+        {
+            CAction& Action = Actions.emplace_back("A" + std::to_string(i));
+            Action.SetBaseCost(static_cast<float>(1 + Random() % 4));
+            const int PreconditionCount = static_cast<int>(1 + Random() % 2);
+            for (int k = 0; k < PreconditionCount; ++k)
+            {
+                const std::string& Name = FactNames[Random() % FactCount];
+                Action.SetPrecondition(Name, static_cast<int>(Random() % 2));
+            }
+            const int EffectCount = static_cast<int>(1 + Random() % 3);
+            for (int k = 0; k < EffectCount; ++k)
+            {
+                const std::string& Name = FactNames[Random() % FactCount];
+                Action.SetEffect(Name, static_cast<int>(Random() % 2));
+            }
+        }
+
+        std::vector<const CAction*> ActionPointers;
+        for (const CAction& Action : Actions)
+        {
+            ActionPointers.push_back(&Action);
+        }
+
+        CState StartingState;
+        for (const std::string& Name : FactNames)
+        {
+            StartingState.SetProperty(Name, static_cast<int>(Random() % 2));
+        }
+        CState GoalState;
+        for (int k = 0; k < 3; ++k)
+        {
+            const std::string& Name = FactNames[Random() % FactCount];
+            GoalState.SetProperty(Name, static_cast<int>(Random() % 2));
+        }
+
+        CIDAStarPlanner Planner(TableSize);
+        Planner.SetObserver(&Counter);
+        std::vector<const CAction*> Steps;
+        const bool Found = Planner.Plan(Steps, StartingState, GoalState, ActionPointers, MaxDepth);
+        const float CheapestCost = FindCheapestCost(StartingState, GoalState, ActionPointers, MaxDepth);
+
+        FoundPlans += Found;
+        Agreements += Found == (CheapestCost != NoPlan);
+        InvalidPlans += Found && !IsValidPlan(Steps, StartingState, GoalState);
+        OptimalPlans += Found && GetPlanCost(Steps) == CheapestCost;
+    }
+
+    std::cout << "    Table size " << TableSize << "\n";
+    std::cout << "      Plans found:                " << FoundPlans << "\n";
+    std::cout << "      Found as exhaustive search: " << Agreements << "/" << DomainCount << "\n";
+    std::cout << "      Invalid plans:              " << InvalidPlans << "\n";
+    std::cout << "      Optimal plans:              " << OptimalPlans << "\n";
+    std::cout << "      Expansions:                 " << Counter.mCount << "\n";
+    std::cout << "      Most nodes kept:            " << Counter.mMaxNodeCount << "\n";
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    for (int TableSize : {0, 1, 64, 4096})
+    {
+        RunIDAStar(TableSize);
+    }
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This example runs a plan cache of two entries through the cases of its life: a miss, a hit from a
+// starting state differing only in a fact that nothing reads, eviction of the least recently used
+// plan, a change of the action-set version, and a cached plan that fails its replay because an
+// action was changed without changing the version. Finally, a starting state lacking a fact that an
+// effect sets is refused before the lookup, as the interface functions refuse it.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GOAP/Action.h"
+#include "GOAP/GOAP.h"
+#include "GOAP/PlanCache.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void PrintCall(const char* Label, bool Found, const std::vector<const CAction*>& Steps, const CPlanCache& Cache, int PlannerCalls)
+{
+    std::string Plan;
+    for (const CAction* Step : Steps)
+    {
+        Plan += (Plan.empty() ? "" : " ") + Step->GetName();
+    }
+
+    std::cout << Label << ": " << (Found ? Plan : "no plan") << "\n";
+    std::cout << "    Hits " << Cache.GetHitCount() << ", misses " << Cache.GetMissCount() << ", rejections " << Cache.GetRejectionCount();
+    std::cout << ", size " << Cache.GetSize() << ", planner calls " << PlannerCalls << "\n";
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<CAction> Actions;
+    {
+        CAction& Action = Actions.emplace_back("GoToForest");
+        Action.SetEffect("AtForest", true);
+    }
+    {
+        CAction& Action = Actions.emplace_back("GetAxe");
+        Action.SetEffect("HasAxe", true);
+    }
+    {
+        CAction& Action = Actions.emplace_back("ChopWood");
+        Action.SetPrecondition("AtForest", true);
+        Action.SetPrecondition("HasAxe", true);
+        Action.SetEffect("HasWood", true);
+        Action.SetEffect("Tired", true); // Nothing reads this fact, so it isn't part of the keys.
+    }
+    {
+        CAction& Action = Actions.emplace_back("BuyWood");
+        Action.SetBaseCost(5.f);
+        Action.SetPrecondition("HasGold", true);
+        Action.SetEffect("HasWood", true);
+        Action.SetEffect("HasGold", false);
+    }
+
+    std::vector<const CAction*> ActionPointers;
+    for (const CAction& Action : Actions)
+    {
+        ActionPointers.push_back(&Action);
+    }
+
+    CState GoalState;
+    GoalState.SetProperty("HasWood", true);
+
+    auto MakeState = [](bool AtForest, bool HasAxe, bool Daytime) // Daytime is read by no action at first.
+    {
+        CState State;
+        State.SetProperty("AtForest", AtForest);
+        State.SetProperty("HasAxe", HasAxe);
+        State.SetProperty("HasWood", false);
+        State.SetProperty("HasGold", true);
+        State.SetProperty("Tired", false);
+        State.SetProperty("Daytime", Daytime);
+        return State;
+    };
+    const CState NightState = MakeState(false, false, false);
+    const CState DayState = MakeState(false, false, true);
+    const CState AxeState = MakeState(false, true, false);
+    const CState ForestState = MakeState(true, false, false);
+
+    int PlannerCalls = 0;
+    auto Planner = [&PlannerCalls](std::vector<const CAction*>& oSteps, const CState& StartingState, const CState& GoalState, const std::vector<const CAction*>& Actions, int MaxDepth)
+    {
+        PlannerCalls++;
+        return ForwardSearch(oSteps, StartingState, GoalState, Actions, MaxDepth);
+    };
+
+    CPlanCache Cache(2);
+    const int MaxDepth = 4;
+    uint64_t Version = 1;
+    std::vector<const CAction*> Steps;
+    bool Found = false;
+
+    Found = Cache.Plan(Steps, NightState, GoalState, ActionPointers, MaxDepth, Version, Planner);
+    PrintCall("Miss at night", Found, Steps, Cache, PlannerCalls);
+
+    Found = Cache.Plan(Steps, DayState, GoalState, ActionPointers, MaxDepth, Version, Planner);
+    PrintCall("Hit in the daytime", Found, Steps, Cache, PlannerCalls);
+
+    Found = Cache.Plan(Steps, AxeState, GoalState, ActionPointers, MaxDepth, Version, Planner);
+    PrintCall("Miss with an axe", Found, Steps, Cache, PlannerCalls);
+
+    Found = Cache.Plan(Steps, ForestState, GoalState, ActionPointers, MaxDepth, Version, Planner);
+    PrintCall("Miss at the forest, evicting the plan at night", Found, Steps, Cache, PlannerCalls);
+
+    Found = Cache.Plan(Steps, NightState, GoalState, ActionPointers, MaxDepth, Version, Planner);
+    PrintCall("Miss at night again, evicting the plan with an axe", Found, Steps, Cache, PlannerCalls);
+
+    ++Version;
+    Found = Cache.Plan(Steps, NightState, GoalState, ActionPointers, MaxDepth, Version, Planner);
+    PrintCall("Miss at night of a new version", Found, Steps, Cache, PlannerCalls);
+
+    Actions[2].SetPrecondition("Daytime", true); // Changed without a new version, so the cached plan has to fail its replay.
+    Found = Cache.Plan(Steps, NightState, GoalState, ActionPointers, MaxDepth, Version, Planner);
+    PrintCall("Rejection at night after chopping needs daylight", Found, Steps, Cache, PlannerCalls);
+
+    CState TirelessState; // Lacking the fact that ChopWood sets
+    TirelessState.SetProperty("AtForest", false);
+    TirelessState.SetProperty("HasAxe", false);
+    TirelessState.SetProperty("HasWood", false);
+    TirelessState.SetProperty("HasGold", true);
+    TirelessState.SetProperty("Daytime", false);
+    Found = Cache.Plan(Steps, TirelessState, GoalState, ActionPointers, MaxDepth, Version, Planner);
+    PrintCall("Refusal of a state lacking Tired", Found, Steps, Cache, PlannerCalls);
+
+    return 0;
+}
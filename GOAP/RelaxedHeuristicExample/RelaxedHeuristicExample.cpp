@@ -0,0 +1,337 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This example runs the planners with each relaxed heuristic on crafting domains, and then checks
+// the relaxed heuristics against a naive computation on random domains.
+//
+// In a crafting domain, raw resources are gathered, and each crafted item consumes two items made
+// before it, so the relaxed problem where nothing is consumed underestimates the actual costs.
+// The forward planner evaluates each reached state, while the regressive planners prepare the costs
+// from the starting state once and evaluate each regressed state by the prepared costs.
+//
+// The naive computation repeats relaxing all actions until no cost of facts changes. The costs of
+// h_max and h_add should equal it, and h_FF should lie between them.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GOAP/Action.h"
+#include "GOAP/AdvRegressionPlanner.h"
+#include "GOAP/ForwardPlanner.h"
+#include "GOAP/Observer.h"
+#include "GOAP/RegressionPlanner.h"
+#include "GOAP/RelaxedHeuristic.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class CExpansionCounter : public CSearchObserver // Observer counting expansions without building any text
+{
+public:
+    void OnExpand(int Step, int NodeCount, const CTextGetter& GetPath, const CTextGetter& GetNode) override { mCount++; }
+
+    long long mCount = 0;
+};
+
+struct SCraftingDomain
+{
+    CState StartingState;
+    CState GoalState;
+    std::vector<CAction> Actions;
+};
+
+constexpr int RawResourceCount = 4;
+constexpr int CraftedItemCount = 8;
+constexpr int MaxDepth = 14;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+std::string GetItemName(int Index)
+{
+    return "Item" + std::to_string(Index);
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+SCraftingDomain MakeCraftingDomain(unsigned Seed)
+{
+    std::mt19937 Random(Seed);
+    SCraftingDomain Domain;
+    for (int i = 0; i < RawResourceCount + CraftedItemCount; ++i)
+    {
+        Domain.StartingState.SetProperty(GetItemName(i), false);
+    }
+    Domain.StartingState.SetProperty("Tool", false);
+
+    // The last raw resource can be gathered only with the tool, which consumes the first one.
+    for (int i = 0; i < RawResourceCount; ++i)
+    {
+        CAction& Gather = Domain.Actions.emplace_back("Gather" + std::to_string(i));
+        Gather.SetEffect(GetItemName(i), true);
+        Gather.SetBaseCost(static_cast<float>(1 + Random() % 3));
+        if (i == RawResourceCount - 1)
+        {
+            Gather.SetPrecondition("Tool", true);
+        }
+    }
+    {
+        CAction& MakeTool = Domain.Actions.emplace_back("MakeTool");
+        MakeTool.SetPrecondition(GetItemName(0), true);
+        MakeTool.SetEffect("Tool", true);
+        MakeTool.SetEffect(GetItemName(0), false);
+        MakeTool.SetBaseCost(2.f);
+    }
+    for (int i = RawResourceCount; i < RawResourceCount + CraftedItemCount; ++i)
+    {
+        const int FirstInput = static_cast<int>(Random() % i);
+        int SecondInput = static_cast<int>(Random() % i);
+        while (SecondInput == FirstInput)
+        {
+            SecondInput = static_cast<int>(Random() % i);
+        }
+
+        CAction& Craft = Domain.Actions.emplace_back("Craft" + std::to_string(i));
+        Craft.SetPrecondition(GetItemName(FirstInput), true);
+        Craft.SetPrecondition(GetItemName(SecondInput), true);
+        Craft.SetEffect(GetItemName(i), true);
+        Craft.SetEffect(GetItemName(FirstInput), false);
+        Craft.SetBaseCost(static_cast<float>(1 + Random() % 2));
+    }
+
+    Domain.GoalState.SetProperty(GetItemName(RawResourceCount + CraftedItemCount - 1), true);
+    return Domain;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool IsValidPlan(const std::vector<const CAction*>& Steps, const CState& StartingState, const CState& GoalState)
+{
+    CState State = StartingState;
+    for (const CAction* Step : Steps)
+    {
+        if (!Step->CheckPrecondition(State))
+        {
+            return false;
+        }
+        Step->GetEffect().Overwrite(State);
+    }
+    return GoalState.IsSatisfiedBy(State);
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+float GetPlanCost(const std::vector<const CAction*>& Steps)
+{
+    float Cost = 0.f;
+    for (const CAction* Step : Steps)
+    {
+        Cost += Step->GetBaseCost();
+    }
+    return Cost;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename TPlanner>
+void RunPlanner(const char* Name, TPlanner& Planner, const SCraftingDomain& Domain, const std::vector<const CAction*>& Actions, CRelaxedHeuristic* Heuristic)
+{
+    CExpansionCounter Counter;
+    Planner.SetObserver(&Counter);
+    Planner.SetHeuristic(Heuristic);
+
+    std::vector<const CAction*> Steps;
+    const bool Found = Planner.Plan(Steps, Domain.StartingState, Domain.GoalState, Actions, MaxDepth);
+    std::cout << "        " << std::left << std::setw(16) << Name << std::right
+        << " found=" << Found
+        << " valid=" << (Found && IsValidPlan(Steps, Domain.StartingState, Domain.GoalState))
+        << " cost=" << std::setw(3) << GetPlanCost(Steps)
+        << " expansions=" << Counter.mCount << "\n";
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void RunCraftingDomain(unsigned Seed)
+{
+    const SCraftingDomain Domain = MakeCraftingDomain(Seed);
+    std::vector<const CAction*> Actions;
+    for (const CAction& Action : Domain.Actions)
+    {
+        Actions.push_back(&Action);
+    }
+
+    const std::pair<const char*, ERelaxedHeuristic> Heuristics[] = {
+        {"h_max", ERelaxedHeuristic::Max},
+        {"h_add", ERelaxedHeuristic::Add},
+        {"h_FF", ERelaxedHeuristic::FF},
+    };
+
+    std::cout << "    SEED " << Seed << "\n";
+    for (int i = -1; i < static_cast<int>(std::size(Heuristics)); ++i)
+    {
+        const bool HasHeuristic = i >= 0;
+        std::cout << "      " << (HasHeuristic ? Heuristics[i].first : "No heuristic") << "\n";
+
+        // Each planner gets its own instance since the evaluation reuses internal buffers.
+        CRelaxedHeuristic ForwardHeuristic(Actions, HasHeuristic ? Heuristics[i].second : ERelaxedHeuristic::Max);
+        CRelaxedHeuristic RegressionHeuristic(Actions, HasHeuristic ? Heuristics[i].second : ERelaxedHeuristic::Max);
+        CRelaxedHeuristic AdvRegressionHeuristic(Actions, HasHeuristic ? Heuristics[i].second : ERelaxedHeuristic::Max);
+
+        CForwardPlanner ForwardPlanner(DetectDuplicates);
+        RunPlanner("Forward", ForwardPlanner, Domain, Actions, HasHeuristic ? &ForwardHeuristic : nullptr);
+
+        CRegressionPlanner RegressionPlanner;
+        RunPlanner("Regression", RegressionPlanner, Domain, Actions, HasHeuristic ? &RegressionHeuristic : nullptr);
+
+        CAdvRegressionPlanner AdvRegressionPlanner;
+        RunPlanner("AdvRegression", AdvRegressionPlanner, Domain, Actions, HasHeuristic ? &AdvRegressionHeuristic : nullptr);
+    }
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Relax all actions repeatedly until no cost of facts changes, and combine the costs of the desired
+// facts by the maximum or the sum.
+float ComputeNaiveCost(const std::vector<const CAction*>& Actions, const CState& State, const CState& DesiredState, bool UseMaximum)
+{
+    constexpr float Unreachable = std::numeric_limits<float>::infinity();
+    std::map<CState::SFact, float> FactCosts;
+    for (const CState::SFact& Fact : State)
+    {
+        FactCosts[Fact] = 0.f;
+    }
+    const auto GetFactCost = [&FactCosts](const CState::SFact& Fact)
+    {
+        const auto Iterator = FactCosts.find(Fact);
+        return Iterator == FactCosts.end() ? Unreachable : Iterator->second;
+    };
+    const auto Combine = [UseMaximum](float Cost, float FactCost)
+    {
+        return UseMaximum ? std::max(Cost, FactCost) : Cost + FactCost;
+    };
+
+    bool Changed = true;
+    while (Changed)
+    {
+        Changed = false;
+        for (const CAction* Action : Actions)
+        {
+            float ReadyCost = 0.f;
+            for (const CState::SFact& Fact : Action->GetPrecondition())
+            {
+                ReadyCost = Combine(ReadyCost, GetFactCost(Fact));
+            }
+            if (ReadyCost == Unreachable)
+            {
+                continue;
+            }
+
+            for (const CState::SFact& Fact : Action->GetEffect())
+            {
+                const float Cost = ReadyCost + Action->GetBaseCost();
+                if (Cost < GetFactCost(Fact))
+                {
+                    FactCosts[Fact] = Cost;
+                    Changed = true;
+                }
+            }
+        }
+    }
+
+    float Cost = 0.f;
+    for (const CState::SFact& Fact : DesiredState)
+    {
+        Cost = Combine(Cost, GetFactCost(Fact));
+    }
+    return Cost;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void CheckAgainstNaiveCosts()
+{
+    constexpr int DomainCount = 500;
+    constexpr int StatesPerDomain = 4;
+    constexpr int FactCount = 8;
+    constexpr int ActionCount = 8;
+
+    std::mt19937 Random(3);
+    std::vector<std::string> FactNames;
+    for (int i = 0; i < FactCount; ++i)
+    {
+        FactNames.push_back("F" + std::to_string(i));
+    }
+
+    int CaseCount = 0;
+    int MaxMatches = 0;
+    int AddMatches = 0;
+    int FFInBounds = 0;
+    int PreparedMatches = 0;
+    for (int DomainIndex = 0; DomainIndex < DomainCount; ++DomainIndex)
+    {
+        std::vector<CAction> Actions;
+        for (int i = 0; i < ActionCount; ++i)
+        {
+            CAction& Action = Actions.emplace_back("A" + std::to_string(i));
+            Action.SetBaseCost(static_cast<float>(Random() % 4));
+            const int PreconditionCount = static_cast<int>(Random() % 3);
+            for (int k = 0; k < PreconditionCount; ++k)
+            {
+                const std::string& Name = FactNames[Random() % FactCount];
+                Action.SetPrecondition(Name, static_cast<int>(Random() % 3));
+            }
+            const int EffectCount = static_cast<int>(1 + Random() % 2);
+            for (int k = 0; k < EffectCount; ++k)
+            {
+                const std::string& Name = FactNames[Random() % FactCount];
+                Action.SetEffect(Name, static_cast<int>(Random() % 3));
+            }
+        }
+
+        std::vector<const CAction*> ActionPointers;
+        for (const CAction& Action : Actions)
+        {
+            ActionPointers.push_back(&Action);
+        }
+        CRelaxedHeuristic MaxHeuristic(ActionPointers, ERelaxedHeuristic::Max);
+        CRelaxedHeuristic AddHeuristic(ActionPointers, ERelaxedHeuristic::Add);
+        CRelaxedHeuristic FFHeuristic(ActionPointers, ERelaxedHeuristic::FF);
+
+        for (int StateIndex = 0; StateIndex < StatesPerDomain; ++StateIndex)
+        {
+            CState State;
+            for (const std::string& Name : FactNames)
+            {
+                State.SetProperty(Name, static_cast<int>(Random() % 3));
+            }
+            CState DesiredState;
+            for (int k = 0; k < 3; ++k)
+            {
+                const std::string& Name = FactNames[Random() % FactCount];
+                DesiredState.SetProperty(Name, static_cast<int>(Random() % 3));
+            }
+
+            const float NaiveMax = ComputeNaiveCost(ActionPointers, State, DesiredState, true);
+            const float NaiveAdd = ComputeNaiveCost(ActionPointers, State, DesiredState, false);
+            const float FF = FFHeuristic.Evaluate(State, DesiredState);
+
+            CaseCount++;
+            MaxMatches += MaxHeuristic.Evaluate(State, DesiredState) == NaiveMax;
+            AddMatches += AddHeuristic.Evaluate(State, DesiredState) == NaiveAdd;
+            FFInBounds += (std::isinf(FF) && std::isinf(NaiveMax)) || (FF >= NaiveMax && FF <= NaiveAdd);
+
+            AddHeuristic.Prepare(State);
+            PreparedMatches += AddHeuristic.EvaluatePrepared(DesiredState) == NaiveAdd;
+        }
+    }
+
+    std::cout << "    h_max equal to the naive cost:          " << MaxMatches << "/" << CaseCount << "\n";
+    std::cout << "    h_add equal to the naive cost:          " << AddMatches << "/" << CaseCount << "\n";
+    std::cout << "    h_FF between h_max and h_add:           " << FFInBounds << "/" << CaseCount << "\n";
+    std::cout << "    Prepared h_add equal to the naive cost: " << PreparedMatches << "/" << CaseCount << "\n";
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::cout << "CRAFTING DOMAINS\n";
+    for (unsigned Seed = 1; Seed <= 3; ++Seed)
+    {
+        RunCraftingDomain(Seed);
+    }
+
+    std::cout << "NAIVE COST CHECK\n";
+    CheckAgainstNaiveCosts();
+
+    return 0;
+}
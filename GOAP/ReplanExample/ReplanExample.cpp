@@ -0,0 +1,169 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This example shows how the regressive planners repair a kept search when the world changes.
+// An agent wants the enemy dead, either by fetching and loading a weapon or by walking over and
+// punching. After the first plan, some facts of the starting state change, and the search kept in
+// the workspace is resumed by Replan with the changed facts only, since the costs of the nodes are
+// accumulated from the goal and don't depend on the starting state.
+// Each replanned result is compared with a plan formulated from scratch, and the expansions show
+// how much of the kept search is reused.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GOAP/Action.h"
+#include "GOAP/AdvRegressionPlanner.h"
+#include "GOAP/Fact.h"
+#include "GOAP/Observer.h"
+#include "GOAP/RegressionPlanner.h"
+#include "GOAP/Workspace.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class CExpansionCounter : public CSearchObserver // Observer counting expansions without building any text
+{
+public:
+    void OnExpand(int Step, int NodeCount, const CTextGetter& GetPath, const CTextGetter& GetNode) override { mCount++; }
+
+    long long mCount = 0;
+};
+
+struct SChange
+{
+    const char* Description;
+    std::vector<std::pair<std::string, bool>> Facts; // Names and new values of the changed facts
+};
+
+const char* FactNames[] = {"NearWeapon", "HasWeapon", "HasAmmo", "NearEnemy", "EnemyDead"};
+constexpr int MaxDepth = 4;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+std::string StringizeResult(bool Found, const std::vector<const CAction*>& Steps, long long Expansions)
+{
+    std::string Return = Found ? "|" : "FAILED";
+    for (int i = 0; Found && i < static_cast<int>(Steps.size()); ++i)
+    {
+        Return += (i > 0 ? " " : "") + Steps[i]->GetName();
+    }
+
+    return Return + (Found ? "|" : "") + " in " + std::to_string(Expansions) + " expansions";
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void RunReplans(CRegressionPlanner& Planner, const char* Name, const std::vector<const CAction*>& Actions, const CState& GoalState, const std::vector<SChange>& Changes)
+{
+    std::cout << "    " << Name << "\n";
+
+    std::vector<bool> Values(std::size(FactNames), false);
+    const auto MakeStartingState = [&Values]
+    {
+        CState State;
+        for (int i = 0; i < static_cast<int>(std::size(FactNames)); ++i)
+        {
+            State.SetProperty(FactNames[i], Values[i]);
+        }
+        return State;
+    };
+
+    CPlannerWorkspace Workspace; // Keeps the search for Replan
+    CExpansionCounter Counter;
+    Planner.SetObserver(&Counter);
+
+    std::vector<const CAction*> Steps;
+    bool Found = Planner.Plan(Steps, MakeStartingState(), GoalState, Actions, MaxDepth, Workspace);
+    std::cout << "      Initial plan: " << StringizeResult(Found, Steps, Counter.mCount) << "\n";
+
+    for (const SChange& Change : Changes)
+    {
+        std::vector<int> ChangedFacts;
+        for (const auto& [FactName, Value] : Change.Facts)
+        {
+            const int Index = static_cast<int>(std::find(std::begin(FactNames), std::end(FactNames), FactName) - std::begin(FactNames));
+            Values[Index] = Value;
+            ChangedFacts.push_back(CFactRegistry::GetInstance().Find(FactName));
+        }
+        const CState StartingState = MakeStartingState();
+        std::cout << "      " << Change.Description << "\n";
+
+        Counter.mCount = 0;
+        Found = Planner.Replan(Steps, StartingState, ChangedFacts, Workspace);
+        std::cout << "        Replanned:            " << StringizeResult(Found, Steps, Counter.mCount) << "\n";
+
+        Counter.mCount = 0;
+        CPlannerWorkspace FreshWorkspace;
+        Found = Planner.Plan(Steps, StartingState, GoalState, Actions, MaxDepth, FreshWorkspace);
+        std::cout << "        Planned from scratch: " << StringizeResult(Found, Steps, Counter.mCount) << "\n";
+    }
+
+    Planner.SetObserver(nullptr);
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    CState GoalState;
+    GoalState.SetProperty("EnemyDead", true);
+
+    std::vector<CAction> Actions;
+    {
+        CAction& GoToWeapon = Actions.emplace_back("GoToWeapon");
+        GoToWeapon.SetPrecondition("NearWeapon", false);
+        GoToWeapon.SetEffect("NearWeapon", true);
+        GoToWeapon.SetBaseCost(2.f);
+    }
+    {
+        CAction& PickUpWeapon = Actions.emplace_back("PickUpWeapon");
+        PickUpWeapon.SetPrecondition("NearWeapon", true);
+        PickUpWeapon.SetPrecondition("HasWeapon", false);
+        PickUpWeapon.SetEffect("HasWeapon", true);
+    }
+    {
+        CAction& Reload = Actions.emplace_back("Reload");
+        Reload.SetPrecondition("HasWeapon", true);
+        Reload.SetPrecondition("HasAmmo", false);
+        Reload.SetEffect("HasAmmo", true);
+    }
+    {
+        CAction& Shoot = Actions.emplace_back("Shoot");
+        Shoot.SetPrecondition("HasWeapon", true);
+        Shoot.SetPrecondition("HasAmmo", true);
+        Shoot.SetEffect("HasAmmo", false);
+        Shoot.SetEffect("EnemyDead", true);
+    }
+    {
+        CAction& GoToEnemy = Actions.emplace_back("GoToEnemy");
+        GoToEnemy.SetPrecondition("NearEnemy", false);
+        GoToEnemy.SetEffect("NearEnemy", true);
+        GoToEnemy.SetBaseCost(4.f);
+    }
+    {
+        CAction& Punch = Actions.emplace_back("Punch");
+        Punch.SetPrecondition("NearEnemy", true);
+        Punch.SetEffect("EnemyDead", true);
+        Punch.SetBaseCost(3.f);
+    }
+
+    std::vector<const CAction*> ActionPointers;
+    for (const CAction& Action : Actions)
+    {
+        ActionPointers.push_back(&Action);
+    }
+
+    const std::vector<SChange> Changes = {
+        {"The enemy comes close.", {{"NearEnemy", true}}},
+        {"The enemy backs off, and a weapon is handed over.", {{"NearEnemy", false}, {"HasWeapon", true}}},
+        {"The weapon is loaded.", {{"HasAmmo", true}}},
+        {"The ammo runs out.", {{"HasAmmo", false}}},
+    };
+
+    CRegressionPlanner RegressionPlanner;
+    RunReplans(RegressionPlanner, "REGRESSIVE GOAP", ActionPointers, GoalState, Changes);
+
+    CAdvRegressionPlanner AdvRegressionPlanner;
+    RunReplans(AdvRegressionPlanner, "ADVANCED REGRESSIVE GOAP", ActionPointers, GoalState, Changes);
+
+    return 0;
+}
@@ -0,0 +1,254 @@
+// Copyright 2026 Isaac Hsu
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// This example checks the successor generator used by the forward planners.
+//
+// First, the actions listed for random states are compared with those whose CheckPrecondition
+// passes. Actions of derived classes are listed unchecked, and ineffective plain actions are never
+// listed, so an action applies exactly when it's listed and, if it still needs a check, passes it.
+// Second, a forward search with a shared generator is compared with one building a generator per
+// call, and the statistics should count each action at each expanded node once, either as
+// applicable or as rejected. A generator built from the same actions in another order doesn't
+// match the action list, so the planner should build its own instead.
+// Last, the generator is timed against checking every action on a large action set.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GOAP/Action.h"
+#include "GOAP/ForwardPlanner.h"
+#include "GOAP/PlannerStats.h"
+#include "GOAP/SuccessorGenerator.h"
+
+
+using namespace GOAP;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+class CGuardedAction : public CAction // Action that is also unavailable whenever the guard fact is set to 0
+{
+    using Super = CAction;
+public:
+    using Super::Super;
+
+    bool CheckPrecondition(const CState& State) const override { return State.GetProperty("Guard") != 0 && Super::CheckPrecondition(State); }
+};
+///////////////////////////////////////////////////////////////////////////////////////////////////
+std::string GetFactName(int Index)
+{
+    return "F" + std::to_string(Index);
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Create actions with random preconditions, where every tenth action on average is guarded and every twentieth is ineffective.
+std::vector<std::unique_ptr<CAction>> MakeRandomActions(std::mt19937& Random, int ActionCount, int FactCount)
+{
+    std::vector<std::unique_ptr<CAction>> Actions;
+    for (int i = 0; i < ActionCount; ++i)
+    {
+        const std::string Name = "A" + std::to_string(i);
+        std::unique_ptr<CAction>& Action = Actions.emplace_back(Random() % 10 == 0 ? std::make_unique<CGuardedAction>(Name) : std::make_unique<CAction>(Name));
+        const int PreconditionCount = static_cast<int>(Random() % 4);
+        for (int k = 0; k < PreconditionCount; ++k)
+        {
+            const std::string FactName = GetFactName(static_cast<int>(Random() % FactCount));
+            Action->SetPrecondition(FactName, static_cast<int>(Random() % 3));
+        }
+        if (Random() % 20 != 0)
+        {
+            const std::string FactName = GetFactName(static_cast<int>(Random() % FactCount));
+            Action->SetEffect(FactName, static_cast<int>(Random() % 3));
+        }
+        Action->SetBaseCost(static_cast<float>(1 + Random() % 3));
+    }
+    return Actions;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+std::vector<const CAction*> GetPointers(const std::vector<std::unique_ptr<CAction>>& Actions)
+{
+    std::vector<const CAction*> Pointers;
+    for (const std::unique_ptr<CAction>& Action : Actions)
+    {
+        Pointers.push_back(Action.get());
+    }
+    return Pointers;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void CheckApplicableActions()
+{
+    std::mt19937 Random(4);
+    int StateCount = 0;
+    int Mismatches = 0;
+    for (int DomainIndex = 0; DomainIndex < 300; ++DomainIndex)
+    {
+        const int FactCount = static_cast<int>(3 + Random() % 10);
+        const std::vector<std::unique_ptr<CAction>> Actions = MakeRandomActions(Random, static_cast<int>(1 + Random() % 40), FactCount);
+        const std::vector<const CAction*> ActionPointers = GetPointers(Actions);
+        CSuccessorGenerator Generator;
+        Generator.Build(ActionPointers);
+
+        for (int StateIndex = 0; StateIndex < 20; ++StateIndex)
+        {
+            CState State;
+            State.SetProperty("Guard", static_cast<int>(Random() % 2));
+            for (int i = 0; i < FactCount; ++i)
+            {
+                if (Random() % 5 != 0)
+                {
+                    State.SetProperty(GetFactName(i), static_cast<int>(Random() % 3));
+                }
+            }
+
+            std::vector<int> ListedActions;
+            Generator.GetApplicableActions(ListedActions, State);
+            std::vector<bool> ListedMarks(ActionPointers.size(), false);
+            for (int ActionIndex : ListedActions)
+            {
+                ListedMarks[ActionIndex] = true;
+            }
+
+            for (int ActionIndex = 0; ActionIndex < static_cast<int>(ActionPointers.size()); ++ActionIndex)
+            {
+                const CAction& Action = *ActionPointers[ActionIndex];
+                const bool Applicable = ListedMarks[ActionIndex] && (!Generator.NeedsCheck(ActionIndex) || Action.CheckPrecondition(State));
+                Mismatches += Applicable != Action.CheckPrecondition(State);
+            }
+            StateCount++;
+        }
+    }
+
+    std::cout << "    States checked: " << StateCount << "\n";
+    std::cout << "    Mismatched actions: " << Mismatches << "\n";
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void CheckSharedGenerator()
+{
+    std::mt19937 Random(19);
+    constexpr int FactCount = 6;
+    const std::vector<std::unique_ptr<CAction>> Actions = MakeRandomActions(Random, 30, FactCount);
+    const std::vector<const CAction*> ActionPointers = GetPointers(Actions);
+
+    CState StartingState;
+    StartingState.SetProperty("Guard", 1);
+    for (int i = 0; i < FactCount; ++i)
+    {
+        StartingState.SetProperty(GetFactName(i), 0);
+    }
+    CState GoalState;
+    GoalState.SetProperty(GetFactName(0), 2);
+
+    CSuccessorGenerator SharedGenerator;
+    SharedGenerator.Build(ActionPointers);
+    CSuccessorGenerator MismatchedGenerator;
+    MismatchedGenerator.Build(std::vector<const CAction*>(ActionPointers.rbegin(), ActionPointers.rend()));
+
+    const std::pair<const char*, const CSuccessorGenerator*> Generators[] = {
+        {"Per-call generator:  ", nullptr},
+        {"Shared generator:    ", &SharedGenerator},
+        {"Mismatched generator:", &MismatchedGenerator},
+    };
+
+    for (const auto& [Name, Generator] : Generators)
+    {
+        SPlannerStats Stats;
+        CForwardPlanner Planner(DetectDuplicates);
+        Planner.SetStats(&Stats);
+        Planner.SetSuccessorGenerator(Generator);
+
+        std::vector<const CAction*> Steps;
+        const bool Found = Planner.Plan(Steps, StartingState, GoalState, ActionPointers, 100);
+
+        // Every expanded node but the goal is below the maximum depth, so all actions are counted at it.
+        long long ApplicableCount = 0;
+        for (const auto& [Action, Count] : Stats.ApplicableCounts)
+        {
+            ApplicableCount += Count;
+        }
+        const long long CheckedNodeCount = Stats.ExpandedCount - (Found ? 1 : 0);
+        const bool CountedOnce = ApplicableCount + Stats.PrunedCount == CheckedNodeCount * static_cast<long long>(ActionPointers.size());
+
+        std::cout << "    " << Name << " found=" << Found << " steps=" << Steps.size()
+            << " expanded=" << Stats.ExpandedCount << " applicable=" << ApplicableCount << " pruned=" << Stats.PrunedCount
+            << " counted once=" << CountedOnce << "\n";
+    }
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TimeGenerator()
+{
+    std::mt19937 Random(6);
+    constexpr int FactCount = 40;
+    std::vector<CAction> Actions;
+    for (int i = 0; i < 1000; ++i)
+    {
+        CAction& Action = Actions.emplace_back("A" + std::to_string(i));
+        for (int k = 0; k < 2; ++k)
+        {
+            const std::string FactName = GetFactName(static_cast<int>(Random() % FactCount));
+            Action.SetPrecondition(FactName, static_cast<int>(Random() % 4));
+        }
+        Action.SetEffect(GetFactName(0), 1);
+    }
+
+    std::vector<const CAction*> ActionPointers;
+    for (const CAction& Action : Actions)
+    {
+        ActionPointers.push_back(&Action);
+    }
+
+    std::vector<CState> States(256);
+    for (CState& State : States)
+    {
+        for (int i = 0; i < FactCount; ++i)
+        {
+            State.SetProperty(GetFactName(i), static_cast<int>(Random() % 4));
+        }
+    }
+
+    CSuccessorGenerator Generator;
+    Generator.Build(ActionPointers);
+    std::vector<int> ListedActions;
+    long long ListedCount = 0;
+    const auto TreeStartTime = std::chrono::steady_clock::now();
+    for (int Repeat = 0; Repeat < 100; ++Repeat)
+    {
+        for (const CState& State : States)
+        {
+            Generator.GetApplicableActions(ListedActions, State);
+            ListedCount += static_cast<long long>(ListedActions.size());
+        }
+    }
+
+    long long ApplicableCount = 0;
+    const auto ScanStartTime = std::chrono::steady_clock::now();
+    for (int Repeat = 0; Repeat < 100; ++Repeat)
+    {
+        for (const CState& State : States)
+        {
+            for (const CAction* Action : ActionPointers)
+            {
+                ApplicableCount += Action->CheckPrecondition(State);
+            }
+        }
+    }
+    const auto EndTime = std::chrono::steady_clock::now();
+
+    auto ToMilliseconds = [](std::chrono::steady_clock::duration Duration) { return std::chrono::duration<double, std::milli>(Duration).count(); };
+    std::cout << "    Listed " << ListedCount << " actions in " << ToMilliseconds(ScanStartTime - TreeStartTime) << " ms\n";
+    std::cout << "    Checked " << ApplicableCount << " applicable actions in " << ToMilliseconds(EndTime - ScanStartTime) << " ms\n";
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::cout << "APPLICABLE ACTIONS\n";
+    CheckApplicableActions();
+
+    std::cout << "SHARED GENERATOR\n";
+    CheckSharedGenerator();
+
+    std::cout << "GENERATOR AGAINST SCAN\n";
+    TimeGenerator();
+
+    return 0;
+}